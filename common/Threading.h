@@ -201,6 +201,14 @@ namespace Threading
 				m_sema.Post();
 		}
 
+		/// Returns true if another thread is sleeping in WaitForEmpty(). The worker can use this to skip optional
+		/// work. It says nothing about whether the queue has work, since a notification keeps the state running
+		/// until the next WaitForWork(), even after the work itself has been consumed.
+		bool IsWaitingForEmpty() const
+		{
+			return (m_state.load(std::memory_order_acquire) & STATE_FLAG_WAITING_EMPTY) != 0;
+		}
+
 		/// Checks if there's any work in the queue
 		bool CheckForWork();
 		/// Wait for work to be added to the queue
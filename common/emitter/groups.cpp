@@ -233,7 +233,7 @@ namespace x86Emitter
 	void xImpl_Group8::operator()(const xRegister16or32or64& bitbase, const xRegister16or32or64& bitoffset) const
 	{
 		pxAssert(bitbase->GetOperandSize() == bitoffset->GetOperandSize());
-		xOpWrite0F(bitbase->GetPrefix16(), 0xa3 | (InstType << 3), bitbase, bitoffset);
+		xOpWrite0F(bitbase->GetPrefix16(), 0xa3 | (InstType << 3), bitoffset, bitbase);
 	}
 	void xImpl_Group8::operator()(const xIndirect64& bitbase, u8 bitoffset) const { xOpWrite0F(0xba, InstType, bitbase, bitoffset); }
 	void xImpl_Group8::operator()(const xIndirect32& bitbase, u8 bitoffset) const { xOpWrite0F(0xba, InstType, bitbase, bitoffset); }
@@ -18,6 +18,7 @@
 #include "common/Assertions.h"
 #include "common/CocoaTools.h"
 #include "common/Console.h"
+#include "common/Error.h"
 #include "common/CrashHandler.h"
 #include "common/FileSystem.h"
 #include "common/MemorySettingsInterface.h"
@@ -32,6 +33,7 @@
 #include "pcsx2/CDVD/CDVD.h"
 #include "pcsx2/GS.h"
 #include "pcsx2/GS/GSPerfMon.h"
+#include "pcsx2/GS/Renderers/HW/GSTextureReplacements.h"
 #include "pcsx2/GSDumpReplayer.h"
 #include "pcsx2/GameList.h"
 #include "pcsx2/Host.h"
@@ -70,6 +72,7 @@ static std::string s_output_prefix;
 static s32 s_loop_count = 1;
 static std::optional<bool> s_use_window;
 static bool s_no_console = false;
+static std::string s_pack_textures_dir;
 
 // Owned by the GS thread.
 static u32 s_dump_frame_number = 0;
@@ -488,6 +491,8 @@ static void PrintCommandLineHelp(const char* progname)
 	std::fprintf(stderr, "  -surfaceless: Disables showing a window.\n");
 	std::fprintf(stderr, "  -logfile <filename>: Writes emu log to filename.\n");
 	std::fprintf(stderr, "  -noshadercache: Disables the shader cache (useful for parallel runs).\n");
+	std::fprintf(stderr, "  -packtextures <dir>: Packs the replacements directory of a game's texture directory into "
+		"replacements.pack, and exits.\n");
 	std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
 						 "    parameters make up the filename. Use when the filename contains\n"
 						 "    spaces or starts with a dash.\n");
@@ -726,6 +731,12 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 
 				continue;
 			}
+			else if (CHECK_ARG_PARAM("-packtextures"))
+			{
+				// doesn't need a dump, so skip the rest of the checks
+				s_pack_textures_dir = StringUtil::StripWhitespace(argv[++i]);
+				return true;
+			}
 			else if (CHECK_ARG("-noshadercache"))
 			{
 				Console.WriteLn("Disabling shader cache");
@@ -852,6 +863,18 @@ int main(int argc, char* argv[])
 	if (!GSRunner::ParseCommandLineArgs(argc, argv, params))
 		return EXIT_FAILURE;
 
+	if (!s_pack_textures_dir.empty())
+	{
+		Error error;
+		if (!GSTextureReplacements::BuildReplacementArchive(s_pack_textures_dir, &error))
+		{
+			Console.Error(fmt::format("Failed to pack textures: {}", error.GetDescription()));
+			return EXIT_FAILURE;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
 	if (!VMManager::Internal::CPUThreadInitialize())
 		return EXIT_FAILURE;
 
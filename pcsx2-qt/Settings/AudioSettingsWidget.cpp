@@ -56,6 +56,7 @@ AudioSettingsWidget::AudioSettingsWidget(SettingsWindow* dialog, QWidget* parent
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.outputLatencyMS, "SPU2/Output", "OutputLatencyMS",
 		AudioStreamParameters::DEFAULT_OUTPUT_LATENCY_MS);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.outputLatencyMinimal, "SPU2/Output", "OutputLatencyMinimal", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.threadedOutput, "SPU2/Output", "ThreadedOutput", false);
 	connect(m_ui.audioBackend, &QComboBox::currentIndexChanged, this, &AudioSettingsWidget::updateDriverNames);
 	connect(m_ui.expansionMode, &QComboBox::currentIndexChanged, this, &AudioSettingsWidget::onExpansionModeChanged);
 	connect(m_ui.expansionSettings, &QToolButton::clicked, this, &AudioSettingsWidget::onExpansionSettingsClicked);
@@ -119,6 +120,9 @@ AudioSettingsWidget::AudioSettingsWidget(SettingsWindow* dialog, QWidget* parent
 		tr("When running outside of 100% speed, adjusts the tempo on audio instead of dropping frames. Produces much nicer fast-forward/slowdown audio."));
 	dialog->registerWidgetHelp(m_ui.stretchSettings, tr("Stretch Settings"), tr("N/A"),
 		tr("These settings fine-tune the behavior of the SoundTouch audio time stretcher when running outside of 100% speed."));
+	dialog->registerWidgetHelp(m_ui.threadedOutput, tr("Process Audio Output on a Separate Thread"), tr("Unchecked"),
+		tr("Runs time stretching, expansion and output buffering on their own thread, instead of on the emulation thread. "
+		   "Sound is still mixed on the emulation thread. This can help on slower CPUs when time stretching is enabled."));
 	dialog->registerWidgetHelp(m_ui.resetVolume, tr("Reset Volume"), tr("N/A"),
 		m_dialog->isPerGameSettings() ? tr("Resets output volume back to the global/inherited setting.") :
 										tr("Resets output volume back to the default."));
@@ -447,6 +451,10 @@ void AudioSettingsWidget::onStretchSettingsClicked()
 		AudioStreamParameters::DEFAULT_STRETCH_USE_QUICKSEEK);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, dlgui.useAAFilter, "SPU2/Output", "StretchUseAAFilter",
 		AudioStreamParameters::DEFAULT_STRETCH_USE_AA_FILTER);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, dlgui.useNative, "SPU2/Output", "StretchUseNative",
+		AudioStreamParameters::DEFAULT_STRETCH_USE_NATIVE);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, dlgui.minimalLatency, "SPU2/Output", "StretchMinimalLatency",
+		AudioStreamParameters::DEFAULT_STRETCH_MINIMAL_LATENCY);
 
 	connect(dlgui.buttonBox->button(QDialogButtonBox::Close), &QPushButton::clicked, &dlg, &QDialog::accept);
 	connect(dlgui.buttonBox->button(QDialogButtonBox::RestoreDefaults), &QPushButton::clicked, this, [this, &dlg]() {
@@ -470,6 +478,14 @@ void AudioSettingsWidget::onStretchSettingsClicked()
 			m_dialog->isPerGameSettings() ?
 				std::nullopt :
 				std::optional<bool>(AudioStreamParameters::DEFAULT_STRETCH_USE_AA_FILTER));
+		m_dialog->setBoolSettingValue("SPU2/Output", "StretchUseNative",
+			m_dialog->isPerGameSettings() ?
+				std::nullopt :
+				std::optional<bool>(AudioStreamParameters::DEFAULT_STRETCH_USE_NATIVE));
+		m_dialog->setBoolSettingValue("SPU2/Output", "StretchMinimalLatency",
+			m_dialog->isPerGameSettings() ?
+				std::nullopt :
+				std::optional<bool>(AudioStreamParameters::DEFAULT_STRETCH_MINIMAL_LATENCY));
 
 		dlg.done(0);
 
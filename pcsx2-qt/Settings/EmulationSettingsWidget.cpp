@@ -46,6 +46,7 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.threadPinning, "EmuCore", "EnableThreadPinning", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.fastCDVD, "EmuCore/Speedhacks", "fastCDVD", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.precacheCDVD, "EmuCore", "CdvdPrecache", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.prefetchCDVD, "EmuCore", "CdvdPrefetch", false);
 
 	if (m_dialog->isPerGameSettings())
 	{
@@ -133,6 +134,10 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* dialog, QWidget
 	dialog->registerWidgetHelp(m_ui.precacheCDVD, tr("Enable CDVD Precaching"), tr("Unchecked"),
 		tr("Loads the disc image into RAM before starting the virtual machine. Can reduce stutter on systems with hard drives that "
 		   "have long wake times, but significantly increases boot times."));
+	dialog->registerWidgetHelp(m_ui.prefetchCDVD, tr("Enable CDVD Prefetching"), tr("Unchecked"),
+		tr("Learns which parts of the disc each game reads, and loads them into RAM ahead of time. Can reduce stutter in "
+		   "streaming games on slow storage, without the boot time or memory cost of precaching the whole disc. Has no effect "
+		   "when precaching is enabled."));
 	dialog->registerWidgetHelp(m_ui.cheats, tr("Enable Cheats"), tr("Unchecked"),
 		tr("Automatically loads and applies cheats on game start."));
 	dialog->registerWidgetHelp(m_ui.hostFilesystem, tr("Enable Host Filesystem"), tr("Unchecked"),
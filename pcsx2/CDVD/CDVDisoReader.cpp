@@ -3,6 +3,7 @@
 
 #include "IsoFileFormats.h"
 #include "CDVD/CDVD.h"
+#include "Config.h"
 
 #include "common/Assertions.h"
 #include "common/Console.h"
@@ -52,6 +53,14 @@ static bool ISOopen(std::string filename, Error* error)
 	layer1start = -1;
 	layer1searched = false;
 
+	// Nothing to gain from prefetching if the whole image is going to be precached.
+	if (EmuConfig.CdvdPrefetch && !EmuConfig.CdvdPrecache)
+	{
+		Error prefetch_error;
+		if (!iso.EnablePrefetch(EmuConfig.CdvdPrefetchCacheSize, &prefetch_error))
+			Console.Warning("Failed to enable CDVD prefetching: %s", prefetch_error.GetDescription().c_str());
+	}
+
 	return true;
 }
 
@@ -64,6 +64,9 @@ int InputIsoFile::ReadSync(u8* dst, uint lsn)
 		return -1;
 	}
 
+	if (m_prefetch && m_prefetch->ReadSector(lsn, dst + m_blockofs))
+		return m_blocksize;
+
 	return m_reader->ReadSync(dst + m_blockofs, lsn, 1);
 }
 
@@ -85,6 +88,19 @@ void InputIsoFile::BeginRead2(uint lsn)
 
 	m_read_lsn = lsn;
 
+	if (m_prefetch)
+	{
+		// Don't let a stale request land in the buffer after we've filled it.
+		if (m_read_inprogress)
+		{
+			m_reader->CancelRead();
+			m_read_inprogress = false;
+		}
+
+		if (m_prefetch->ReadSector(m_read_lsn, m_readbuffer))
+			return;
+	}
+
 	m_reader->BeginRead(m_readbuffer, m_read_lsn, 1);
 	m_read_inprogress = true;
 }
@@ -226,8 +242,24 @@ bool InputIsoFile::Precache(ProgressCallback* progress, Error* error)
 	return m_reader->Precache(progress, error);
 }
 
+bool InputIsoFile::EnablePrefetch(u32 budget_mb, Error* error)
+{
+	std::unique_ptr<ThreadedFileReader> reader = GetFileReader(m_filename);
+	if (!reader->Open(m_filename, error))
+		return false;
+
+	reader->SetDataOffset(m_offset);
+	reader->SetBlockSize(m_blocksize);
+
+	m_prefetch = std::make_unique<IsoPrefetchCache>();
+	m_prefetch->Open(std::move(reader), m_filename, m_blocks, m_blocksize, budget_mb);
+	return true;
+}
+
 void InputIsoFile::Close()
 {
+	m_prefetch.reset();
+
 	if (m_reader)
 	{
 		m_reader->Close();
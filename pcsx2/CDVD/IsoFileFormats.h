@@ -4,6 +4,7 @@
 #pragma once
 
 #include "CDVD/CDVD.h"
+#include "CDVD/IsoPrefetchCache.h"
 #include "CDVD/ThreadedFileReader.h"
 #include <memory>
 #include <string>
@@ -33,6 +34,7 @@ class InputIsoFile final
 protected:
 	std::string m_filename;
 	std::unique_ptr<ThreadedFileReader> m_reader;
+	std::unique_ptr<IsoPrefetchCache> m_prefetch;
 
 	u32 m_current_lsn;
 
@@ -68,6 +70,10 @@ public:
 	bool Open(std::string srcfile, Error* error);
 	bool Precache(ProgressCallback* progress, Error* error);
 	void Close();
+
+	/// Opens a second reader on the image, and starts predictively caching sectors through it.
+	bool EnablePrefetch(u32 budget_mb, Error* error);
+
 	bool Detect(bool readType = true);
 
 	int ReadSync(u8* dst, uint lsn);
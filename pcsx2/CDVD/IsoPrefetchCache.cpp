@@ -0,0 +1,440 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "CDVD/IsoPrefetchCache.h"
+#include "CDVD/ThreadedFileReader.h"
+#include "Config.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Threading.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace
+{
+	struct ProfileHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 block_count;
+		u32 block_size;
+		u32 num_targets;
+	};
+
+	struct ProfileEntry
+	{
+		u32 lsn;
+		u32 hits;
+		u32 run_length;
+	};
+} // namespace
+
+static constexpr u32 PROFILE_MAGIC = 0x46504443; // CDPF
+static constexpr u32 PROFILE_VERSION = 1;
+
+// Only one image is open at a time, so the OSD reads these rather than going through the CDVD API.
+static std::atomic_bool s_stats_active{false};
+static std::atomic<u64> s_stats_hits{0};
+static std::atomic<u64> s_stats_misses{0};
+static std::atomic<u64> s_stats_prefetched{0};
+static std::atomic<u32> s_stats_resident{0};
+static std::atomic<u32> s_stats_budget{0};
+
+IsoPrefetchCache::IsoPrefetchCache() = default;
+
+IsoPrefetchCache::~IsoPrefetchCache()
+{
+	Close();
+}
+
+void IsoPrefetchCache::Open(std::unique_ptr<ThreadedFileReader> reader, const std::string& filename, u32 block_count,
+	u32 block_size, u32 budget_mb)
+{
+	Close();
+
+	m_reader = std::move(reader);
+	m_filename = filename;
+	m_block_count = block_count;
+	m_block_size = block_size;
+
+	const u32 chunk_bytes = CHUNK_SECTORS * m_block_size;
+	const u32 num_slots = std::max<u32>(static_cast<u32>((static_cast<u64>(budget_mb) * _1mb) / chunk_bytes), 1);
+	m_slots.resize(num_slots);
+
+	s_stats_hits.store(0, std::memory_order_relaxed);
+	s_stats_misses.store(0, std::memory_order_relaxed);
+	s_stats_prefetched.store(0, std::memory_order_relaxed);
+	s_stats_resident.store(0, std::memory_order_relaxed);
+	s_stats_budget.store(num_slots * chunk_bytes, std::memory_order_relaxed);
+	s_stats_active.store(true, std::memory_order_release);
+
+	LoadProfile();
+	QueueWarmup();
+
+	DEV_LOG("ISO prefetch: {} slots of {} sectors, {} known seek targets", num_slots, CHUNK_SECTORS,
+		m_seek_targets.size());
+
+	m_shutdown = false;
+	m_thread = std::thread(&IsoPrefetchCache::ThreadEntryPoint, this);
+}
+
+void IsoPrefetchCache::Close()
+{
+	if (!m_reader)
+		return;
+
+	EndStream();
+	SaveProfile();
+
+	{
+		std::unique_lock lock(m_mutex);
+		m_shutdown = true;
+		m_cv.notify_one();
+	}
+	m_thread.join();
+
+	m_reader->Close();
+	m_reader.reset();
+
+	m_slots.clear();
+	m_chunk_slots.clear();
+	m_stream_queue.clear();
+	m_warmup_queue.clear();
+	m_seek_targets.clear();
+	m_use_counter = 0;
+	m_last_lsn = INVALID_LSN;
+	m_stream_start = INVALID_LSN;
+	m_stream_length = 0;
+	m_queued_until = 0;
+	m_profile_dirty = false;
+
+	s_stats_active.store(false, std::memory_order_release);
+}
+
+bool IsoPrefetchCache::ReadSector(u32 lsn, void* dst)
+{
+	const u32 chunk = lsn / CHUNK_SECTORS;
+	bool hit = false;
+	{
+		std::unique_lock lock(m_mutex);
+		const auto it = m_chunk_slots.find(chunk);
+		if (it != m_chunk_slots.end())
+		{
+			Slot& slot = m_slots[it->second];
+			if (slot.state == SlotState::Ready)
+			{
+				std::memcpy(dst, &slot.data[(lsn % CHUNK_SECTORS) * m_block_size], m_block_size);
+				slot.last_use = ++m_use_counter;
+				hit = true;
+			}
+		}
+	}
+
+	(hit ? s_stats_hits : s_stats_misses).fetch_add(1, std::memory_order_relaxed);
+
+	// Re-reads of the same sector don't tell us anything new.
+	if (lsn == m_last_lsn)
+		return hit;
+
+	const bool sequential = (m_last_lsn != INVALID_LSN && lsn > m_last_lsn && (lsn - m_last_lsn) <= SEQUENTIAL_GAP);
+	m_last_lsn = lsn;
+
+	u32 prefetch_end;
+	if (sequential)
+	{
+		m_stream_length = lsn - m_stream_start + 1;
+		prefetch_end = lsn + 1 + READAHEAD_SECTORS;
+	}
+	else
+	{
+		EndStream();
+		m_stream_start = lsn;
+		m_stream_length = 1;
+		m_queued_until = lsn + 1;
+		prefetch_end = lsn + 1;
+
+		// Whatever was queued for the old stream is no longer interesting.
+		{
+			std::unique_lock lock(m_mutex);
+			m_stream_queue.clear();
+		}
+
+		const auto it = m_seek_targets.find(lsn);
+		if (it != m_seek_targets.end())
+		{
+			it->second.hits++;
+			prefetch_end += std::min(it->second.run_length, MAX_LEARNED_RUN);
+			m_profile_dirty = true;
+		}
+		else if (m_seek_targets.size() < MAX_SEEK_TARGETS)
+		{
+			m_seek_targets.emplace(lsn, SeekTarget{1, 0});
+			m_profile_dirty = true;
+		}
+	}
+
+	// Top up in batches, so a stream isn't taking the lock twice for every sector.
+	prefetch_end = std::min(prefetch_end, m_block_count);
+	if (prefetch_end <= m_queued_until || (sequential && (prefetch_end - m_queued_until) < (READAHEAD_SECTORS / 4)))
+		return hit;
+
+	{
+		std::unique_lock lock(m_mutex);
+		// Whatever didn't fit gets picked up by the next top-up.
+		m_queued_until = QueueRange(m_queued_until, prefetch_end, m_stream_queue);
+		m_cv.notify_one();
+	}
+
+	return hit;
+}
+
+bool IsoPrefetchCache::GetStats(Stats* stats)
+{
+	if (!s_stats_active.load(std::memory_order_acquire))
+		return false;
+
+	stats->hits = s_stats_hits.load(std::memory_order_relaxed);
+	stats->misses = s_stats_misses.load(std::memory_order_relaxed);
+	stats->prefetched_sectors = s_stats_prefetched.load(std::memory_order_relaxed);
+	stats->resident_bytes = s_stats_resident.load(std::memory_order_relaxed);
+	stats->budget_bytes = s_stats_budget.load(std::memory_order_relaxed);
+	return true;
+}
+
+void IsoPrefetchCache::ThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("ISO Prefetch");
+
+	std::unique_lock lock(m_mutex);
+	for (;;)
+	{
+		m_cv.wait(lock, [this]() { return m_shutdown || !m_stream_queue.empty() || !m_warmup_queue.empty(); });
+		if (m_shutdown)
+			break;
+
+		std::deque<u32>& queue = m_stream_queue.empty() ? m_warmup_queue : m_stream_queue;
+		const u32 chunk = queue.front();
+		queue.pop_front();
+		LoadChunk(chunk, lock);
+	}
+}
+
+void IsoPrefetchCache::LoadChunk(u32 chunk, std::unique_lock<std::mutex>& lock)
+{
+	if (m_chunk_slots.find(chunk) != m_chunk_slots.end())
+		return;
+
+	const s32 slot_index = FindEvictionSlot();
+	if (slot_index < 0)
+		return;
+
+	const u32 chunk_bytes = CHUNK_SECTORS * m_block_size;
+	Slot& slot = m_slots[slot_index];
+	if (slot.state == SlotState::Ready)
+	{
+		m_chunk_slots.erase(slot.chunk);
+		s_stats_resident.fetch_sub(chunk_bytes, std::memory_order_relaxed);
+	}
+	if (!slot.data)
+		slot.data = std::make_unique_for_overwrite<u8[]>(chunk_bytes);
+
+	slot.chunk = chunk;
+	slot.state = SlotState::Loading;
+	m_chunk_slots.emplace(chunk, static_cast<u32>(slot_index));
+
+	const u32 first_lsn = chunk * CHUNK_SECTORS;
+	const u32 count = std::min(CHUNK_SECTORS, m_block_count - first_lsn);
+	u8* const data = slot.data.get();
+
+	// The slot can't be evicted or looked up while it's loading, so it's safe to fill without the lock.
+	lock.unlock();
+	const int bytes_read = m_reader->ReadSync(data, first_lsn, count);
+	lock.lock();
+
+	if (bytes_read < static_cast<int>(count * m_block_size))
+	{
+		WARNING_LOG("ISO prefetch: Failed to read sectors {}-{}", first_lsn, first_lsn + count - 1);
+		m_chunk_slots.erase(chunk);
+		slot.state = SlotState::Free;
+		return;
+	}
+
+	slot.state = SlotState::Ready;
+	slot.last_use = ++m_use_counter;
+	s_stats_prefetched.fetch_add(count, std::memory_order_relaxed);
+	s_stats_resident.fetch_add(chunk_bytes, std::memory_order_relaxed);
+}
+
+s32 IsoPrefetchCache::FindEvictionSlot() const
+{
+	s32 best = -1;
+	u64 best_use = UINT64_MAX;
+	for (u32 i = 0; i < static_cast<u32>(m_slots.size()); i++)
+	{
+		const Slot& slot = m_slots[i];
+		if (slot.state == SlotState::Free)
+			return static_cast<s32>(i);
+		if (slot.state == SlotState::Ready && slot.last_use < best_use)
+		{
+			best = static_cast<s32>(i);
+			best_use = slot.last_use;
+		}
+	}
+
+	return best;
+}
+
+u32 IsoPrefetchCache::QueueRange(u32 start_lsn, u32 end_lsn, std::deque<u32>& queue)
+{
+	// Never queue more than half the cache, otherwise the tail of the queue evicts the head.
+	const size_t max_queued = std::max<size_t>(m_slots.size() / 2, 1);
+
+	const u32 last_chunk = (end_lsn - 1) / CHUNK_SECTORS;
+	for (u32 chunk = start_lsn / CHUNK_SECTORS; chunk <= last_chunk; chunk++)
+	{
+		if (m_chunk_slots.find(chunk) != m_chunk_slots.end() || (!queue.empty() && queue.back() == chunk))
+			continue;
+
+		if (queue.size() >= max_queued)
+			return std::max(start_lsn, chunk * CHUNK_SECTORS);
+
+		queue.push_back(chunk);
+	}
+
+	return end_lsn;
+}
+
+void IsoPrefetchCache::EndStream()
+{
+	if (m_stream_start == INVALID_LSN)
+		return;
+
+	const auto it = m_seek_targets.find(m_stream_start);
+	if (it != m_seek_targets.end())
+	{
+		// Smooth the run length, so one early bail-out doesn't throw away what we've learned.
+		const u32 run = std::min(m_stream_length, MAX_LEARNED_RUN);
+		it->second.run_length = (it->second.run_length != 0) ? ((it->second.run_length * 3 + run) / 4) : run;
+		m_profile_dirty = true;
+	}
+
+	m_stream_start = INVALID_LSN;
+	m_stream_length = 0;
+}
+
+std::string IsoPrefetchCache::GetProfilePath() const
+{
+	// Block count is included so that a different dump with the same name doesn't pick up the wrong profile.
+	std::string name = Path::SanitizeFileName(Path::GetFileTitle(m_filename));
+	if (name.empty())
+		name = "Untitled";
+
+	return Path::Combine(EmuFolders::Cache,
+		Path::Combine("cdvd_prefetch", fmt::format("{}_{:08X}.bin", name, m_block_count)));
+}
+
+void IsoPrefetchCache::LoadProfile()
+{
+	const std::string path = GetProfilePath();
+	if (!FileSystem::FileExists(path.c_str()))
+		return;
+
+	const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+	if (!data.has_value() || data->size() < sizeof(ProfileHeader))
+		return;
+
+	ProfileHeader header;
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != PROFILE_MAGIC || header.version != PROFILE_VERSION || header.block_count != m_block_count ||
+		header.block_size != m_block_size || header.num_targets > MAX_SEEK_TARGETS ||
+		data->size() < (sizeof(ProfileHeader) + header.num_targets * sizeof(ProfileEntry)))
+	{
+		WARNING_LOG("ISO prefetch: Ignoring invalid profile '{}'", Path::GetFileName(path));
+		return;
+	}
+
+	const u8* ptr = data->data() + sizeof(ProfileHeader);
+	for (u32 i = 0; i < header.num_targets; i++, ptr += sizeof(ProfileEntry))
+	{
+		ProfileEntry entry;
+		std::memcpy(&entry, ptr, sizeof(entry));
+		if (entry.lsn < m_block_count)
+			m_seek_targets.emplace(entry.lsn, SeekTarget{entry.hits, std::min(entry.run_length, MAX_LEARNED_RUN)});
+	}
+}
+
+void IsoPrefetchCache::SaveProfile()
+{
+	if (!m_profile_dirty)
+		return;
+
+	// Targets we've only seen once are most likely noise, drop them so they don't crowd out real ones.
+	std::vector<ProfileEntry> entries;
+	entries.reserve(m_seek_targets.size());
+	for (const auto& [lsn, target] : m_seek_targets)
+	{
+		if (target.hits >= 2 && target.run_length > 0)
+			entries.push_back(ProfileEntry{lsn, target.hits, target.run_length});
+	}
+	if (entries.empty())
+		return;
+
+	const std::string path = GetProfilePath();
+	Error error;
+	if (!FileSystem::CreateDirectoryPath(std::string(Path::GetDirectory(path)).c_str(), false, &error))
+	{
+		ERROR_LOG("ISO prefetch: Failed to create profile directory: {}", error.GetDescription());
+		return;
+	}
+
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "wb", &error);
+	if (!fp)
+	{
+		ERROR_LOG("ISO prefetch: Failed to open '{}': {}", Path::GetFileName(path), error.GetDescription());
+		return;
+	}
+
+	const ProfileHeader header = {PROFILE_MAGIC, PROFILE_VERSION, m_block_count, m_block_size,
+		static_cast<u32>(entries.size())};
+	if (std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 ||
+		std::fwrite(entries.data(), sizeof(ProfileEntry), entries.size(), fp.get()) != entries.size())
+	{
+		ERROR_LOG("ISO prefetch: Failed to write '{}'", Path::GetFileName(path));
+		fp.reset();
+		FileSystem::DeleteFilePath(path.c_str());
+		return;
+	}
+
+	m_profile_dirty = false;
+}
+
+void IsoPrefetchCache::QueueWarmup()
+{
+	std::vector<std::pair<u32, SeekTarget>> targets;
+	targets.reserve(m_seek_targets.size());
+	for (const auto& it : m_seek_targets)
+	{
+		if (it.second.hits >= 2 && it.second.run_length > 0)
+			targets.push_back(it);
+	}
+
+	// Most frequently hit targets first, and leave half the cache for streaming.
+	std::sort(targets.begin(), targets.end(),
+		[](const auto& lhs, const auto& rhs) { return lhs.second.hits > rhs.second.hits; });
+
+	const size_t max_queued = std::max<size_t>(m_slots.size() / 2, 1);
+	for (const auto& [lsn, target] : targets)
+	{
+		if (m_warmup_queue.size() >= max_queued)
+			break;
+
+		QueueRange(lsn, std::min(lsn + target.run_length, m_block_count), m_warmup_queue);
+	}
+}
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class ThreadedFileReader;
+
+/// Predictive sector cache sitting in front of an InputIsoFile.
+/// Guest reads are fed to a simple predictor, which detects sequential streams and remembers which seek
+/// targets recur, along with how far the game usually reads after seeking there. Predicted sectors are
+/// loaded into a fixed-size cache on a worker thread through a second reader, so the emulated drive only
+/// touches the disk image on a miss. Recurring seek targets are persisted per-image, and used to warm the
+/// cache when the image is next opened.
+class IsoPrefetchCache
+{
+	DeclareNoncopyableObject(IsoPrefetchCache);
+
+public:
+	struct Stats
+	{
+		u64 hits;
+		u64 misses;
+		u64 prefetched_sectors;
+		u32 resident_bytes;
+		u32 budget_bytes;
+	};
+
+	IsoPrefetchCache();
+	~IsoPrefetchCache();
+
+	/// Takes ownership of a reader which is already open on the image, with block size and data offset set.
+	void Open(std::unique_ptr<ThreadedFileReader> reader, const std::string& filename, u32 block_count, u32 block_size,
+		u32 budget_mb);
+	void Close();
+
+	/// Records a guest read of the given sector, and copies it to dst if it is resident.
+	/// Returns false on a miss, in which case the caller should read the sector itself.
+	bool ReadSector(u32 lsn, void* dst);
+
+	/// Returns stats for the currently-open cache, or false if prefetching is not active.
+	static bool GetStats(Stats* stats);
+
+private:
+	/// Sectors are cached in aligned runs of this many sectors.
+	static constexpr u32 CHUNK_SECTORS = 16;
+
+	/// How far ahead of a sequential stream to stay, in sectors.
+	static constexpr u32 READAHEAD_SECTORS = 256;
+
+	/// Reads which skip forward by no more than this many sectors are still treated as part of a stream.
+	static constexpr u32 SEQUENTIAL_GAP = 8;
+
+	/// Upper bound on how much a single learned seek target will prefetch.
+	static constexpr u32 MAX_LEARNED_RUN = 4096;
+
+	/// Upper bound on the number of seek targets tracked per image.
+	static constexpr u32 MAX_SEEK_TARGETS = 4096;
+
+	static constexpr u32 INVALID_LSN = 0xFFFFFFFFu;
+
+	enum class SlotState : u8
+	{
+		Free,
+		Loading,
+		Ready,
+	};
+
+	struct Slot
+	{
+		u32 chunk = 0;
+		SlotState state = SlotState::Free;
+		u64 last_use = 0;
+		std::unique_ptr<u8[]> data;
+	};
+
+	struct SeekTarget
+	{
+		u32 hits;
+		u32 run_length;
+	};
+
+	void ThreadEntryPoint();
+
+	/// Loads a single chunk into the least recently used slot. Called with the lock held.
+	void LoadChunk(u32 chunk, std::unique_lock<std::mutex>& lock);
+
+	/// Returns the least recently used slot which isn't being loaded, or -1 if all slots are busy.
+	s32 FindEvictionSlot() const;
+
+	/// Queues chunks covering [start_lsn, end_lsn) which are not already resident.
+	/// Returns the LSN queueing got up to, which is short of end_lsn if the queue filled up.
+	u32 QueueRange(u32 start_lsn, u32 end_lsn, std::deque<u32>& queue);
+
+	void EndStream();
+
+	std::string GetProfilePath() const;
+	void LoadProfile();
+	void SaveProfile();
+	void QueueWarmup();
+
+	std::unique_ptr<ThreadedFileReader> m_reader;
+	std::string m_filename;
+	u32 m_block_count = 0;
+	u32 m_block_size = 0;
+
+	// Predictor state, only touched on the CPU thread.
+	u32 m_last_lsn = INVALID_LSN;
+	u32 m_stream_start = INVALID_LSN;
+	u32 m_stream_length = 0;
+	u32 m_queued_until = 0;
+	std::unordered_map<u32, SeekTarget> m_seek_targets;
+	bool m_profile_dirty = false;
+
+	// Everything below is protected by m_mutex.
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::thread m_thread;
+	bool m_shutdown = false;
+
+	std::vector<Slot> m_slots;
+	std::unordered_map<u32, u32> m_chunk_slots;
+	u64 m_use_counter = 0;
+
+	/// Chunks predicted from the current access pattern, serviced first.
+	std::deque<u32> m_stream_queue;
+
+	/// Chunks from the persisted profile, serviced when there's nothing more urgent.
+	std::deque<u32> m_warmup_queue;
+};
@@ -3,6 +3,7 @@
 
 #include "Common.h"
 #include "COP0.h"
+#include "Cache.h"
 
 // Updates the CPU's mode of operation (either, Kernel, Supervisor, or User modes).
 // Currently the different modes are not implemented.
@@ -32,6 +33,9 @@ void WriteCP0Config(u32 value)
 	// Protect the read-only ICacheSize (IC) and DataCacheSize (DC) bits
 	cpuRegs.CP0.n.Config = value & ~0xFC0;
 	cpuRegs.CP0.n.Config |= 0x440;
+
+	// The data cache enable bit may have changed.
+	clearCacheFastTags();
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -278,6 +282,8 @@ void MapTLB(const tlbs& t, int i)
 			}
 		}
 	}
+
+	vtlb_UpdateCachedPages();
 }
 
 __inline u32 ConvertPageMask(const u32 PageMask)
@@ -298,6 +304,7 @@ void UnmapTLB(const tlbs& t, int i)
 	if (t.isSPR())
 	{
 		vtlb_VMapUnmap(t.VPN2(), 0x4000);
+		clearCacheFastTags();
 		return;
 	}
 
@@ -349,6 +356,8 @@ void UnmapTLB(const tlbs& t, int i)
 			break;
 		}
 	}
+
+	vtlb_UpdateCachedPages();
 }
 
 void WriteTLB(int i)
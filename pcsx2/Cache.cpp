@@ -103,6 +103,7 @@ namespace
 	{
 		CacheTag& tag;
 		CacheData& data;
+		u32& fastTag;
 		int set;
 
 		uptr addr()
@@ -137,7 +138,6 @@ namespace
 			{
 				std::memcpy(&data, reinterpret_cast<void*>(ppf & ~0x3FULL), sizeof(data));
 			}
-
 			tag.setValid();
 			tag.clearDirty();
 		}
@@ -145,19 +145,18 @@ namespace
 		void clear()
 		{
 			tag.clear();
+			fastTag = 0;
 			std::memset(&data, 0, sizeof(data));
 		}
 	};
 
-	struct CacheSet
-	{
-		CacheTag tags[2];
-		CacheData data[2];
-	};
-
+	// Stored as parallel arrays indexed by [set][way], so the recompiler can check both ways of a set
+	// with two loads from the fast tag array, and find the line's tag and data by scaling the same index.
 	struct Cache
 	{
-		CacheSet sets[64];
+		alignas(64) u32 fastTags[64][2];
+		alignas(64) CacheTag tags[64][2];
+		CacheData data[64][2];
 
 		int setIdxFor(u32 vaddr) const
 		{
@@ -166,10 +165,12 @@ namespace
 
 		CacheLine lineAt(int idx, int way)
 		{
-			return {sets[idx].tags[way], sets[idx].data[way], idx};
+			return {tags[idx][way], data[idx][way], fastTags[idx][way], idx};
 		}
 	};
 
+	static_assert(CacheTag::DIRTY_FLAG == CACHE_TAG_DIRTY_FLAG && sizeof(CacheTag) == sizeof(uptr));
+
 	static Cache cache = {};
 } // namespace
 
@@ -178,6 +179,26 @@ void resetCache()
 	std::memset(&cache, 0, sizeof(cache));
 }
 
+void clearCacheFastTags()
+{
+	std::memset(cache.fastTags, 0, sizeof(cache.fastTags));
+}
+
+u32* getCacheFastTags()
+{
+	return &cache.fastTags[0][0];
+}
+
+uptr* getCacheTags()
+{
+	return &cache.tags[0][0].rawValue;
+}
+
+u8* getCacheData()
+{
+	return cache.data[0][0].bytes;
+}
+
 void writebackCache()
 {
 	for (int i = 0; i < 64; i++)
@@ -189,10 +210,10 @@ void writebackCache()
 	}
 }
 
-static bool findInCache(const CacheSet& set, uptr ppf, int* way)
+static bool findInCache(const CacheTag* tags, uptr ppf, int* way)
 {
 	auto check = [&](int checkWay) -> bool {
-		if (!set.tags[checkWay].matches(ppf))
+		if (!tags[checkWay].matches(ppf))
 			return false;
 
 		*way = checkWay;
@@ -205,10 +226,10 @@ static bool findInCache(const CacheSet& set, uptr ppf, int* way)
 static int getFreeCache(u32 mem, int* way, bool validPFN)
 {
 	const int setIdx = cache.setIdxFor(mem);
-	CacheSet& set = cache.sets[setIdx];
+	CacheTag* tags = cache.tags[setIdx];
 	VTLBVirtual vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
 
-	*way = set.tags[0].lrf() ^ set.tags[1].lrf();
+	*way = tags[0].lrf() ^ tags[1].lrf();
 	if (validPFN)
 		pxAssertMsg(!vmv.isHandler(mem), "Cache currently only supports non-handler addresses!");
 
@@ -218,13 +239,13 @@ static int getFreeCache(u32 mem, int* way, bool validPFN)
 	if ((cpuRegs.CP0.n.Config & 0x10000) == 0)
 		CACHE_LOG("Cache off!");
 
-	if (findInCache(set, ppf, way))
+	if (findInCache(tags, ppf, way))
 	{
 		[[unlikely]]
-		if (set.tags[*way].isLocked())
+		if (tags[*way].isLocked())
 		{
 			// Check the other way
-			if (set.tags[*way ^ 1].isLocked())
+			if (tags[*way ^ 1].isLocked())
 			{
 				Console.Error("CACHE: SECOND WAY IS LOCKED.", setIdx, *way);
 			}
@@ -237,14 +258,14 @@ static int getFreeCache(u32 mem, int* way, bool validPFN)
 	}
 	else
 	{
-		int newWay = set.tags[0].lrf() ^ set.tags[1].lrf();
+		int newWay = tags[0].lrf() ^ tags[1].lrf();
 		[[unlikely]]
-		if (set.tags[newWay].isLocked())
+		if (tags[newWay].isLocked())
 		{
 			// If the new way is locked, we force the unlocked way, ignoring the lrf bits.
 			newWay = newWay ^ 1;
 			[[unlikely]]
-			if (set.tags[newWay].isLocked())
+			if (tags[newWay].isLocked())
 			{
 				Console.Warning("CACHE: SECOND WAY IS LOCKED.", setIdx, *way);
 			}
@@ -258,6 +279,11 @@ static int getFreeCache(u32 mem, int* way, bool validPFN)
 		line.tag.toggleLRF();
 	}
 
+	// Let the recompiler hit this line inline next time, unless it has to come back here for the lock handling
+	// or for the bus error on an invalid physical address.
+	const CacheTag& tag = tags[*way];
+	cache.fastTags[setIdx][*way] = (validPFN && tag.matches(ppf) && !tag.isLocked()) ? ((mem & ~0x3F) | CACHE_FAST_TAG_VALID) : 0;
+
 	return setIdx;
 }
 
@@ -358,18 +384,18 @@ template <typename Op>
 void doCacheHitOp(u32 addr, const char* name, Op op)
 {
 	const int index = cache.setIdxFor(addr);
-	CacheSet& set = cache.sets[index];
+	const CacheTag* tags = cache.tags[index];
 	VTLBVirtual vmv = vtlbdata.vmap[addr >> VTLB_PAGE_BITS];
 	uptr ppf = vmv.assumePtr(addr);
 	int way;
 
-	if (!findInCache(set, ppf, &way))
+	if (!findInCache(tags, ppf, &way))
 	{
-		CACHE_LOG("CACHE %s NO HIT addr %x, index %d, tag0 %zx tag1 %zx", name, addr, index, set.tags[0].rawValue, set.tags[1].rawValue);
+		CACHE_LOG("CACHE %s NO HIT addr %x, index %d, tag0 %zx tag1 %zx", name, addr, index, tags[0].rawValue, tags[1].rawValue);
 		return;
 	}
 
-	CACHE_LOG("CACHE %s addr %x, index %d, way %d, flags %x OP %x", name, addr, index, way, set.tags[way].flags(), cpuRegs.code);
+	CACHE_LOG("CACHE %s addr %x, index %d, way %d, flags %x OP %x", name, addr, index, way, tags[way].flags(), cpuRegs.code);
 
 	op(cache.lineAt(index, way));
 }
@@ -471,6 +497,7 @@ namespace R5900
                         line.tag.setAddr(cpuRegs.CP0.n.TagLo);
 						line.tag.rawValue &= ~CacheTag::ALL_FLAGS;
 						line.tag.rawValue |= (cpuRegs.CP0.n.TagLo & CacheTag::ALL_FLAGS);
+						line.fastTag = 0;
 
 						CACHE_LOG("CACHE DXSTG addr %x, index %d, way %d, DATA %x OP %x", addr, index, way, cpuRegs.CP0.n.TagLo, cpuRegs.code);
 						break;
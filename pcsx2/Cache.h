@@ -11,6 +11,18 @@ void resetCache();
 // Dumps all dirty cache entries to memory
 // This is necessary to fix a bug when enabled the recompiler while the cache was enabled.
 void writebackCache();
+
+// The recompiler checks for data cache hits inline. Each line has a fast tag, holding the virtual address it was
+// last accessed through with bit 0 set, or zero if an access has to go through the full lookup. All three arrays
+// are indexed by (set * 2 + way), and data lines are 64 bytes.
+static constexpr u32 CACHE_FAST_TAG_VALID = 0x1;
+static constexpr u32 CACHE_TAG_DIRTY_FLAG = 0x40;
+// Must be called whenever the virtual to physical mapping or the cache enable bit changes.
+void clearCacheFastTags();
+u32* getCacheFastTags();
+uptr* getCacheTags();
+u8* getCacheData();
+
 void writeCache8(u32 mem, u8 value, bool validPFN = true);
 void writeCache16(u32 mem, u16 value, bool validPFN = true);
 void writeCache32(u32 mem, u32 value, bool validPFN = true);
@@ -591,12 +591,17 @@ struct Pcsx2Config
 		BITFIELD32()
 		bool
 			Enabled : 1, // universal toggle for the profiler.
-			RecBlocks_EE : 1, // Enables per-block profiling for the EE recompiler [unimplemented]
-			RecBlocks_IOP : 1, // Enables per-block profiling for the IOP recompiler [unimplemented]
-			RecBlocks_VU0 : 1, // Enables per-block profiling for the VU0 recompiler [unimplemented]
-			RecBlocks_VU1 : 1; // Enables per-block profiling for the VU1 recompiler [unimplemented]
+			RecBlocks_EE : 1, // Attributes samples in EE recompiled code to guest blocks
+			RecBlocks_IOP : 1, // Attributes samples in IOP recompiled code to guest blocks
+			RecBlocks_VU0 : 1, // Attributes samples in VU0 recompiled code to guest blocks
+			RecBlocks_VU1 : 1; // Attributes samples in VU1 recompiled code to guest blocks
 		BITFIELD_END
 
+		static constexpr u32 MIN_SAMPLE_RATE = 10;
+		static constexpr u32 MAX_SAMPLE_RATE = 10000;
+
+		u32 SampleRate = 1000; // Host samples taken per second, per sampled thread.
+
 		// Default is Disabled, with all recs enabled underneath.
 		ProfilerOptions();
 		void LoadSave(SettingsWrapper& wrap);
@@ -743,6 +748,7 @@ struct Pcsx2Config
 					OsdShowHardwareInfo : 1,
 					HWSpinGPUForReadbacks : 1,
 					HWSpinCPUForReadbacks : 1,
+					HWSpeculativeReadbacks : 1,
 					GPUPaletteConversion : 1,
 					AutoFlushSW : 1,
 					PreloadFrameWithGSData : 1,
@@ -937,6 +943,9 @@ struct Pcsx2Config
 		u32 FastForwardVolume = 100;
 		bool OutputMuted = false;
 
+		/// Runs time stretching and output buffering on a separate thread, instead of inline with mixing.
+		bool ThreadedOutput = false;
+
 		AudioBackend Backend = DEFAULT_BACKEND;
 		SPU2SyncMode SyncMode = DEFAULT_SYNC_MODE;
 		AudioStreamParameters StreamParameters;
@@ -1287,6 +1296,7 @@ struct Pcsx2Config
 		CdvdVerboseReads : 1, // enables cdvd read activity verbosely dumped to the console
 		CdvdDumpBlocks : 1, // enables cdvd block dumping
 		CdvdPrecache : 1, // enables cdvd precaching of compressed images
+		CdvdPrefetch : 1, // enables predictive cdvd sector prefetching
 		EnablePatches : 1, // enables patch detection and application
 		EnableCheats : 1, // enables cheat detection and application
 		EnablePINE : 1, // enables inter-process communication
@@ -1337,6 +1347,8 @@ struct Pcsx2Config
 
 	int PINESlot;
 
+	u32 CdvdPrefetchCacheSize; // in megabytes
+
 	int RtcYear;
 	int RtcMonth;
 	int RtcDay;
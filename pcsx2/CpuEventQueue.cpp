@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "CpuEventQueue.h"
+
+#include "common/Console.h"
+
+void CpuEventStats::Log(const char* cpu_name, const char* const* names, u32 num_names) const
+{
+	bool header = false;
+	for (u32 id = 0; id < CpuEventQueue::MAX_EVENTS; id++)
+	{
+		const Counters& counters = m_counters[id];
+		if (counters.fired == 0)
+			continue;
+
+		if (!header)
+		{
+			DevCon.WriteLn("(%s) Event statistics:", cpu_name);
+			header = true;
+		}
+
+		const char* name = (id < num_names && names[id]) ? names[id] : "Unknown";
+		DevCon.WriteLn("  %-20s %10llu fired, %8.1f avg / %u max cycles late", name,
+			static_cast<unsigned long long>(counters.fired),
+			static_cast<double>(counters.total_latency) / static_cast<double>(counters.fired), counters.max_latency);
+	}
+}
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+#include <algorithm>
+#include <array>
+
+/// Pending events for one CPU, ordered by the cycle they're due on. Each event id is queued at most once,
+/// so scheduling and removal are O(log n) in the number of pending events, and the next deadline is O(1).
+///
+/// The interrupt mask and sCycle/eCycle arrays in the CPU registers are still the source of truth (and what
+/// goes in save states). Code which clears an interrupt bit or moves a deadline behind our back is picked up
+/// when that event reaches the front of the queue.
+class CpuEventQueue
+{
+public:
+	static constexpr u32 MAX_EVENTS = 32;
+
+	CpuEventQueue() { Clear(); }
+
+	void Clear()
+	{
+		m_size = 0;
+		m_position.fill(NOT_QUEUED);
+	}
+
+	__fi bool IsEmpty() const { return (m_size == 0); }
+	__fi bool IsQueued(u32 id) const { return (m_position[id] != NOT_QUEUED); }
+
+	/// Only valid when the queue isn't empty.
+	__fi u32 GetNextDeadline() const { return m_heap[0].deadline; }
+
+	/// Queues an event, or moves it if it's already queued.
+	void Schedule(u32 id, u32 deadline)
+	{
+		u32 pos = m_position[id];
+		if (pos == NOT_QUEUED)
+		{
+			pos = m_size++;
+			m_heap[pos] = {deadline, id};
+			m_position[id] = static_cast<u8>(pos);
+			SiftUp(pos);
+			return;
+		}
+
+		const u32 old_deadline = m_heap[pos].deadline;
+		m_heap[pos].deadline = deadline;
+		if (Before(deadline, old_deadline))
+			SiftUp(pos);
+		else
+			SiftDown(pos);
+	}
+
+	void Remove(u32 id)
+	{
+		const u32 pos = m_position[id];
+		if (pos == NOT_QUEUED)
+			return;
+
+		m_position[id] = NOT_QUEUED;
+		if (pos == --m_size)
+			return;
+
+		const u32 old_deadline = m_heap[pos].deadline;
+		m_heap[pos] = m_heap[m_size];
+		m_position[m_heap[pos].id] = static_cast<u8>(pos);
+		if (Before(m_heap[pos].deadline, old_deadline))
+			SiftUp(pos);
+		else
+			SiftDown(pos);
+	}
+
+	/// Drops or re-sorts events at the front whose registers no longer match the queue,
+	/// so that the next deadline is accurate.
+	template <typename ECycle>
+	void Validate(u32 interrupt, const u32* sCycle, const ECycle* eCycle)
+	{
+		while (m_size > 0)
+		{
+			const u32 id = m_heap[0].id;
+			if (!(interrupt & (1u << id)))
+			{
+				Remove(id);
+				continue;
+			}
+
+			const u32 deadline = sCycle[id] + static_cast<u32>(eCycle[id]);
+			if (deadline == m_heap[0].deadline)
+				break;
+
+			Schedule(id, deadline);
+		}
+	}
+
+	/// Removes every event which is due on or before cycle, and returns them as a mask.
+	template <typename ECycle>
+	u32 PopDue(u32 cycle, u32 interrupt, const u32* sCycle, const ECycle* eCycle)
+	{
+		u32 due = 0;
+		for (;;)
+		{
+			Validate(interrupt, sCycle, eCycle);
+			if (m_size == 0 || Before(cycle, m_heap[0].deadline))
+				break;
+
+			due |= 1u << m_heap[0].id;
+			Remove(m_heap[0].id);
+		}
+
+		return due;
+	}
+
+	/// Rebuilds the queue from the registers, after a reset or state load.
+	template <typename ECycle>
+	void Rebuild(u32 interrupt, const u32* sCycle, const ECycle* eCycle)
+	{
+		Clear();
+		for (u32 id = 0; id < MAX_EVENTS; id++)
+		{
+			if (interrupt & (1u << id))
+				Schedule(id, sCycle[id] + static_cast<u32>(eCycle[id]));
+		}
+	}
+
+private:
+	static constexpr u8 NOT_QUEUED = 0xFF;
+
+	struct Entry
+	{
+		u32 deadline;
+		u32 id;
+	};
+
+	/// Cycle counters wrap, so compare the difference.
+	static __fi bool Before(u32 lhs, u32 rhs) { return (static_cast<s32>(lhs - rhs) < 0); }
+
+	void SiftUp(u32 pos)
+	{
+		const Entry entry = m_heap[pos];
+		while (pos > 0)
+		{
+			const u32 parent = (pos - 1) / 2;
+			if (!Before(entry.deadline, m_heap[parent].deadline))
+				break;
+
+			m_heap[pos] = m_heap[parent];
+			m_position[m_heap[pos].id] = static_cast<u8>(pos);
+			pos = parent;
+		}
+
+		m_heap[pos] = entry;
+		m_position[entry.id] = static_cast<u8>(pos);
+	}
+
+	void SiftDown(u32 pos)
+	{
+		const Entry entry = m_heap[pos];
+		for (;;)
+		{
+			u32 child = pos * 2 + 1;
+			if (child >= m_size)
+				break;
+			if ((child + 1) < m_size && Before(m_heap[child + 1].deadline, m_heap[child].deadline))
+				child++;
+			if (!Before(m_heap[child].deadline, entry.deadline))
+				break;
+
+			m_heap[pos] = m_heap[child];
+			m_position[m_heap[pos].id] = static_cast<u8>(pos);
+			pos = child;
+		}
+
+		m_heap[pos] = entry;
+		m_position[entry.id] = static_cast<u8>(pos);
+	}
+
+	std::array<Entry, MAX_EVENTS> m_heap;
+	std::array<u8, MAX_EVENTS> m_position;
+	u32 m_size;
+};
+
+/// How often each event fires, and how many cycles late it was compared to when it was scheduled for.
+/// Lateness comes from events only being checked at event tests, so it shows how coarse the scheduling is.
+class CpuEventStats
+{
+public:
+	__fi void Record(u32 id, s32 latency)
+	{
+		Counters& counters = m_counters[id];
+		const u32 late = static_cast<u32>(std::max(latency, 0));
+		counters.fired++;
+		counters.total_latency += late;
+		counters.max_latency = std::max(counters.max_latency, late);
+	}
+
+	void Reset() { m_counters = {}; }
+
+	/// Prints every event which has fired since the last reset. names is indexed by event id, and can have gaps.
+	void Log(const char* cpu_name, const char* const* names, u32 num_names) const;
+
+private:
+	struct Counters
+	{
+		u64 fired;
+		u64 total_latency;
+		u32 max_latency;
+	};
+
+	std::array<Counters, CpuEventQueue::MAX_EVENTS> m_counters = {};
+};
@@ -0,0 +1,496 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GuestProfiler.h"
+#include "SymbolGuardian.h"
+
+#include "Memory.h"
+#include "VMManager.h"
+
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Threading.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#include "common/RedtapeWindows.h"
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <pthread.h>
+#include <signal.h>
+#include <ucontext.h>
+#endif
+
+namespace GuestProfiler
+{
+	namespace
+	{
+		struct CodeBlock
+		{
+			uptr end;
+			u32 pc;
+			Source source;
+		};
+
+		struct ThreadState
+		{
+			bool registered = false;
+#if defined(_WIN32)
+			HANDLE handle = nullptr;
+#elif defined(__APPLE__)
+			mach_port_t port = MACH_PORT_NULL;
+#else
+			pthread_t thread = {};
+
+			// The signal handler answers a request by copying its sequence number into reply.
+			std::atomic<u32> request{0};
+			std::atomic<u32> reply{0};
+			std::atomic<uptr> pc{0};
+#endif
+		};
+
+		/// What a sample landed in. Anything other than a block is only broken down by source, if at all.
+		enum class SampleKind : u8
+		{
+			Block,
+			Dispatcher,
+			VifUnpack,
+			Native,
+		};
+	} // namespace
+
+	static void SamplerThreadEntryPoint(u32 sample_rate);
+	static bool CapturePC(ThreadState& state, uptr* pc);
+	static void RecordSample(SampledThread thread, uptr pc);
+	static void WriteReport();
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+	static bool InstallSignalHandler();
+	static void SignalHandler(int sig, siginfo_t* info, void* ctx);
+#endif
+
+	static constexpr const char* s_source_names[] = {"EE", "IOP", "VU0", "VU1"};
+	static constexpr const char* s_thread_names[] = {"CPU thread", "MTVU thread"};
+
+	static std::atomic<u32> s_block_sources{0};
+
+	static std::mutex s_code_mutex;
+	static std::map<uptr, CodeBlock> s_code_map;
+
+	static std::mutex s_thread_mutex;
+	static std::array<ThreadState, static_cast<size_t>(SampledThread::Count)> s_threads;
+
+	static Threading::Thread s_sampler_thread;
+	static std::atomic_bool s_stop_sampling{false};
+
+	// Only touched by the sampler thread while it's running.
+	static std::unordered_map<u64, u64> s_samples;
+	static u64 s_total_samples = 0;
+} // namespace GuestProfiler
+
+static constexpr u64 MakeSampleKey(GuestProfiler::SampledThread thread, GuestProfiler::SampleKind kind,
+	GuestProfiler::Source source, u32 pc)
+{
+	return (static_cast<u64>(thread) << 48) | (static_cast<u64>(kind) << 40) | (static_cast<u64>(source) << 32) | pc;
+}
+
+bool GuestProfiler::IsActive()
+{
+	return s_sampler_thread.Joinable();
+}
+
+void GuestProfiler::Start(const Pcsx2Config::ProfilerOptions& options)
+{
+	if (IsActive())
+		Stop();
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+	if (!InstallSignalHandler())
+	{
+		Console.Error("GuestProfiler: Failed to install the sampling signal handler.");
+		return;
+	}
+#endif
+
+	{
+		std::unique_lock lock(s_code_mutex);
+		s_code_map.clear();
+	}
+
+	s_samples.clear();
+	s_total_samples = 0;
+
+	u32 sources = 0;
+	sources |= options.RecBlocks_EE ? (1u << static_cast<u32>(Source::EE)) : 0;
+	sources |= options.RecBlocks_IOP ? (1u << static_cast<u32>(Source::IOP)) : 0;
+	sources |= options.RecBlocks_VU0 ? (1u << static_cast<u32>(Source::VU0)) : 0;
+	sources |= options.RecBlocks_VU1 ? (1u << static_cast<u32>(Source::VU1)) : 0;
+	s_block_sources.store(sources, std::memory_order_release);
+
+	RegisterThread(SampledThread::CPU);
+
+	s_stop_sampling.store(false, std::memory_order_release);
+	const u32 sample_rate = options.SampleRate;
+	s_sampler_thread.Start([sample_rate]() { SamplerThreadEntryPoint(sample_rate); });
+
+	Console.WriteLn("GuestProfiler: Sampling at %u Hz.", sample_rate);
+}
+
+void GuestProfiler::Stop()
+{
+	if (!IsActive())
+		return;
+
+	s_stop_sampling.store(true, std::memory_order_release);
+	s_sampler_thread.Join();
+	s_block_sources.store(0, std::memory_order_release);
+
+	UnregisterThread(SampledThread::CPU);
+
+	if (s_total_samples > 0)
+		WriteReport();
+
+	s_samples = {};
+	s_total_samples = 0;
+
+	std::unique_lock lock(s_code_mutex);
+	s_code_map = {};
+}
+
+void GuestProfiler::RegisterThread(SampledThread thread)
+{
+	std::unique_lock lock(s_thread_mutex);
+	ThreadState& state = s_threads[static_cast<size_t>(thread)];
+	if (state.registered)
+		return;
+
+#if defined(_WIN32)
+	// The handle from ThreadHandle can't suspend or read the context, so we need our own.
+	state.handle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION, FALSE,
+		GetCurrentThreadId());
+	if (!state.handle)
+		return;
+#elif defined(__APPLE__)
+	state.port = mach_thread_self();
+#else
+	state.thread = pthread_self();
+#endif
+
+	state.registered = true;
+}
+
+void GuestProfiler::UnregisterThread(SampledThread thread)
+{
+	// Taking the lock also waits out any sample which is in flight for this thread.
+	std::unique_lock lock(s_thread_mutex);
+	ThreadState& state = s_threads[static_cast<size_t>(thread)];
+	if (!state.registered)
+		return;
+
+#if defined(_WIN32)
+	CloseHandle(state.handle);
+	state.handle = nullptr;
+#elif defined(__APPLE__)
+	mach_port_deallocate(mach_task_self(), state.port);
+	state.port = MACH_PORT_NULL;
+#endif
+
+	state.registered = false;
+}
+
+void GuestProfiler::RegisterBlock(Source source, const void* code, size_t size, u32 pc)
+{
+	if (!(s_block_sources.load(std::memory_order_relaxed) & (1u << static_cast<u32>(source))) || size == 0)
+		return;
+
+	const uptr start = reinterpret_cast<uptr>(code);
+	const uptr end = start + size;
+
+	std::unique_lock lock(s_code_mutex);
+
+	// Code buffers are reused after the caches are cleared, so throw away whatever used to live here.
+	auto it = s_code_map.lower_bound(start);
+	if (it != s_code_map.begin() && std::prev(it)->second.end > start)
+		--it;
+	while (it != s_code_map.end() && it->first < end)
+		it = s_code_map.erase(it);
+
+	s_code_map.emplace_hint(it, start, CodeBlock{end, pc, source});
+}
+
+void GuestProfiler::SamplerThreadEntryPoint(u32 sample_rate)
+{
+	Threading::SetNameOfCurrentThread("Guest Profiler");
+
+	const std::chrono::nanoseconds interval(1000000000u / sample_rate);
+	auto next_sample = std::chrono::steady_clock::now();
+
+	while (!s_stop_sampling.load(std::memory_order_acquire))
+	{
+		std::array<uptr, static_cast<size_t>(SampledThread::Count)> pcs;
+		std::array<bool, static_cast<size_t>(SampledThread::Count)> valid = {};
+		{
+			std::unique_lock lock(s_thread_mutex);
+			for (size_t i = 0; i < s_threads.size(); i++)
+				valid[i] = s_threads[i].registered && CapturePC(s_threads[i], &pcs[i]);
+		}
+
+		// Resolve outside the thread lock, so threads registering or leaving aren't held up.
+		for (size_t i = 0; i < pcs.size(); i++)
+		{
+			if (valid[i])
+				RecordSample(static_cast<SampledThread>(i), pcs[i]);
+		}
+
+		// Don't try to catch up if we fell behind, that'd just skew towards wherever we were slow.
+		next_sample = std::max(next_sample + interval, std::chrono::steady_clock::now());
+		std::this_thread::sleep_until(next_sample);
+	}
+}
+
+#if defined(_WIN32)
+
+bool GuestProfiler::CapturePC(ThreadState& state, uptr* pc)
+{
+	if (SuspendThread(state.handle) == static_cast<DWORD>(-1))
+		return false;
+
+	// Nothing in here can allocate or take locks, since the thread could be holding them.
+	CONTEXT context = {};
+	context.ContextFlags = CONTEXT_CONTROL;
+	const bool result = (GetThreadContext(state.handle, &context) != FALSE);
+	ResumeThread(state.handle);
+	if (!result)
+		return false;
+
+#if defined(_M_ARM64)
+	*pc = static_cast<uptr>(context.Pc);
+#else
+	*pc = static_cast<uptr>(context.Rip);
+#endif
+	return true;
+}
+
+#elif defined(__APPLE__)
+
+bool GuestProfiler::CapturePC(ThreadState& state, uptr* pc)
+{
+	if (thread_suspend(state.port) != KERN_SUCCESS)
+		return false;
+
+#if defined(_M_ARM64)
+	arm_thread_state64_t thread_state;
+	mach_msg_type_number_t count = ARM_THREAD_STATE64_COUNT;
+	const kern_return_t result =
+		thread_get_state(state.port, ARM_THREAD_STATE64, reinterpret_cast<thread_state_t>(&thread_state), &count);
+	thread_resume(state.port);
+	*pc = static_cast<uptr>(arm_thread_state64_get_pc(thread_state));
+#else
+	x86_thread_state64_t thread_state;
+	mach_msg_type_number_t count = x86_THREAD_STATE64_COUNT;
+	const kern_return_t result =
+		thread_get_state(state.port, x86_THREAD_STATE64, reinterpret_cast<thread_state_t>(&thread_state), &count);
+	thread_resume(state.port);
+	*pc = static_cast<uptr>(thread_state.__rip);
+#endif
+
+	return (result == KERN_SUCCESS);
+}
+
+#else
+
+bool GuestProfiler::InstallSignalHandler()
+{
+	// Never removed, a signal which is still in flight when we stop would otherwise kill the process.
+	static bool installed = false;
+	if (installed)
+		return true;
+
+	struct sigaction sa = {};
+	sa.sa_flags = SA_SIGINFO | SA_RESTART;
+	sa.sa_sigaction = SignalHandler;
+	sigemptyset(&sa.sa_mask);
+	installed = (sigaction(SIGPROF, &sa, nullptr) == 0);
+	return installed;
+}
+
+void GuestProfiler::SignalHandler(int sig, siginfo_t* info, void* ctx)
+{
+#if defined(__linux__) && defined(_M_X86)
+	const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__linux__) && defined(_M_ARM64)
+	const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.pc);
+#elif defined(__FreeBSD__) && defined(_M_X86)
+	const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.mc_rip);
+#else
+	const uptr pc = 0;
+#endif
+
+	const pthread_t self = pthread_self();
+	for (ThreadState& state : s_threads)
+	{
+		if (!pthread_equal(state.thread, self))
+			continue;
+
+		state.pc.store(pc, std::memory_order_relaxed);
+		state.reply.store(state.request.load(std::memory_order_relaxed), std::memory_order_release);
+		break;
+	}
+}
+
+bool GuestProfiler::CapturePC(ThreadState& state, uptr* pc)
+{
+	const u32 request = state.request.load(std::memory_order_relaxed) + 1;
+	state.request.store(request, std::memory_order_relaxed);
+	if (pthread_kill(state.thread, SIGPROF) != 0)
+		return false;
+
+	// Signals are usually delivered within a few microseconds. If the thread is stuck in the kernel for
+	// longer than this, the sample is dropped, and a late reply is ignored since the sequence won't match.
+	const auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+	while (state.reply.load(std::memory_order_acquire) != request)
+	{
+		if (std::chrono::steady_clock::now() >= timeout)
+			return false;
+
+		std::this_thread::yield();
+	}
+
+	*pc = state.pc.load(std::memory_order_relaxed);
+	return (*pc != 0);
+}
+
+#endif
+
+void GuestProfiler::RecordSample(SampledThread thread, uptr pc)
+{
+	u64 key = 0;
+	bool in_block = false;
+	{
+		std::unique_lock lock(s_code_mutex);
+		auto it = s_code_map.upper_bound(pc);
+		if (it != s_code_map.begin() && pc < (--it)->second.end)
+		{
+			key = MakeSampleKey(thread, SampleKind::Block, it->second.source, it->second.pc);
+			in_block = true;
+		}
+	}
+
+	if (!in_block)
+	{
+		// Not in a block we know of. Code in the recompiler buffers is the dispatchers, or stubs.
+		const u8* ptr = reinterpret_cast<const u8*>(pc);
+		const auto in_range = [ptr](const u8* start, const u8* end) { return (ptr >= start && ptr < end); };
+		if (in_range(SysMemory::GetEERec(), SysMemory::GetEERecEnd()))
+			key = MakeSampleKey(thread, SampleKind::Dispatcher, Source::EE, 0);
+		else if (in_range(SysMemory::GetIOPRec(), SysMemory::GetIOPRecEnd()))
+			key = MakeSampleKey(thread, SampleKind::Dispatcher, Source::IOP, 0);
+		else if (in_range(SysMemory::GetVU0Rec(), SysMemory::GetVU0RecEnd()))
+			key = MakeSampleKey(thread, SampleKind::Dispatcher, Source::VU0, 0);
+		else if (in_range(SysMemory::GetVU1Rec(), SysMemory::GetVU1RecEnd()))
+			key = MakeSampleKey(thread, SampleKind::Dispatcher, Source::VU1, 0);
+		else if (in_range(SysMemory::GetVIFUnpackRec(), SysMemory::GetVIFUnpackRecEnd()))
+			key = MakeSampleKey(thread, SampleKind::VifUnpack, Source::Count, 0);
+		else
+			key = MakeSampleKey(thread, SampleKind::Native, Source::Count, 0);
+	}
+
+	s_samples[key]++;
+	s_total_samples++;
+}
+
+void GuestProfiler::WriteReport()
+{
+	// Folded stack format is "frame;frame;frame count", so keep separators out of the frames.
+	const auto sanitize = [](std::string name) {
+		std::replace(name.begin(), name.end(), ';', ':');
+		return name;
+	};
+
+	std::map<std::string, u64> stacks;
+	std::unordered_map<std::string, u64> functions;
+	for (const auto& [key, count] : s_samples)
+	{
+		const SampledThread thread = static_cast<SampledThread>(key >> 48);
+		const SampleKind kind = static_cast<SampleKind>((key >> 40) & 0xFF);
+		const Source source = static_cast<Source>((key >> 32) & 0xFF);
+		const u32 pc = static_cast<u32>(key);
+
+		std::string function;
+		std::string leaf;
+		switch (kind)
+		{
+			case SampleKind::Block:
+			{
+				function = s_source_names[static_cast<u32>(source)];
+				if (source == Source::EE || source == Source::IOP)
+				{
+					const SymbolGuardian& guardian = (source == Source::EE) ? R5900SymbolGuardian : R3000SymbolGuardian;
+					const FunctionInfo info = guardian.FunctionOverlappingAddress(pc);
+					function += ';';
+					function += info.name.empty() ? std::string("[unknown]") : sanitize(info.name);
+				}
+				leaf = fmt::format(";0x{:08x}", pc);
+			}
+			break;
+
+			case SampleKind::Dispatcher:
+				function = fmt::format("{};[dispatcher]", s_source_names[static_cast<u32>(source)]);
+				break;
+
+			case SampleKind::VifUnpack:
+				function = "[vif unpack]";
+				break;
+
+			case SampleKind::Native:
+			default:
+				function = "[native]";
+				break;
+		}
+
+		functions[function] += count;
+		stacks[fmt::format("{};{}{}", s_thread_names[static_cast<u32>(thread)], function, leaf)] += count;
+	}
+
+	std::string serial = VMManager::GetDiscSerial();
+	Path::SanitizeFileName(&serial);
+	char local_time[16];
+	const time_t cur_time = time(nullptr);
+	if (!strftime(local_time, sizeof(local_time), "%Y%m%d%H%M%S", localtime(&cur_time)))
+		local_time[0] = '\0';
+
+	const std::string filename = Path::Combine(EmuFolders::Logs,
+		fmt::format("guest_profile_{}_{}.folded", serial.empty() ? std::string("unknown") : serial, local_time));
+
+	std::string report;
+	for (const auto& [stack, count] : stacks)
+		fmt::format_to(std::back_inserter(report), "{} {}\n", stack, count);
+
+	if (FileSystem::WriteStringToFile(filename.c_str(), report))
+		Console.WriteLn("GuestProfiler: Wrote %llu samples to %s", s_total_samples, filename.c_str());
+	else
+		Console.Error("GuestProfiler: Failed to write %s", filename.c_str());
+
+	std::vector<std::pair<std::string, u64>> sorted(functions.begin(), functions.end());
+	std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return (lhs.second > rhs.second); });
+	const size_t count = std::min<size_t>(sorted.size(), 15);
+	for (size_t i = 0; i < count; i++)
+	{
+		Console.WriteLn("  %5.1f%%  %s", (static_cast<double>(sorted[i].second) * 100.0) / static_cast<double>(s_total_samples),
+			sorted[i].first.c_str());
+	}
+}
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+#include "Config.h"
+
+/// Sampling profiler for recompiled guest code. A background thread periodically grabs the host program
+/// counter of the emulation threads, and maps it back to the guest block (and from there, guest function)
+/// which the recompilers generated that code for. When stopped, the samples are written to the logs
+/// folder as folded stacks, which flamegraph.pl, speedscope and friends can read directly.
+namespace GuestProfiler
+{
+	enum class Source : u8
+	{
+		EE,
+		IOP,
+		VU0,
+		VU1,
+		Count
+	};
+
+	/// Threads which can be sampled. Each one registers itself, so the profiler can get at its context.
+	enum class SampledThread : u8
+	{
+		CPU,
+		MTVU,
+		Count
+	};
+
+	bool IsActive();
+
+	/// Starts sampling, with the calling thread as the CPU thread. The recompilers only tell us about blocks
+	/// as they're compiled, so the execution caches should be cleared afterwards.
+	void Start(const Pcsx2Config::ProfilerOptions& options);
+
+	/// Stops sampling, and writes out the report if anything was collected.
+	void Stop();
+
+	/// Makes the calling thread available for sampling. Cheap enough to do unconditionally.
+	void RegisterThread(SampledThread thread);
+	void UnregisterThread(SampledThread thread);
+
+	/// Records the guest PC which a block of recompiled code was generated for. Does nothing when the
+	/// profiler isn't running, or blocks for this source weren't requested.
+	void RegisterBlock(Source source, const void* code, size_t size, u32 pc);
+} // namespace GuestProfiler
@@ -529,6 +529,9 @@ void GSGameChanged()
 	if (GSIsHardwareRenderer())
 		GSTextureReplacements::GameChanged();
 
+	if (g_gs_renderer)
+		g_gs_renderer->GameChanged();
+
 	if (!VMManager::HasValidVM() && GSCapture::IsCapturing())
 		GSCapture::EndCapture();
 }
@@ -703,10 +706,11 @@ void GSgetStats(SmallStringBase& info)
 	}
 	else
 	{
-		info.format("{} HW | {} P | {} D | {} DC | {} B | {} RP | {} RB | {} TC | {} TU",
+		info.format("{} HW | {} P | {} D | {} M | {} DC | {} B | {} RP | {} RB | {} TC | {} TU",
 			api_name,
 			(int)pm.Get(GSPerfMon::Prim),
 			(int)pm.Get(GSPerfMon::Draw),
+			(int)pm.Get(GSPerfMon::DrawsMerged),
 			(int)std::ceil(pm.Get(GSPerfMon::DrawCalls)),
 			(int)std::ceil(pm.Get(GSPerfMon::Barriers)),
 			(int)std::ceil(pm.Get(GSPerfMon::RenderPasses)),
@@ -19,11 +19,14 @@
 #include "common/SmallString.h"
 #include "common/StringUtil.h"
 #include "common/Threading.h"
+#include "common/Timer.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include <thread>
 
 // We're using deprecated fields because we're targeting multiple ffmpeg versions.
 #if defined(_MSC_VER)
@@ -140,6 +143,9 @@ namespace GSCapture
 	static constexpr u32 AUDIO_BUFFER_SIZE = Common::AlignUpPow2((MAX_PENDING_FRAMES * 48000) / 60, AudioStream::CHUNK_SIZE);
 	static constexpr u32 AUDIO_CHANNELS = 2;
 
+	/// Maximum number of threads which convert a frame's rows to YUV, including the encoder thread.
+	static constexpr u32 MAX_CONVERT_THREADS = 4;
+
 	struct PendingFrame
 	{
 		enum class State
@@ -151,6 +157,7 @@ namespace GSCapture
 
 		std::unique_ptr<GSDownloadTexture> tex;
 		s64 pts;
+		Common::Timer::Value deliver_time;
 		State state;
 	};
 
@@ -165,6 +172,13 @@ namespace GSCapture
 	static void StartEncoderThread();
 	static void StopEncoderThread(std::unique_lock<std::mutex>& lock);
 	static bool SendFrame(const PendingFrame& pf);
+	static bool CanConvertFrame(const PendingFrame& pf);
+	static void ConvertFrame(const PendingFrame& pf);
+	static void ConvertRows(u32 start_row, u32 end_row);
+	static void ConvertThreadEntryPoint(u32 index, u32 generation);
+	static void StartConvertThreads();
+	static void StopConvertThreads();
+	static void ReportFrameStatistics();
 	static bool ReceivePackets(AVCodecContext* codec_context, AVStream* stream, AVPacket* packet);
 	static bool ProcessAudioPackets(s64 video_pts);
 	static void InternalEndCapture(std::unique_lock<std::mutex>& lock);
@@ -211,6 +225,23 @@ namespace GSCapture
 	static u32 s_frames_pending_encode = 0;
 	static u32 s_frames_encode_consume_pos = 0;
 
+	/// Frames dropped because the encoder couldn't keep up, and the time between delivery and encoding finishing.
+	static u32 s_frames_encoded = 0;
+	static u32 s_frames_dropped = 0;
+	static Common::Timer::Value s_total_frame_latency = 0;
+	static Common::Timer::Value s_max_frame_latency = 0;
+
+	/// RGBA to YUV conversion, split into bands of rows. Band 0 runs on the encoder thread.
+	static std::array<Threading::Thread, MAX_CONVERT_THREADS - 1> s_convert_threads;
+	static std::mutex s_convert_lock;
+	static std::condition_variable s_convert_start_cv;
+	static std::condition_variable s_convert_done_cv;
+	static u32 s_num_convert_threads = 1;
+	static u32 s_convert_generation = 0;
+	static u32 s_convert_bands_remaining = 0;
+	static bool s_convert_threads_running = false;
+	static const PendingFrame* s_convert_frame = nullptr;
+
 	// NOTE: So this doesn't need locking, we allocate it once, and leave it.
 	static std::unique_ptr<s16[]> s_audio_buffer;
 	static std::atomic<u32> s_audio_buffer_size{0};
@@ -863,11 +894,14 @@ bool GSCapture::DeliverVideoFrame(GSTexture* stex)
 
 	PendingFrame& pf = s_pending_frames[s_pending_frames_pos];
 
-	// It shouldn't be pending map, but the encode thread might be lagging.
+	// It shouldn't be pending map, but the encode thread might be lagging. Rather than stalling the GS thread
+	// until it catches up, skip the frame. The PTS still advances, so the previous frame is held for longer.
 	pxAssert(pf.state != PendingFrame::State::NeedsMap);
 	if (pf.state == PendingFrame::State::NeedsEncoding)
 	{
-		s_frame_encoded_cv.wait(lock, [&pf]() { return pf.state == PendingFrame::State::Unused; });
+		s_next_video_pts++;
+		s_frames_dropped++;
+		return true;
 	}
 
 	if (!pf.tex || pf.tex->GetWidth() != static_cast<u32>(stex->GetWidth()) || pf.tex->GetHeight() != static_cast<u32>(stex->GetHeight()))
@@ -888,6 +922,7 @@ bool GSCapture::DeliverVideoFrame(GSTexture* stex)
 	const GSVector4i rc(0, 0, stex->GetWidth(), stex->GetHeight());
 	pf.tex->CopyFromTexture(rc, stex, rc, 0);
 	pf.pts = s_next_video_pts++;
+	pf.deliver_time = Common::Timer::GetCurrentValue();
 	pf.state = PendingFrame::State::NeedsMap;
 
 	s_pending_frames_pos = (s_pending_frames_pos + 1) % MAX_PENDING_FRAMES;
@@ -944,7 +979,8 @@ void GSCapture::EncoderThreadEntryPoint()
 		bool okay = !s_encoding_error;
 
 		// If the frame failed to map, this will be false, and we'll just skip it.
-		if (okay && s_video_stream && pf.tex->IsMapped())
+		const bool has_video = (s_video_stream && pf.tex && pf.tex->IsMapped());
+		if (okay && has_video)
 			okay = SendFrame(pf);
 
 		// Encode as many audio frames while the video is ahead.
@@ -957,6 +993,14 @@ void GSCapture::EncoderThreadEntryPoint()
 		if (!okay)
 			s_encoding_error = true;
 
+		if (has_video)
+		{
+			const Common::Timer::Value latency = Common::Timer::GetCurrentValue() - pf.deliver_time;
+			s_total_frame_latency += latency;
+			s_max_frame_latency = std::max(s_max_frame_latency, latency);
+			s_frames_encoded++;
+		}
+
 		// Done with this frame! Wait for the next.
 		pf.state = PendingFrame::State::Unused;
 		s_frames_encode_consume_pos = (s_frames_encode_consume_pos + 1) % MAX_PENDING_FRAMES;
@@ -969,6 +1013,8 @@ void GSCapture::StartEncoderThread()
 {
 	Console.WriteLn("GSCapture: Starting encoder thread.");
 	pxAssert(s_capturing.load(std::memory_order_acquire) && !s_encoder_thread.Joinable());
+	if (s_video_stream)
+		StartConvertThreads();
 	s_encoder_thread.Start(EncoderThreadEntryPoint);
 }
 
@@ -987,6 +1033,200 @@ void GSCapture::StopEncoderThread(std::unique_lock<std::mutex>& lock)
 		s_encoder_thread.Join();
 		lock.lock();
 	}
+
+	StopConvertThreads();
+}
+
+void GSCapture::StartConvertThreads()
+{
+	// Leave plenty of cores for the EE/GS threads, conversion is only a few milliseconds per frame.
+	s_num_convert_threads = std::clamp(std::thread::hardware_concurrency() / 4, 1u, MAX_CONVERT_THREADS);
+	s_convert_threads_running = true;
+	// Threads could start after the first frame is submitted, so they need to know where they started.
+	const u32 generation = s_convert_generation;
+	for (u32 i = 1; i < s_num_convert_threads; i++)
+		s_convert_threads[i - 1].Start([i, generation]() { ConvertThreadEntryPoint(i, generation); });
+}
+
+void GSCapture::StopConvertThreads()
+{
+	{
+		std::unique_lock<std::mutex> lock(s_convert_lock);
+		s_convert_threads_running = false;
+		s_convert_start_cv.notify_all();
+	}
+
+	for (Threading::Thread& thread : s_convert_threads)
+	{
+		if (thread.Joinable())
+			thread.Join();
+	}
+
+	s_num_convert_threads = 1;
+}
+
+void GSCapture::ConvertThreadEntryPoint(u32 index, u32 generation)
+{
+	Threading::SetNameOfCurrentThread("GS Capture Conversion");
+
+	std::unique_lock<std::mutex> lock(s_convert_lock);
+	u32 last_generation = generation;
+	for (;;)
+	{
+		s_convert_start_cv.wait(lock, [last_generation]() { return (s_convert_generation != last_generation || !s_convert_threads_running); });
+		if (!s_convert_threads_running)
+			break;
+
+		last_generation = s_convert_generation;
+		lock.unlock();
+
+		const u32 height = static_cast<u32>(s_converted_video_frame->height);
+		const u32 band_rows = Common::AlignUpPow2((height + s_num_convert_threads - 1) / s_num_convert_threads, 2);
+		ConvertRows(std::min(band_rows * index, height), std::min(band_rows * (index + 1), height));
+
+		lock.lock();
+		if ((--s_convert_bands_remaining) == 0)
+			s_convert_done_cv.notify_one();
+	}
+}
+
+bool GSCapture::CanConvertFrame(const PendingFrame& pf)
+{
+	// Scaling and other formats go through swscale.
+	const AVPixelFormat format = static_cast<AVPixelFormat>(s_converted_video_frame->format);
+	return ((format == AV_PIX_FMT_YUV420P || format == AV_PIX_FMT_NV12) && pf.tex->GetFormat() == GSTexture::Format::Color &&
+			pf.tex->GetWidth() == static_cast<u32>(s_converted_video_frame->width) &&
+			pf.tex->GetHeight() == static_cast<u32>(s_converted_video_frame->height));
+}
+
+void GSCapture::ConvertFrame(const PendingFrame& pf)
+{
+	if (s_num_convert_threads == 1)
+	{
+		s_convert_frame = &pf;
+		ConvertRows(0, static_cast<u32>(s_converted_video_frame->height));
+		s_convert_frame = nullptr;
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(s_convert_lock);
+		s_convert_frame = &pf;
+		s_convert_bands_remaining = s_num_convert_threads - 1;
+		s_convert_generation++;
+		s_convert_start_cv.notify_all();
+	}
+
+	const u32 height = static_cast<u32>(s_converted_video_frame->height);
+	const u32 band_rows = Common::AlignUpPow2((height + s_num_convert_threads - 1) / s_num_convert_threads, 2);
+	ConvertRows(0, std::min(band_rows, height));
+
+	std::unique_lock<std::mutex> lock(s_convert_lock);
+	s_convert_done_cv.wait(lock, []() { return (s_convert_bands_remaining == 0); });
+	s_convert_frame = nullptr;
+}
+
+void GSCapture::ConvertRows(u32 start_row, u32 end_row)
+{
+	// BT.601 limited range, same as swscale's default for RGB to YUV. Chroma is the average of each 2x2 block.
+	// All the intermediate values fit in 16 bits: luma is unsigned up to 56100, chroma is signed up to +/-28560.
+	const u8* src_base = s_convert_frame->tex->GetMapPointer();
+	const u32 src_pitch = s_convert_frame->tex->GetMapPitch();
+	const u32 width = static_cast<u32>(s_converted_video_frame->width);
+	const u32 height = static_cast<u32>(s_converted_video_frame->height);
+	const bool nv12 = (s_converted_video_frame->format == AV_PIX_FMT_NV12);
+	u8* const* dst = s_converted_video_frame->data;
+	const int* dst_pitch = s_converted_video_frame->linesize;
+
+	const GSVector4i mask = GSVector4i::x000000ff();
+	const auto coeff = [](s16 value) { return GSVector4i::broadcast16(static_cast<u16>(value)); };
+	const GSVector4i yr = coeff(66), yg = coeff(129), yb = coeff(25);
+	const GSVector4i ur = coeff(-38), ug = coeff(-74), ub = coeff(112);
+	const GSVector4i vr = coeff(112), vg = coeff(-94), vb = coeff(-18);
+	const GSVector4i round = coeff(128), yoffset = coeff(16), two = coeff(2);
+
+	const auto split = [&mask](const u8* ptr, GSVector4i& r, GSVector4i& g, GSVector4i& b) {
+		const GSVector4i p0 = GSVector4i::load<false>(ptr);
+		const GSVector4i p1 = GSVector4i::load<false>(ptr + 16);
+		r = (p0 & mask).pu32(p1 & mask);
+		g = (p0.srl32<8>() & mask).pu32(p1.srl32<8>() & mask);
+		b = (p0.srl32<16>() & mask).pu32(p1.srl32<16>() & mask);
+	};
+	const auto luma = [&](const GSVector4i& r, const GSVector4i& g, const GSVector4i& b) {
+		const GSVector4i y = r.mul16l(yr).add16(g.mul16l(yg)).add16(b.mul16l(yb)).add16(round).srl16<8>().add16(yoffset);
+		return y.pu16(y);
+	};
+	const auto scalar_y = [](u32 r, u32 g, u32 b) { return static_cast<u8>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16); };
+	const auto scalar_u = [](s32 r, s32 g, s32 b) { return static_cast<u8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128); };
+	const auto scalar_v = [](s32 r, s32 g, s32 b) { return static_cast<u8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128); };
+
+	for (u32 row = start_row; row < end_row; row += 2)
+	{
+		// Odd heights repeat the last row for chroma.
+		const u8* src0 = src_base + row * src_pitch;
+		const u8* src1 = (row + 1 < height) ? (src0 + src_pitch) : src0;
+		u8* y0 = dst[0] + row * dst_pitch[0];
+		u8* y1 = (row + 1 < height) ? (y0 + dst_pitch[0]) : y0;
+		u8* u = dst[1] + (row / 2) * dst_pitch[1];
+		u8* v = nv12 ? nullptr : (dst[2] + (row / 2) * dst_pitch[2]);
+
+		u32 x = 0;
+		for (; (x + 8) <= width; x += 8)
+		{
+			GSVector4i r0, g0, b0, r1, g1, b1;
+			split(src0 + x * 4, r0, g0, b0);
+			split(src1 + x * 4, r1, g1, b1);
+			GSVector4i::storel(y0 + x, luma(r0, g0, b0));
+			GSVector4i::storel(y1 + x, luma(r1, g1, b1));
+
+			// Sum each 2x2 block, leaving four averages in the low half.
+			const auto average = [&two](const GSVector4i& c0, const GSVector4i& c1) {
+				const GSVector4i sum = c0.add16(c1);
+				const GSVector4i pairs = sum.add16(sum.srl32<16>()) & GSVector4i::x0000ffff();
+				return pairs.pu32(pairs).add16(two).srl16<2>();
+			};
+			const GSVector4i r = average(r0, r1), g = average(g0, g1), b = average(b0, b1);
+			const GSVector4i cu = r.mul16l(ur).add16(g.mul16l(ug)).add16(b.mul16l(ub)).add16(round).sra16<8>().add16(round);
+			const GSVector4i cv = r.mul16l(vr).add16(g.mul16l(vg)).add16(b.mul16l(vb)).add16(round).sra16<8>().add16(round);
+			if (nv12)
+			{
+				const GSVector4i uv = cu.upl16(cv);
+				GSVector4i::storel(u + x, uv.pu16(uv));
+			}
+			else
+			{
+				const u32 cu8 = static_cast<u32>(cu.pu16(cu).extract32<0>());
+				const u32 cv8 = static_cast<u32>(cv.pu16(cv).extract32<0>());
+				std::memcpy(u + x / 2, &cu8, sizeof(cu8));
+				std::memcpy(v + x / 2, &cv8, sizeof(cv8));
+			}
+		}
+
+		for (; x < width; x += 2)
+		{
+			// Odd widths repeat the last column for chroma.
+			const u32 x1 = std::min(x + 1, width - 1);
+			const u8* p[4] = {src0 + x * 4, src0 + x1 * 4, src1 + x * 4, src1 + x1 * 4};
+			y0[x] = scalar_y(p[0][0], p[0][1], p[0][2]);
+			y0[x1] = scalar_y(p[1][0], p[1][1], p[1][2]);
+			y1[x] = scalar_y(p[2][0], p[2][1], p[2][2]);
+			y1[x1] = scalar_y(p[3][0], p[3][1], p[3][2]);
+
+			const s32 r = (p[0][0] + p[1][0] + p[2][0] + p[3][0] + 2) >> 2;
+			const s32 g = (p[0][1] + p[1][1] + p[2][1] + p[3][1] + 2) >> 2;
+			const s32 b = (p[0][2] + p[1][2] + p[2][2] + p[3][2] + 2) >> 2;
+			if (nv12)
+			{
+				u[x] = scalar_u(r, g, b);
+				u[x + 1] = scalar_v(r, g, b);
+			}
+			else
+			{
+				u[x / 2] = scalar_u(r, g, b);
+				v[x / 2] = scalar_v(r, g, b);
+			}
+		}
+	}
 }
 
 bool GSCapture::SendFrame(const PendingFrame& pf)
@@ -1000,16 +1240,24 @@ bool GSCapture::SendFrame(const PendingFrame& pf)
 	// In case a previous frame is still using the frame.
 	wrap_av_frame_make_writable(s_converted_video_frame);
 
-	s_sws_context = wrap_sws_getCachedContext(s_sws_context, source_width, source_height, source_format, s_converted_video_frame->width,
-		s_converted_video_frame->height, static_cast<AVPixelFormat>(s_converted_video_frame->format), SWS_BICUBIC, nullptr, nullptr, nullptr);
-	if (!s_sws_context)
+	if (CanConvertFrame(pf))
 	{
-		Console.Error("sws_getCachedContext() failed");
-		return false;
+		// Straight out of the mapped readback, no intermediate copy.
+		ConvertFrame(pf);
 	}
+	else
+	{
+		s_sws_context = wrap_sws_getCachedContext(s_sws_context, source_width, source_height, source_format, s_converted_video_frame->width,
+			s_converted_video_frame->height, static_cast<AVPixelFormat>(s_converted_video_frame->format), SWS_BICUBIC, nullptr, nullptr, nullptr);
+		if (!s_sws_context)
+		{
+			Console.Error("sws_getCachedContext() failed");
+			return false;
+		}
 
-	wrap_sws_scale(s_sws_context, reinterpret_cast<const u8**>(&source_ptr), &source_pitch, 0, source_height, s_converted_video_frame->data,
-		s_converted_video_frame->linesize);
+		wrap_sws_scale(s_sws_context, reinterpret_cast<const u8**>(&source_ptr), &source_pitch, 0, source_height, s_converted_video_frame->data,
+			s_converted_video_frame->linesize);
+	}
 
 	AVFrame* frame_to_send = s_converted_video_frame;
 	if (IsUsingHardwareVideoEncoding())
@@ -1262,6 +1510,7 @@ void GSCapture::InternalEndCapture(std::unique_lock<std::mutex>& lock)
 
 		s_capturing.store(false, std::memory_order_release);
 		StopEncoderThread(lock);
+		ReportFrameStatistics();
 
 		s_pending_frames = {};
 		s_pending_frames_pos = 0;
@@ -1352,6 +1601,29 @@ void GSCapture::InternalEndCapture(std::unique_lock<std::mutex>& lock)
 		UnloadFFmpeg();
 }
 
+void GSCapture::ReportFrameStatistics()
+{
+	if (s_frames_encoded > 0 || s_frames_dropped > 0)
+	{
+		const double avg_latency = (s_frames_encoded > 0) ?
+			(Common::Timer::ConvertValueToMilliseconds(s_total_frame_latency) / static_cast<double>(s_frames_encoded)) : 0.0;
+		Console.WriteLn(fmt::format("GSCapture: Encoded {} frames, dropped {}. Latency: avg {:.2f} ms, max {:.2f} ms.", s_frames_encoded,
+			s_frames_dropped, avg_latency, Common::Timer::ConvertValueToMilliseconds(s_max_frame_latency)));
+
+		if (s_frames_dropped > 0)
+		{
+			Host::AddIconOSDMessage("GSCaptureDroppedFrames", ICON_FA_TRIANGLE_EXCLAMATION,
+				fmt::format(TRANSLATE_FS("GSCapture", "{} frames were dropped because encoding could not keep up."), s_frames_dropped),
+				Host::OSD_WARNING_DURATION);
+		}
+	}
+
+	s_frames_encoded = 0;
+	s_frames_dropped = 0;
+	s_total_frame_latency = 0;
+	s_max_frame_latency = 0;
+}
+
 void GSCapture::EndCapture()
 {
 	{
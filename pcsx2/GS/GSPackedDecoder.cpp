@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GS/GSPackedDecoder.h"
+#include "GS/GSState.h"
+
+#include "Memory.h"
+
+#include "common/Console.h"
+#include "common/HostSys.h"
+
+// Xbyak pulls in windows.h, and breaks everything.
+#ifdef _WIN32
+#include "common/RedtapeWindows.h"
+#endif
+
+#define XBYAK_NO_OP_NAMES
+#define XBYAK_ENABLE_OMITTED_OPERAND
+
+#include "xbyak/xbyak.h"
+
+#include <unordered_map>
+
+namespace GSPackedDecoder
+{
+	namespace
+	{
+		class CodeGenerator : public Xbyak::CodeGenerator
+		{
+		public:
+			CodeGenerator(void* code, size_t maxsize)
+				: Xbyak::CodeGenerator(maxsize, code)
+			{
+			}
+
+			void Generate(const GSVector4i& regs, u32 nreg);
+		};
+	} // namespace
+
+	static u8* s_memory_base;
+	static u8* s_memory_end;
+	static u8* s_memory_ptr;
+
+	static std::unordered_map<u64, DecodeFunc> s_decoders[16];
+
+	// Tags usually repeat the same layout back to back.
+	static GSVector4i s_last_regs;
+	static u32 s_last_nreg;
+	static DecodeFunc s_last_decoder;
+
+	/// Largest decoder is 16 calls, which comes out at a few hundred bytes.
+	static constexpr size_t MAX_SIZE = 1024;
+
+	static DecodeFunc Compile(const GSVector4i& regs, u32 nreg);
+} // namespace GSPackedDecoder
+
+void GSPackedDecoder::CodeGenerator::Generate(const GSVector4i& regs, u32 nreg)
+{
+	using namespace Xbyak::util;
+
+#ifdef _WIN32
+	const Xbyak::Reg64 arg0 = rcx, arg1 = rdx, arg2 = r8;
+	static constexpr int SHADOW_SPACE = 32;
+#else
+	const Xbyak::Reg64 arg0 = rdi, arg1 = rsi, arg2 = rdx;
+	static constexpr int SHADOW_SPACE = 0;
+#endif
+
+	// rbx = state, r12 = registers for this loop, r13 = loops remaining.
+	// Three pushes on top of the return address leaves the stack aligned for the calls.
+	push(rbx);
+	push(r12);
+	push(r13);
+	if (SHADOW_SPACE > 0)
+		sub(rsp, SHADOW_SPACE);
+
+	mov(rbx, arg0);
+	mov(r12, arg1);
+	mov(r13d, arg2.cvt32());
+
+	Xbyak::Label loop;
+	L(loop);
+
+	for (u32 i = 0; i < nreg; i++)
+	{
+		const RegFunc func = GSState::GetPackedRegFunc(regs.U8[i]);
+		if (!func)
+			continue;
+
+		mov(arg0, rbx);
+		lea(arg1, ptr[r12 + i * sizeof(GIFPackedReg)]);
+		mov(rax, reinterpret_cast<size_t>(func));
+		call(rax);
+	}
+
+	add(r12, nreg * sizeof(GIFPackedReg));
+	dec(r13d);
+	jnz(loop, T_NEAR);
+
+	if (SHADOW_SPACE > 0)
+		add(rsp, SHADOW_SPACE);
+	pop(r13);
+	pop(r12);
+	pop(rbx);
+	ret();
+}
+
+GSPackedDecoder::DecodeFunc GSPackedDecoder::Compile(const GSVector4i& regs, u32 nreg)
+{
+	if (!s_memory_base)
+		Reset();
+
+	if (static_cast<size_t>(s_memory_end - s_memory_ptr) < MAX_SIZE)
+	{
+		DevCon.WriteLn("GS: Packed decoder cache full, flushing.");
+		Reset();
+	}
+
+	HostSys::BeginCodeWrite();
+
+	CodeGenerator cg(s_memory_ptr, MAX_SIZE);
+	cg.Generate(regs, nreg);
+
+	const u32 size = static_cast<u32>(cg.getSize());
+	u8* code = s_memory_ptr;
+	s_memory_ptr += size;
+
+	HostSys::EndCodeWrite();
+	HostSys::FlushInstructionCache(code, size);
+
+	return reinterpret_cast<DecodeFunc>(code);
+}
+
+GSPackedDecoder::DecodeFunc GSPackedDecoder::Get(const GSVector4i& regs, u32 nreg)
+{
+	pxAssert(nreg > 0 && nreg <= 16);
+
+	if (s_last_decoder && nreg == s_last_nreg && regs.eq(s_last_regs))
+		return s_last_decoder;
+
+	u64 key = 0;
+	for (u32 i = 0; i < nreg; i++)
+		key |= static_cast<u64>(regs.U8[i]) << (i * 4);
+
+	std::unordered_map<u64, DecodeFunc>& map = s_decoders[nreg - 1];
+	auto it = map.find(key);
+	if (it == map.end())
+		it = map.emplace(key, Compile(regs, nreg)).first;
+
+	s_last_regs = regs;
+	s_last_nreg = nreg;
+	s_last_decoder = it->second;
+	return it->second;
+}
+
+void GSPackedDecoder::Reset()
+{
+	s_memory_base = SysMemory::GetGSPackedRec();
+	s_memory_end = SysMemory::GetGSPackedRecEnd();
+	s_memory_ptr = s_memory_base;
+
+	for (std::unordered_map<u64, DecodeFunc>& map : s_decoders)
+		map.clear();
+
+	s_last_decoder = nullptr;
+}
@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/GSRegs.h"
+
+class GSState;
+
+// --------------------------------------------------------------------------------------
+//  GSPackedDecoder
+// --------------------------------------------------------------------------------------
+// Generates a loop for each distinct NREG/REGS layout of PACKED GIFtags, which runs every
+// register of the tag through a direct call instead of going through the handler table.
+//
+namespace GSPackedDecoder
+{
+	using DecodeFunc = void (*)(GSState* state, const GIFPackedReg* mem, u32 nloop);
+
+	/// Signature of the functions generated code calls for each register.
+	using RegFunc = void (*)(GSState* state, const GIFPackedReg* r);
+
+	/// Returns the decoder for the layout, generating it if it hasn't been seen before.
+	/// regs is the unpacked register list from GIFPath, with everything past nreg zeroed.
+	DecodeFunc Get(const GSVector4i& regs, u32 nreg);
+
+	/// Throws away all generated decoders.
+	void Reset();
+} // namespace GSPackedDecoder
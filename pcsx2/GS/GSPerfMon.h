@@ -14,6 +14,7 @@ public:
 	{
 		Prim,
 		Draw,
+		DrawsMerged,
 		DrawCalls,
 		Readbacks,
 		Swizzle,
@@ -124,6 +124,10 @@ GSState::GSState()
 	Reset(false);
 
 	ResetHandlers();
+
+#ifdef _M_X86
+	GSPackedDecoder::Reset();
+#endif
 }
 
 GSState::~GSState()
@@ -549,6 +553,8 @@ __inline void GSState::CheckFlushes()
 	{
 		if (TestDrawChanged())
 			Flush(GSFlushReason::CONTEXTCHANGE);
+		else
+			g_perfmon.Put(GSPerfMon::DrawsMerged, 1);
 	}
 }
 
@@ -656,6 +662,46 @@ void GSState::GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r)
 {
 }
 
+template <u32 reg>
+void GSState::GIFPackedRegThunk(GSState* state, const GIFPackedReg* RESTRICT r)
+{
+	// Handlers which don't depend on PRIM or settings can be called directly, the rest go through the table.
+	if constexpr (reg == GIF_REG_RGBA)
+		state->GIFPackedRegHandlerRGBA(r);
+	else if constexpr (reg == GIF_REG_STQ)
+		state->GIFPackedRegHandlerSTQ(r);
+	else if constexpr (reg == GIF_REG_FOG)
+		state->GIFPackedRegHandlerFOG(r);
+	else if constexpr (reg == GIF_REG_A_D)
+		state->GIFPackedRegHandlerA_D(r);
+	else
+		(state->*state->m_fpGIFPackedRegHandlers[reg])(r);
+}
+
+GSPackedDecoder::RegFunc GSState::GetPackedRegFunc(u32 reg)
+{
+	static constexpr GSPackedDecoder::RegFunc funcs[16] = {
+		&GSState::GIFPackedRegThunk<GIF_REG_PRIM>,
+		&GSState::GIFPackedRegThunk<GIF_REG_RGBA>,
+		&GSState::GIFPackedRegThunk<GIF_REG_STQ>,
+		&GSState::GIFPackedRegThunk<GIF_REG_UV>,
+		&GSState::GIFPackedRegThunk<GIF_REG_XYZF2>,
+		&GSState::GIFPackedRegThunk<GIF_REG_XYZ2>,
+		&GSState::GIFPackedRegThunk<GIF_REG_TEX0_1>,
+		&GSState::GIFPackedRegThunk<GIF_REG_TEX0_2>,
+		&GSState::GIFPackedRegThunk<GIF_REG_CLAMP_1>,
+		&GSState::GIFPackedRegThunk<GIF_REG_CLAMP_2>,
+		&GSState::GIFPackedRegThunk<GIF_REG_FOG>,
+		nullptr, // unused, always the null handler
+		&GSState::GIFPackedRegThunk<GIF_REG_XYZF3>,
+		&GSState::GIFPackedRegThunk<GIF_REG_XYZ3>,
+		&GSState::GIFPackedRegThunk<GIF_REG_A_D>,
+		nullptr, // NOP
+	};
+
+	return funcs[reg & 0xf];
+}
+
 template <u32 prim, bool auto_flush, bool index_swap>
 void GSState::GIFPackedRegHandlerSTQRGBAXYZF2(const GIFPackedReg* RESTRICT r, u32 size)
 {
@@ -1566,9 +1612,7 @@ void GSState::FlushWrite()
 
 	InvalidateVideoMem(m_env.BITBLTBUF, r);
 
-	const GSLocalMemory::writeImage wi = GSLocalMemory::m_psm[m_env.BITBLTBUF.DPSM].wi;
-
-	wi(m_mem, m_tr.x, m_tr.y, &m_tr.buff[m_tr.start], len, m_tr.m_blit, m_tr.m_pos, m_tr.m_reg);
+	WriteTransfer(m_tr.x, m_tr.y, &m_tr.buff[m_tr.start], len, m_tr.m_blit, m_tr.m_pos, m_tr.m_reg);
 
 	m_tr.start += len;
 
@@ -1601,12 +1645,33 @@ inline bool GSState::TestDrawChanged()
 			return false;
 	}
 
-	if ((m_dirty_gs_regs & ((1 << DIRTY_REG_TEST) | (1 << DIRTY_REG_SCISSOR) | (1 << DIRTY_REG_XYOFFSET) | (1 << DIRTY_REG_SCANMSK) | (1 << DIRTY_REG_DTHE))) || ((m_dirty_gs_regs & (1 << DIRTY_REG_DIMX)) && m_prev_env.DTHE.DTHE))
-		return true;
+	// TEST is rewritten a lot with only the fields that the current draw doesn't use changed, compare what's actually in effect.
+	if (m_dirty_gs_regs & (1 << DIRTY_REG_TEST))
+	{
+		if (GetEffectiveTEST(m_prev_env.CTXT[m_prev_env.PRIM.CTXT].TEST) != GetEffectiveTEST(m_env.CTXT[m_prev_env.PRIM.CTXT].TEST))
+			return true;
 
-	if (m_prev_env.PRIM.ABE && (m_dirty_gs_regs & ((1 << DIRTY_REG_ALPHA) | (1 << DIRTY_REG_PABE))))
+		m_dirty_gs_regs &= ~(1 << DIRTY_REG_TEST);
+	}
+
+	if ((m_dirty_gs_regs & ((1 << DIRTY_REG_SCISSOR) | (1 << DIRTY_REG_XYOFFSET) | (1 << DIRTY_REG_SCANMSK) | (1 << DIRTY_REG_DTHE))) || ((m_dirty_gs_regs & (1 << DIRTY_REG_DIMX)) && m_prev_env.DTHE.DTHE))
 		return true;
 
+	if (m_prev_env.PRIM.ABE)
+	{
+		if (m_dirty_gs_regs & (1 << DIRTY_REG_PABE))
+			return true;
+
+		// FIX is only used when C selects it.
+		if (m_dirty_gs_regs & (1 << DIRTY_REG_ALPHA))
+		{
+			const GIFRegALPHA& prev_alpha = m_prev_env.CTXT[m_prev_env.PRIM.CTXT].ALPHA;
+			const GIFRegALPHA& alpha = m_env.CTXT[m_prev_env.PRIM.CTXT].ALPHA;
+			if (prev_alpha.U32[0] != alpha.U32[0] || (alpha.C == 2 && prev_alpha.FIX != alpha.FIX))
+				return true;
+		}
+	}
+
 	if (m_prev_env.PRIM.FGE && (m_dirty_gs_regs & (1 << DIRTY_REG_FOGCOL)))
 		return true;
 
@@ -1639,6 +1704,21 @@ inline bool GSState::TestDrawChanged()
 	return false;
 }
 
+u32 GSState::GetEffectiveTEST(const GIFRegTEST& TEST)
+{
+	u32 test = TEST.U32[0];
+
+	// Alpha test function, reference and fail action don't matter with the test disabled.
+	if (!TEST.ATE)
+		test &= ~0x3ffeu;
+
+	// Likewise for the destination alpha test mode.
+	if (!TEST.DATE)
+		test &= ~0x8000u;
+
+	return test;
+}
+
 u32 GSState::CalcMask(int exp, int max_exp)
 {
 	const int amount = 9 + (max_exp - exp);
@@ -1950,7 +2030,6 @@ void GSState::Write(const u8* mem, int len)
 	}
 
 	GIFRegBITBLTBUF& blit = m_tr.m_blit;
-	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[blit.DPSM];
 
 	if (m_tr.end == 0)
 	{
@@ -1986,7 +2065,7 @@ void GSState::Write(const u8* mem, int len)
 			// received all data in one piece, no need to buffer it
 			InvalidateVideoMem(blit, r);
 
-			psm.wi(m_mem, m_tr.x, m_tr.y, mem, m_tr.total, blit, m_tr.m_pos, m_tr.m_reg);
+			WriteTransfer(m_tr.x, m_tr.y, mem, m_tr.total, blit, m_tr.m_pos, m_tr.m_reg);
 
 			m_tr.start = m_tr.end = m_tr.total;
 
@@ -2005,6 +2084,11 @@ void GSState::Write(const u8* mem, int len)
 		FlushWrite();
 }
 
+void GSState::WriteTransfer(int& tx, int& ty, const u8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
+{
+	GSLocalMemory::m_psm[BITBLTBUF.DPSM].wi(m_mem, tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
+}
+
 void GSState::InitReadFIFO(u8* mem, int len)
 {
 	// No size or already a transfer in progress.
@@ -2438,6 +2522,10 @@ void GSState::Transfer(const u8* mem, u32 size)
 						{
 							case GIFPath::TYPE_UNKNOWN:
 							{
+#ifdef _M_X86
+								GSPackedDecoder::Get(path.regs, path.nreg)(this, (GIFPackedReg*)mem, path.nloop);
+								mem += total * sizeof(GIFPackedReg);
+#else
 								u32 reg = 0;
 
 								do
@@ -2448,6 +2536,7 @@ void GSState::Transfer(const u8* mem, u32 size)
 
 									reg = reg & ((int)(reg - path.nreg) >> 31); // resets reg back to 0 when it becomes equal to path.nreg
 								} while (--total > 0);
+#endif
 							}
 							break;
 							case GIFPath::TYPE_ADONLY: // very common
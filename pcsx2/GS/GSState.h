@@ -7,6 +7,7 @@
 #include "GS/GSLocalMemory.h"
 #include "GS/GSDrawingContext.h"
 #include "GS/GSDrawingEnvironment.h"
+#include "GS/GSPackedDecoder.h"
 #include "GS/Renderers/Common/GSVertex.h"
 #include "GS/Renderers/Common/GSVertexTrace.h"
 #include "GS/Renderers/Common/GSDevice.h"
@@ -23,6 +24,9 @@ public:
 
 	static constexpr int GetSaveStateSize(int version);
 
+	/// Returns the function generated PACKED decoders call for a register, or nullptr if it doesn't do anything.
+	static GSPackedDecoder::RegFunc GetPackedRegFunc(u32 reg);
+
 private:
 	// RESTRICT prevents multiple loads of the same part of the register when accessing its bitfields (the compiler is happy to know that memory writes in-between will not go there)
 
@@ -44,6 +48,8 @@ private:
 	void GIFPackedRegHandlerA_D(const GIFPackedReg* RESTRICT r);
 	void GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r);
 
+	template <u32 reg> static void GIFPackedRegThunk(GSState* state, const GIFPackedReg* RESTRICT r);
+
 	typedef void (GSState::*GIFRegHandler)(const GIFReg* RESTRICT r);
 
 	GIFRegHandler m_fpGIFRegHandlers[256] = {};
@@ -417,6 +423,7 @@ public:
 	u32 CalcMask(int exp, int max_exp);
 	void FlushPrim();
 	bool TestDrawChanged();
+	static u32 GetEffectiveTEST(const GIFRegTEST& TEST);
 	void FlushWrite();
 	virtual void Draw() = 0;
 	virtual void PurgeTextureCache(bool sources, bool targets, bool hash_cache);
@@ -424,6 +431,9 @@ public:
 	virtual void InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) {}
 	virtual void InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut = false) {}
 
+	/// Swizzles host->local transfer data into local memory at tx/ty, advancing them past the data written.
+	virtual void WriteTransfer(int& tx, int& ty, const u8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG);
+
 	virtual void Move();
 
 	GSVector4i GetTEX0Rect();
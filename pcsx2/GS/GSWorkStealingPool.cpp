@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GS/GSWorkStealingPool.h"
+
+#include "common/Assertions.h"
+#include "common/HostSys.h"
+#include "common/SmallString.h"
+
+// Waiter is sleeping on the semaphore, and needs a post when the count hits zero.
+static constexpr u32 COUNTER_WAITING_FLAG = 1u << 31;
+
+static thread_local GSWorkStealingPool* s_current_pool = nullptr;
+static thread_local u32 s_current_worker = 0;
+
+GSJobCounter::GSJobCounter() = default;
+
+GSJobCounter::~GSJobCounter()
+{
+	pxAssert(IsZero());
+}
+
+void GSJobCounter::Done()
+{
+	// Nothing can touch the counter after the decrement unless the waiter is asleep, so it's safe for the
+	// waiter to destroy it as soon as it sees zero.
+	const u32 old = m_count.fetch_sub(1, std::memory_order_acq_rel);
+	pxAssert((old & ~COUNTER_WAITING_FLAG) > 0);
+	if (old == (COUNTER_WAITING_FLAG | 1))
+		m_sema.Post();
+}
+
+void GSJobCounter::Wait()
+{
+	u32 value = m_count.load(std::memory_order_acquire);
+	u32 waited = 0;
+	while (value != 0)
+	{
+		pxAssertMsg(!(value & COUNTER_WAITING_FLAG), "Only one thread can wait on a counter");
+		if (waited > SPIN_TIME_NS)
+		{
+			if (!m_count.compare_exchange_weak(value, value | COUNTER_WAITING_FLAG, std::memory_order_acq_rel, std::memory_order_acquire))
+				continue;
+
+			m_sema.Wait();
+			m_count.store(0, std::memory_order_relaxed);
+			return;
+		}
+
+		waited += ShortSpin();
+		value = m_count.load(std::memory_order_acquire);
+	}
+}
+
+bool GSJobCounter::IsZero() const
+{
+	return ((m_count.load(std::memory_order_acquire) & ~COUNTER_WAITING_FLAG) == 0);
+}
+
+GSWorkStealingPool::GSWorkStealingPool(u32 num_threads)
+	: m_deques(std::make_unique<Deque[]>(num_threads + 1))
+{
+	m_threads.reserve(num_threads);
+	for (u32 i = 0; i < num_threads; i++)
+		m_threads.emplace_back([this, i]() { WorkerThreadEntryPoint(i); });
+}
+
+GSWorkStealingPool::~GSWorkStealingPool()
+{
+	m_shutdown.store(true, std::memory_order_seq_cst);
+	for (size_t i = 0; i < m_threads.size(); i++)
+		m_wake_sema.Post();
+	for (Threading::Thread& thread : m_threads)
+		thread.Join();
+
+	for (u32 i = 0; i <= GetThreadCount(); i++)
+		pxAssertMsg(m_deques[i].IsEmpty(), "Pool destroyed with jobs outstanding");
+}
+
+void GSWorkStealingPool::RunJob(GSJob* job)
+{
+	// The job can be freed as soon as the counter is decremented, so grab it first.
+	GSJobCounter* counter = job->counter;
+	job->func(job->arg, job->index);
+	counter->Done();
+}
+
+void GSWorkStealingPool::Submit(GSJob* jobs, u32 count)
+{
+	for (u32 i = 0; i < count; i++)
+		jobs[i].counter->Add(1);
+
+	if (s_current_pool == this)
+	{
+		Deque& deque = m_deques[s_current_worker];
+		for (u32 i = 0; i < count; i++)
+		{
+			// Full, no room to defer it, so do it now.
+			if (!deque.Push(&jobs[i]))
+				RunJob(&jobs[i]);
+		}
+	}
+	else
+	{
+		std::unique_lock lock(m_shared_deque_lock);
+		Deque& deque = m_deques[GetThreadCount()];
+		for (u32 i = 0; i < count; i++)
+		{
+			if (!deque.Push(&jobs[i]))
+			{
+				lock.unlock();
+				RunJob(&jobs[i]);
+				lock.lock();
+			}
+		}
+	}
+
+	// Pairs with the fence in the worker between announcing it's going to sleep and checking for jobs.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	WakeWorkers(count);
+}
+
+void GSWorkStealingPool::Wait(GSJobCounter& counter)
+{
+	// Workers pop their own deque, anyone else can only steal.
+	const u32 index = (s_current_pool == this) ? s_current_worker : GetThreadCount();
+	u32 victim = index;
+	while (!counter.IsZero())
+	{
+		GSJob* job = FindJob(index, victim);
+		if (!job)
+		{
+			// Everything left is running elsewhere.
+			counter.Wait();
+			break;
+		}
+
+		RunJob(job);
+	}
+}
+
+GSJob* GSWorkStealingPool::FindJob(u32 index, u32& victim)
+{
+	if (index < GetThreadCount())
+	{
+		if (GSJob* job = m_deques[index].Pop())
+			return job;
+	}
+
+	// Start with whoever we last stole from, they're likely to still have more.
+	const u32 num_deques = GetThreadCount() + 1;
+	for (u32 i = 0; i < num_deques; i++)
+	{
+		const u32 other = (victim + i) % num_deques;
+		if (other == index && index < GetThreadCount())
+			continue;
+
+		if (GSJob* job = m_deques[other].Steal())
+		{
+			victim = other;
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+bool GSWorkStealingPool::HasAnyJobs() const
+{
+	for (u32 i = 0; i <= GetThreadCount(); i++)
+	{
+		if (!m_deques[i].IsEmpty())
+			return true;
+	}
+
+	return false;
+}
+
+void GSWorkStealingPool::WakeWorkers(u32 count)
+{
+	u32 sleeping = m_sleeping_workers.load(std::memory_order_relaxed);
+	while (sleeping > 0 && count > 0)
+	{
+		if (m_sleeping_workers.compare_exchange_weak(sleeping, sleeping - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+		{
+			m_wake_sema.Post();
+			sleeping--;
+			count--;
+		}
+	}
+}
+
+void GSWorkStealingPool::WorkerThreadEntryPoint(u32 index)
+{
+	Threading::SetNameOfCurrentThread(TinyString::from_format("GS-Job-{}", index).c_str());
+	s_current_pool = this;
+	s_current_worker = index;
+
+	u32 victim = index;
+	while (!m_shutdown.load(std::memory_order_acquire))
+	{
+		GSJob* job = FindJob(index, victim);
+		if (!job)
+		{
+			// Jobs tend to come in bursts, so spin for a bit before sleeping.
+			for (u32 waited = 0; waited < SPIN_TIME_NS && !m_shutdown.load(std::memory_order_relaxed);)
+			{
+				if ((job = FindJob(index, victim)) != nullptr)
+					break;
+				waited += ShortSpin();
+			}
+		}
+
+		if (job)
+		{
+			RunJob(job);
+			continue;
+		}
+
+		// Announce we're going to sleep, then check again, so a submit can't slip in between.
+		m_sleeping_workers.fetch_add(1, std::memory_order_seq_cst);
+		if (HasAnyJobs() || m_shutdown.load(std::memory_order_seq_cst))
+		{
+			// Take ourselves back out, unless someone has already posted for us.
+			u32 sleeping = m_sleeping_workers.load(std::memory_order_relaxed);
+			while (sleeping > 0 && !m_sleeping_workers.compare_exchange_weak(sleeping, sleeping - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+				;
+			if (sleeping > 0)
+				continue;
+		}
+
+		m_wake_sema.Wait();
+	}
+
+	s_current_pool = nullptr;
+}
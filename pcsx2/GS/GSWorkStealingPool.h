@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+#include "common/Threading.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// Number of jobs which have been submitted but haven't finished yet.
+/// Waiting spins for a short while before sleeping, since most waits are short. Only one thread may wait at a time.
+class GSJobCounter
+{
+public:
+	GSJobCounter();
+	~GSJobCounter();
+
+	__fi void Add(u32 count) { m_count.fetch_add(count, std::memory_order_relaxed); }
+	bool IsZero() const;
+
+	/// Marks one job as finished, waking the waiter if it was the last.
+	void Done();
+
+	/// Blocks until every job has finished.
+	void Wait();
+
+private:
+	std::atomic<u32> m_count{0};
+	Threading::KernelSemaphore m_sema;
+};
+
+/// A single unit of work. The submitter owns the memory, which must stay alive until the counter reaches zero.
+struct GSJob
+{
+	using Func = void (*)(void* arg, u32 index);
+
+	Func func;
+	void* arg;
+	u32 index;
+	GSJobCounter* counter;
+};
+
+/// Bounded Chase-Lev deque. The owning thread pushes and pops at the bottom, other threads steal from the top.
+template <u32 CAPACITY>
+class GSWorkStealingDeque
+{
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	/// Returns false if the deque is full, in which case the owner should run the job itself.
+	bool Push(GSJob* job)
+	{
+		const s64 bottom = m_bottom.load(std::memory_order_relaxed);
+		const s64 top = m_top.load(std::memory_order_acquire);
+		if ((bottom - top) >= static_cast<s64>(CAPACITY))
+			return false;
+
+		m_jobs[static_cast<u64>(bottom) & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	GSJob* Pop()
+	{
+		const s64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		s64 top = m_top.load(std::memory_order_relaxed);
+		if (top > bottom)
+		{
+			// Empty.
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		GSJob* job = m_jobs[static_cast<u64>(bottom) & (CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (top == bottom)
+		{
+			// Last job, race any thieves for it.
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				job = nullptr;
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	GSJob* Steal()
+	{
+		s64 top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const s64 bottom = m_bottom.load(std::memory_order_acquire);
+		if (top >= bottom)
+			return nullptr;
+
+		GSJob* job = m_jobs[static_cast<u64>(top) & (CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+
+		return job;
+	}
+
+	bool IsEmpty() const
+	{
+		return (m_top.load(std::memory_order_acquire) >= m_bottom.load(std::memory_order_acquire));
+	}
+
+private:
+	alignas(__cachelinesize) std::atomic<s64> m_top{0};
+	alignas(__cachelinesize) std::atomic<s64> m_bottom{0};
+	alignas(__cachelinesize) std::array<std::atomic<GSJob*>, CAPACITY> m_jobs = {};
+};
+
+/// Pool of threads which each run jobs from their own deque, and steal from the others when it runs dry.
+/// Idle workers spin for a short while before sleeping. Jobs submitted from a worker go to its own deque,
+/// jobs from any other thread go to a shared deque, which only takes a lock for pushing.
+class GSWorkStealingPool
+{
+public:
+	explicit GSWorkStealingPool(u32 num_threads);
+	~GSWorkStealingPool();
+
+	__fi u32 GetThreadCount() const { return static_cast<u32>(m_threads.size()); }
+
+	/// Queues count jobs, adding them to their counters.
+	void Submit(GSJob* jobs, u32 count);
+
+	/// Runs queued jobs on the calling thread until the counter reaches zero, then sleeps if others are still running.
+	void Wait(GSJobCounter& counter);
+
+	/// Calls func(index) for every index in [0, count), spread across the pool and the calling thread.
+	template <typename F>
+	void ParallelFor(u32 count, const F& func)
+	{
+		GSJobCounter counter;
+		std::vector<GSJob> jobs(count);
+		for (u32 i = 0; i < count; i++)
+			jobs[i] = GSJob{[](void* arg, u32 index) { (*static_cast<const F*>(arg))(index); }, const_cast<F*>(&func), i, &counter};
+		Submit(jobs.data(), count);
+		Wait(counter);
+	}
+
+private:
+	static constexpr u32 DEQUE_CAPACITY = 4096;
+	using Deque = GSWorkStealingDeque<DEQUE_CAPACITY>;
+
+	static void RunJob(GSJob* job);
+
+	void WorkerThreadEntryPoint(u32 index);
+	GSJob* FindJob(u32 index, u32& victim);
+	bool HasAnyJobs() const;
+	void WakeWorkers(u32 count);
+
+	std::vector<Threading::Thread> m_threads;
+
+	/// One per worker, plus the shared deque at the end.
+	std::unique_ptr<Deque[]> m_deques;
+	std::mutex m_shared_deque_lock;
+
+	alignas(__cachelinesize) std::atomic<u32> m_sleeping_workers{0};
+	Threading::KernelSemaphore m_wake_sema;
+	std::atomic<bool> m_shutdown{false};
+};
@@ -79,6 +79,15 @@ static ProcessorFeatures getProcessorFeatures()
 			features.hasSlowGather = true;
 		}
 	}
+	if (const char* over = getenv("OVERRIDE_AVX512"))
+	{
+		features.hasAVX512 = over[0] == 'Y' || over[0] == 'y' || over[0] == '1';
+		fprintf(stderr, "Processor AVX-512 override: %s\n", features.hasAVX512 ? "Supported" : "Unsupported");
+	}
+	else
+	{
+		features.hasAVX512 = cpuinfo_has_x86_avx512f() && cpuinfo_has_x86_avx512bw();
+	}
 #endif
 	return features;
 }
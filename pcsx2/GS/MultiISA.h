@@ -49,6 +49,7 @@ struct ProcessorFeatures
 	VectorISA vectorISA;
 	bool hasFMA;
 	bool hasSlowGather;
+	bool hasAVX512; // F and BW, only used by AVX2 code
 #endif
 };
 
@@ -2,7 +2,18 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "GS/Renderers/Common/GSFunctionMap.h"
+#include "Config.h"
 #include "Memory.h"
+#include "VMManager.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
+
+#include <cstring>
 
 namespace GSCodeReserve
 {
@@ -23,6 +34,11 @@ size_t GSCodeReserve::GetMemoryUsed()
 	return s_memory_ptr - s_memory_base;
 }
 
+size_t GSCodeReserve::GetMemorySize()
+{
+	return s_memory_end - s_memory_base;
+}
+
 u8* GSCodeReserve::ReserveMemory(size_t size)
 {
 	pxAssert((s_memory_ptr + size) <= s_memory_end);
@@ -34,3 +50,88 @@ void GSCodeReserve::CommitMemory(size_t size)
 	pxAssert((s_memory_ptr + size) <= s_memory_end);
 	s_memory_ptr += size;
 }
+
+namespace
+{
+	struct SelectorCacheHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 num_sp_keys;
+		u32 num_ds_keys;
+	};
+} // namespace
+
+static constexpr u32 SELECTOR_CACHE_MAGIC = 0x43534A53; // SJSC
+static constexpr u32 SELECTOR_CACHE_VERSION = 1;
+
+// Stops a corrupted file from making us try to compile millions of functions.
+static constexpr u32 MAX_SELECTOR_CACHE_KEYS = 16384;
+
+std::string GSSelectorCache::GetPath()
+{
+	const std::string serial = VMManager::GetDiscSerial();
+	const u32 crc = VMManager::GetCurrentCRC();
+	if (serial.empty() && crc == 0)
+		return {};
+
+	return Path::Combine(EmuFolders::Cache,
+		Path::Combine("sw_selectors", fmt::format("{}_{:08X}.bin", Path::SanitizeFileName(serial), crc)));
+}
+
+bool GSSelectorCache::Load(const std::string& path, std::vector<u64>* sp_keys, std::vector<u64>* ds_keys)
+{
+	if (!FileSystem::FileExists(path.c_str()))
+		return false;
+
+	const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+	if (!data.has_value() || data->size() < sizeof(SelectorCacheHeader))
+		return false;
+
+	SelectorCacheHeader header;
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != SELECTOR_CACHE_MAGIC || header.version != SELECTOR_CACHE_VERSION ||
+		header.num_sp_keys > MAX_SELECTOR_CACHE_KEYS || header.num_ds_keys > MAX_SELECTOR_CACHE_KEYS ||
+		data->size() != (sizeof(SelectorCacheHeader) + (header.num_sp_keys + header.num_ds_keys) * sizeof(u64)))
+	{
+		WARNING_LOG("Ignoring invalid SW selector cache '{}'", Path::GetFileName(path));
+		return false;
+	}
+
+	const u8* ptr = data->data() + sizeof(SelectorCacheHeader);
+	sp_keys->resize(header.num_sp_keys);
+	std::memcpy(sp_keys->data(), ptr, header.num_sp_keys * sizeof(u64));
+	ptr += header.num_sp_keys * sizeof(u64);
+	ds_keys->resize(header.num_ds_keys);
+	std::memcpy(ds_keys->data(), ptr, header.num_ds_keys * sizeof(u64));
+	return true;
+}
+
+void GSSelectorCache::Save(const std::string& path, const std::vector<u64>& sp_keys, const std::vector<u64>& ds_keys)
+{
+	Error error;
+	if (!FileSystem::CreateDirectoryPath(std::string(Path::GetDirectory(path)).c_str(), false, &error))
+	{
+		ERROR_LOG("Failed to create SW selector cache directory: {}", error.GetDescription());
+		return;
+	}
+
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "wb", &error);
+	if (!fp)
+	{
+		ERROR_LOG("Failed to open '{}': {}", Path::GetFileName(path), error.GetDescription());
+		return;
+	}
+
+	const SelectorCacheHeader header = {SELECTOR_CACHE_MAGIC, SELECTOR_CACHE_VERSION,
+		static_cast<u32>(std::min<size_t>(sp_keys.size(), MAX_SELECTOR_CACHE_KEYS)),
+		static_cast<u32>(std::min<size_t>(ds_keys.size(), MAX_SELECTOR_CACHE_KEYS))};
+	if (std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 ||
+		std::fwrite(sp_keys.data(), sizeof(u64), header.num_sp_keys, fp.get()) != header.num_sp_keys ||
+		std::fwrite(ds_keys.data(), sizeof(u64), header.num_ds_keys, fp.get()) != header.num_ds_keys)
+	{
+		ERROR_LOG("Failed to write '{}'", Path::GetFileName(path));
+		fp.reset();
+		FileSystem::DeleteFilePath(path.c_str());
+	}
+}
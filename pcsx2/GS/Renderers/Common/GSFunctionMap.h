@@ -9,6 +9,8 @@
 #include "common/HostSys.h"
 
 #include <cinttypes>
+#include <string>
+#include <vector>
 
 template <class KEY, class VALUE>
 class GSFunctionMap
@@ -67,6 +69,16 @@ public:
 		return m_active->f;
 	}
 
+	/// Forgets every function handed out, so they are looked up again on next use.
+	void ClearActive()
+	{
+		for (auto& i : m_map_active)
+			delete i.second;
+
+		m_map_active.clear();
+		m_active = NULL;
+	}
+
 	void UpdateStats(u64 frame, u64 ticks, int actual, int total, int prims)
 	{
 		if (m_active)
@@ -142,19 +154,63 @@ namespace GSCodeReserve
 	void ResetMemory();
 
 	size_t GetMemoryUsed();
+	size_t GetMemorySize();
 
 	u8* ReserveMemory(size_t size);
 	void CommitMemory(size_t size);
 }
 
+// --------------------------------------------------------------------------------------
+//  GSSelectorCache
+// --------------------------------------------------------------------------------------
+// Remembers which selectors the GS software JIT compiled for each game, so they can be
+// compiled up front the next time the game is run, instead of when they're first drawn.
+//
+namespace GSSelectorCache
+{
+	/// Returns the path selectors for the running game are stored in, or an empty string if there's no game.
+	std::string GetPath();
+
+	bool Load(const std::string& path, std::vector<u64>* sp_keys, std::vector<u64>* ds_keys);
+	void Save(const std::string& path, const std::vector<u64>& sp_keys, const std::vector<u64>& ds_keys);
+}
+
 template <class CG, class KEY, class VALUE>
 class GSCodeGeneratorFunctionMap : public GSFunctionMap<KEY, VALUE>
 {
 	std::string m_name;
 	std::unordered_map<u64, VALUE> m_cgmap;
 
+	u32 m_precompiled = 0; // Functions generated from the selector cache.
+	u32 m_precompiled_hits = 0; // First uses of a selector which found it already generated.
+	u32 m_compiled = 0; // Functions generated on first use.
+
 	enum { MAX_SIZE = 8192 };
 
+	VALUE Compile(KEY key)
+	{
+		HostSys::BeginCodeWrite();
+
+		u8* code_ptr = GSCodeReserve::ReserveMemory(MAX_SIZE);
+		CG cg(key, code_ptr, MAX_SIZE);
+		cg.Generate();
+		pxAssert(cg.GetSize() < MAX_SIZE);
+
+#if 0
+		fprintf(stderr, "%s Location:%p Size:%zu Key:%llx\n", m_name.c_str(), code_ptr, cg.getSize(), (u64)key);
+		GSScanlineSelector sel(key);
+		sel.Print();
+#endif
+
+		const u32 size = static_cast<u32>(cg.GetSize());
+		GSCodeReserve::CommitMemory(size);
+
+		HostSys::EndCodeWrite();
+		HostSys::FlushInstructionCache(code_ptr, static_cast<u32>(size));
+
+		return (VALUE)cg.GetCode();
+	}
+
 public:
 	GSCodeGeneratorFunctionMap(std::string name)
 		: m_name(name)
@@ -165,7 +221,40 @@ public:
 
 	void Clear()
 	{
+		// The active map holds pointers into the code we're throwing away.
+		GSFunctionMap<KEY, VALUE>::ClearActive();
 		m_cgmap.clear();
+		m_precompiled = 0;
+		m_precompiled_hits = 0;
+		m_compiled = 0;
+	}
+
+	/// Generates the function for a selector ahead of its first use.
+	void Precompile(KEY key)
+	{
+		if (m_cgmap.find(key) != m_cgmap.end())
+			return;
+
+		m_cgmap[key] = Compile(key);
+		m_precompiled++;
+	}
+
+	/// Returns every selector which currently has generated code.
+	std::vector<u64> GetCompiledKeys() const
+	{
+		std::vector<u64> keys;
+		keys.reserve(m_cgmap.size());
+		for (const auto& it : m_cgmap)
+			keys.push_back(it.first);
+		return keys;
+	}
+
+	void PrintCacheStats() const
+	{
+		const u32 first_uses = m_precompiled_hits + m_compiled;
+		printf("%s: %u precompiled, %u of %u selectors used were precompiled (%.1f%%), %u compiled on first use\n",
+			m_name.c_str(), m_precompiled, m_precompiled_hits, first_uses,
+			first_uses ? (static_cast<double>(m_precompiled_hits) * 100.0 / first_uses) : 0.0, m_compiled);
 	}
 
 	VALUE GetDefaultFunction(KEY key)
@@ -177,31 +266,13 @@ public:
 		if (i != m_cgmap.end())
 		{
 			ret = i->second;
+			m_precompiled_hits++;
 		}
 		else
 		{
-			HostSys::BeginCodeWrite();
-
-			u8* code_ptr = GSCodeReserve::ReserveMemory(MAX_SIZE);
-			CG cg(key, code_ptr, MAX_SIZE);
-			cg.Generate();
-			pxAssert(cg.GetSize() < MAX_SIZE);
-
-#if 0
-			fprintf(stderr, "%s Location:%p Size:%zu Key:%llx\n", m_name.c_str(), code_ptr, cg.getSize(), (u64)key);
-			GSScanlineSelector sel(key);
-			sel.Print();
-#endif
-
-			const u32 size = static_cast<u32>(cg.GetSize());
-			GSCodeReserve::CommitMemory(size);
-
-			HostSys::EndCodeWrite();
-			HostSys::FlushInstructionCache(code_ptr, static_cast<u32>(size));
-
-			ret = (VALUE)cg.GetCode();
-
+			ret = Compile(key);
 			m_cgmap[key] = ret;
+			m_compiled++;
 		}
 
 		return ret;
@@ -4,6 +4,7 @@
 #include "GSVertexTrace.h"
 #include "GS/GSUtil.h"
 #include "GS/GSState.h"
+#include "GS/GSXXH.h"
 
 #include "common/Console.h"
 
@@ -25,7 +26,53 @@ void GSVertexTrace::Update(const void* vertex, const u16* index, int v_count, in
 	const u32 fst = m_state->PRIM->FST;
 	const u32 color = !(m_state->PRIM->TME && m_state->m_context->TEX0.TFX == TFX_DECAL && m_state->m_context->TEX0.TCC);
 
-	m_fmm[color][fst][tme][iip][primclass](*this, vertex, index, i_count);
+	const FindMinMaxPtr fmm = m_fmm[color][fst][tme][iip][primclass];
+
+	if (i_count >= MIN_CACHED_INDICES)
+	{
+		// Multipass effects often submit the same vertices several times in a row, with only the blend/texture
+		// state changing. Once two consecutive draws look alike, hash them, and skip the scan on a match.
+		u32 key = static_cast<u32>(primclass) | (iip << 2) | (tme << 3) | (fst << 4) | (color << 5);
+		if (tme && !fst)
+			key |= (m_state->m_context->TEX0.TW << 6) | (m_state->m_context->TEX0.TH << 10);
+
+		const u64 xyoffset = m_state->m_context->XYOFFSET.U64;
+
+		bool hit = false;
+		if (m_cached.key == key && m_cached.xyoffset == xyoffset && m_cached.v_count == v_count && m_cached.i_count == i_count)
+		{
+			const u64 hash = XXH3_64bits_withSeed(index, sizeof(u16) * i_count,
+				GSXXH3_64bits(vertex, sizeof(GSVertex) * v_count));
+
+			hit = (m_cached.hash_valid && m_cached.hash == hash);
+			m_cached.hash = hash;
+			m_cached.hash_valid = true;
+		}
+		else
+		{
+			m_cached.key = key;
+			m_cached.xyoffset = xyoffset;
+			m_cached.v_count = v_count;
+			m_cached.i_count = i_count;
+			m_cached.hash_valid = false;
+		}
+
+		if (hit)
+		{
+			m_min = m_cached.min;
+			m_max = m_cached.max;
+		}
+		else
+		{
+			fmm(*this, vertex, index, i_count);
+			m_cached.min = m_min;
+			m_cached.max = m_max;
+		}
+	}
+	else
+	{
+		fmm(*this, vertex, index, i_count);
+	}
 
 	// Potential float overflow detected. Better uses the slower division instead
 	// Note: If Q is too big, 1/Q will end up as 0. 1e30 is a random number
@@ -41,6 +41,22 @@ protected:
 
 	FindMinMaxPtr m_fmm[2][2][2][2][4];
 
+	/// Draws smaller than this aren't worth hashing, the min/max is cheaper to recompute.
+	static constexpr int MIN_CACHED_INDICES = 256;
+
+	/// Min/max from the last large draw, reused when the next draw has the same vertices and state.
+	struct CachedMinMax
+	{
+		Vertex min, max;
+		u64 hash;
+		u64 xyoffset;
+		u32 key;
+		int v_count, i_count;
+		bool hash_valid;
+	};
+
+	CachedMinMax m_cached = {};
+
 public:
 	GS_PRIM_CLASS m_primclass = GS_INVALID_CLASS;
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "GSVertexTrace.h"
+#include "GSVertexTraceFMM.h"
 #include "GS/GSState.h"
 #include <cfloat>
 
@@ -15,6 +16,17 @@ class CURRENT_ISA::GSVertexTraceFMM
 	template <GS_PRIM_CLASS primclass, u32 iip, u32 tme, u32 fst, u32 color>
 	static constexpr GSVertexTrace::FindMinMaxPtr GetFMM(bool provoking_vertex_first);
 
+	template <u32 tme, u32 fst, u32 color>
+	static void StoreMinMax(GSVertexTrace& vt, const GSVertexTraceMinMax& mm);
+
+#ifdef GS_AVX512_FUNCTION
+	template <u32 tme, u32 fst, u32 color>
+	static void FindMinMaxAVX512(GSVertexTrace& vt, const void* vertex, const u16* index, int count);
+
+	template <u32 tme, u32 fst, u32 color>
+	static void PopulateAVX512(GSVertexTrace& vt);
+#endif
+
 public:
 	static void Populate(GSVertexTrace& vt, bool provoking_vertex_first);
 };
@@ -61,13 +73,49 @@ void GSVertexTraceFMM::Populate(GSVertexTrace& vt, bool provoking_vertex_first)
 	InitUpdate(GS_LINE_CLASS);
 	InitUpdate(GS_TRIANGLE_CLASS);
 	InitUpdate(GS_SPRITE_CLASS);
+
+#ifdef GS_AVX512_FUNCTION
+	if (g_cpu.hasAVX512)
+	{
+		PopulateAVX512<0, 0, 0>(vt);
+		PopulateAVX512<0, 0, 1>(vt);
+		PopulateAVX512<0, 1, 0>(vt);
+		PopulateAVX512<0, 1, 1>(vt);
+		PopulateAVX512<1, 0, 0>(vt);
+		PopulateAVX512<1, 0, 1>(vt);
+		PopulateAVX512<1, 1, 0>(vt);
+		PopulateAVX512<1, 1, 1>(vt);
+	}
+#endif
 }
 
+#ifdef GS_AVX512_FUNCTION
+
+template <u32 tme, u32 fst, u32 color>
+void GSVertexTraceFMM::PopulateAVX512(GSVertexTrace& vt)
+{
+	// Only used where every vertex contributes the same way. Flat shading and sprites pick attributes
+	// from specific vertices of each primitive, so they stay on the regular path.
+	const GSVertexTrace::FindMinMaxPtr fmm = FindMinMaxAVX512<tme, tme ? fst : 0, color>;
+	vt.m_fmm[color][fst][tme][0][GS_POINT_CLASS] = fmm;
+	vt.m_fmm[color][fst][tme][1][GS_POINT_CLASS] = fmm;
+	vt.m_fmm[color][fst][tme][1][GS_LINE_CLASS] = fmm;
+	vt.m_fmm[color][fst][tme][1][GS_TRIANGLE_CLASS] = fmm;
+}
+
+template <u32 tme, u32 fst, u32 color>
+void GSVertexTraceFMM::FindMinMaxAVX512(GSVertexTrace& vt, const void* vertex, const u16* index, int count)
+{
+	GSVertexTraceMinMax mm;
+	GSVertexTraceFindMinMaxAVX512<tme, fst, color>(static_cast<const GSVertex*>(vertex), index, count, mm);
+	StoreMinMax<tme, fst, color>(vt, mm);
+}
+
+#endif
+
 template <GS_PRIM_CLASS primclass, u32 iip, u32 tme, u32 fst, u32 color, bool flat_swapped>
 void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u16* index, int count)
 {
-	const GSDrawingContext* context = vt.m_state->m_context;
-
 	int n = 1;
 
 	switch (primclass)
@@ -223,15 +271,23 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 		pxAssertRel(0, "Bad n value");
 	}
 
+	StoreMinMax<tme, fst, color>(vt, {tmin, tmax, cmin, cmax, pmin, pmax});
+}
+
+template <u32 tme, u32 fst, u32 color>
+void GSVertexTraceFMM::StoreMinMax(GSVertexTrace& vt, const GSVertexTraceMinMax& mm)
+{
+	const GSDrawingContext* context = vt.m_state->m_context;
+
 	GSVector4 o(context->XYOFFSET);
 	GSVector4 s(1.0f / 16, 1.0f / 16, 2.0f, 1.0f);
 
-	vt.m_min.p = (GSVector4(pmin) - o) * s;
-	vt.m_max.p = (GSVector4(pmax) - o) * s;
+	vt.m_min.p = (GSVector4(mm.pmin) - o) * s;
+	vt.m_max.p = (GSVector4(mm.pmax) - o) * s;
 
 	// Fix signed int conversion
-	vt.m_min.p = vt.m_min.p.insert32<0, 2>(GSVector4::load((float)(u32)pmin.extract32<2>()));
-	vt.m_max.p = vt.m_max.p.insert32<0, 2>(GSVector4::load((float)(u32)pmax.extract32<2>()));
+	vt.m_min.p = vt.m_min.p.insert32<0, 2>(GSVector4::load((float)(u32)mm.pmin.extract32<2>()));
+	vt.m_max.p = vt.m_max.p.insert32<0, 2>(GSVector4::load((float)(u32)mm.pmax.extract32<2>()));
 
 	if (tme)
 	{
@@ -244,8 +300,8 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 			s = GSVector4(1 << context->TEX0.TW, 1 << context->TEX0.TH, 1, 1);
 		}
 
-		vt.m_min.t = tmin * s;
-		vt.m_max.t = tmax * s;
+		vt.m_min.t = mm.tmin * s;
+		vt.m_max.t = mm.tmax * s;
 	}
 	else
 	{
@@ -255,8 +311,8 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 
 	if (color)
 	{
-		vt.m_min.c = cmin.u8to32();
-		vt.m_max.c = cmax.u8to32();
+		vt.m_min.c = mm.cmin.u8to32();
+		vt.m_max.c = mm.cmax.u8to32();
 	}
 	else
 	{
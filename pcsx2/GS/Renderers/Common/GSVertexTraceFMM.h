@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/MultiISA.h"
+#include "GS/Renderers/Common/GSVertex.h"
+
+#include <algorithm>
+#include <cfloat>
+
+// AVX-512 isn't a multi-isa target of its own, so the kernels are compiled into the AVX2 build with
+// the extra instructions enabled per function, and only selected when the CPU supports them.
+#if defined(_M_X86) && _M_SSE >= 0x501
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#define GS_AVX512_FUNCTION
+	#else
+		#define GS_AVX512_FUNCTION __attribute__((target("avx512f,avx512bw")))
+	#endif
+#endif
+
+MULTI_ISA_UNSHARED_START
+
+/// Raw min/max of the vertex attributes, before offsetting and scaling.
+struct GSVertexTraceMinMax
+{
+	GSVector4 tmin, tmax; // s/q, t/q, q, q or u, v, u, v
+	GSVector4i cmin, cmax; // rgba in the low 4 bytes
+	GSVector4i pmin, pmax; // x, y, z, f
+};
+
+#ifdef GS_AVX512_FUNCTION
+
+namespace GSVertexTraceAVX512
+{
+	/// Loads four vertices, and splits them into one register of m[0] and one of m[1], a vertex per 128-bit lane.
+	static GS_AVX512_FUNCTION __forceinline void Load4(const GSVertex& v0, const GSVertex& v1, const GSVertex& v2,
+		const GSVertex& v3, __m512i& m0, __m512i& m1)
+	{
+		const __m512i a = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_load_si256(&v0.mx)), _mm256_load_si256(&v1.mx), 1);
+		const __m512i b = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_load_si256(&v2.mx)), _mm256_load_si256(&v3.mx), 1);
+		m0 = _mm512_permutex2var_epi64(a, _mm512_setr_epi64(0, 1, 4, 5, 8, 9, 12, 13), b);
+		m1 = _mm512_permutex2var_epi64(a, _mm512_setr_epi64(2, 3, 6, 7, 10, 11, 14, 15), b);
+	}
+
+	static GS_AVX512_FUNCTION __forceinline __m128i MinU8(__m512i v)
+	{
+		const __m256i r = _mm256_min_epu8(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64(v, 1));
+		return _mm_min_epu8(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+	}
+
+	static GS_AVX512_FUNCTION __forceinline __m128i MaxU8(__m512i v)
+	{
+		const __m256i r = _mm256_max_epu8(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64(v, 1));
+		return _mm_max_epu8(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+	}
+
+	static GS_AVX512_FUNCTION __forceinline __m128i MinU32(__m512i v)
+	{
+		const __m256i r = _mm256_min_epu32(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64(v, 1));
+		return _mm_min_epu32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+	}
+
+	static GS_AVX512_FUNCTION __forceinline __m128i MaxU32(__m512i v)
+	{
+		const __m256i r = _mm256_max_epu32(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64(v, 1));
+		return _mm_max_epu32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+	}
+
+	static GS_AVX512_FUNCTION __forceinline __m128 MinF32(__m512 v)
+	{
+		const __m256 r = _mm256_min_ps(_mm512_castps512_ps256(v), _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1)));
+		return _mm_min_ps(_mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1));
+	}
+
+	static GS_AVX512_FUNCTION __forceinline __m128 MaxF32(__m512 v)
+	{
+		const __m256 r = _mm256_max_ps(_mm512_castps512_ps256(v), _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1)));
+		return _mm_max_ps(_mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1));
+	}
+
+	template <u32 tme, u32 fst, u32 color>
+	static GS_AVX512_FUNCTION __forceinline void Accumulate(const __m512i m0, const __m512i m1, __m512& tmin, __m512& tmax,
+		__m512i& cmin, __m512i& cmax, __m512i& pmin, __m512i& pmax)
+	{
+		if (color)
+		{
+			cmin = _mm512_min_epu8(cmin, m0);
+			cmax = _mm512_max_epu8(cmax, m0);
+		}
+
+		if (tme)
+		{
+			__m512 t;
+			if (!fst)
+			{
+				// Replace the rgba lane before dividing, it's often denormal.
+				const __m512 stq = _mm512_castsi512_ps(m0);
+				const __m512 q = _mm512_permute_ps(stq, _MM_SHUFFLE(3, 3, 3, 3));
+				const __m512 st = _mm512_div_ps(_mm512_mask_blend_ps(0xCCCC, stq, q), q);
+				t = _mm512_mask_blend_ps(0xCCCC, st, q);
+			}
+			else
+			{
+				const __m512 uv = _mm512_cvtepi32_ps(_mm512_unpackhi_epi16(m1, _mm512_setzero_si512()));
+				t = _mm512_permute_ps(uv, _MM_SHUFFLE(1, 0, 1, 0));
+			}
+
+			tmin = _mm512_min_ps(tmin, t);
+			tmax = _mm512_max_ps(tmax, t);
+		}
+
+		const __m512i xy = _mm512_unpacklo_epi16(m1, _mm512_setzero_si512());
+		const __m512i zf = _mm512_shuffle_epi32(m1, _MM_PERM_DBDB);
+		const __m512i p = _mm512_mask_blend_epi32(0xCCCC, xy, zf);
+
+		pmin = _mm512_min_epu32(pmin, p);
+		pmax = _mm512_max_epu32(pmax, p);
+	}
+} // namespace GSVertexTraceAVX512
+
+/// Min/max over vertices which all contribute the same way, i.e. points, and lines/triangles with gouraud shading.
+/// Four vertices are processed per iteration, giving 16 lanes for each attribute.
+template <u32 tme, u32 fst, u32 color>
+GS_AVX512_FUNCTION void GSVertexTraceFindMinMaxAVX512(const GSVertex* RESTRICT v, const u16* RESTRICT index, int count, GSVertexTraceMinMax& out)
+{
+	using namespace GSVertexTraceAVX512;
+
+	__m512 tmin = _mm512_set1_ps(FLT_MAX);
+	__m512 tmax = _mm512_set1_ps(-FLT_MAX);
+	__m512i cmin = _mm512_set1_epi32(-1);
+	__m512i cmax = _mm512_setzero_si512();
+	__m512i pmin = _mm512_set1_epi32(-1);
+	__m512i pmax = _mm512_setzero_si512();
+
+	__m512i m0, m1;
+
+	int i = 0;
+	for (; i <= (count - 4); i += 4)
+	{
+		Load4(v[index[i + 0]], v[index[i + 1]], v[index[i + 2]], v[index[i + 3]], m0, m1);
+		Accumulate<tme, fst, color>(m0, m1, tmin, tmax, cmin, cmax, pmin, pmax);
+	}
+
+	if (i < count)
+	{
+		// Repeat the last vertex to fill the remaining lanes, it doesn't change the result.
+		const int last = count - 1;
+		Load4(v[index[i]], v[index[std::min(i + 1, last)]], v[index[std::min(i + 2, last)]], v[index[last]], m0, m1);
+		Accumulate<tme, fst, color>(m0, m1, tmin, tmax, cmin, cmax, pmin, pmax);
+	}
+
+	out.tmin = GSVector4(MinF32(tmin));
+	out.tmax = GSVector4(MaxF32(tmax));
+	out.cmin = GSVector4i::load(_mm_extract_epi32(MinU8(cmin), 2));
+	out.cmax = GSVector4i::load(_mm_extract_epi32(MaxU8(cmax), 2));
+	out.pmin = GSVector4i(MinU32(pmin));
+	out.pmax = GSVector4i(MaxU32(pmax));
+}
+
+#endif
+
+MULTI_ISA_UNSHARED_END
@@ -3233,6 +3233,7 @@ void GSRendererHW::Draw()
 			if (vertical_offset < 0)
 			{
 				ds->m_TEX0.TBP0 = m_cached_ctx.ZBUF.Block();
+				ds->UpdatePageIndex();
 				GSVector2i new_size = ds->m_unscaled_size;
 				// Make sure to use the original format for the offset.
 				const int new_offset = std::abs((vertical_offset / zbuf_psm.pgs.y) * GSLocalMemory::m_psm[ds->m_TEX0.PSM].pgs.y);
@@ -3528,6 +3529,7 @@ void GSRendererHW::Draw()
 			if (vertical_offset < 0)
 			{
 				rt->m_TEX0.TBP0 = m_cached_ctx.FRAME.Block();
+				rt->UpdatePageIndex();
 				GSVector2i new_size = rt->m_unscaled_size;
 				// Make sure to use the original format for the offset.
 				const int new_offset = std::abs((vertical_offset / frame_psm.pgs.y) * GSLocalMemory::m_psm[rt->m_TEX0.PSM].pgs.y);
@@ -4730,10 +4732,16 @@ void GSRendererHW::Draw()
 	}
 
 	if (rt)
+	{
 		rt->m_last_draw = s_n;
+		g_texture_cache->QueueSpeculativeRead(rt);
+	}
 
 	if (ds)
+	{
 		ds->m_last_draw = s_n;
+		g_texture_cache->QueueSpeculativeRead(ds);
+	}
 
 	if ((fm & fm_mask) != fm_mask && !no_rt)
 	{
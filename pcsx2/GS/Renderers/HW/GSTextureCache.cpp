@@ -98,6 +98,7 @@ void GSTextureCache::RemoveAll(bool sources, bool targets, bool hash_cache)
 
 		m_target_heights.clear();
 		m_surface_offset_cache.clear();
+		m_readback_history.clear();
 		m_target_memory_usage = 0;
 	}
 
@@ -1617,6 +1618,7 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 							}
 							t->m_valid_rgb = true;
 							t->m_TEX0 = dst_match->m_TEX0;
+							t->UpdatePageIndex();
 							break;
 						}
 					}
@@ -2186,6 +2188,8 @@ void GSTextureCache::CombineAlignedInsideTargets(Target* target, GSTextureCache:
 	if (GSConfig.UserHacks_TextureInsideRt < GSTextureInRtMode::InsideTargets)
 		return;
 
+	target->DiscardSpeculativeRead();
+
 	auto& list = m_dst[target->m_type];
 
 	for (auto i = list.begin(); i != list.end();)
@@ -2523,6 +2527,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 							t->m_valid = dirty_rect;
 							t->m_end_block = GSLocalMemory::GetEndBlockAddress(t->m_TEX0.TBP0, t->m_TEX0.TBW, t->m_TEX0.PSM, t->m_valid);
 							t->m_drawn_since_read = GSVector4i::zero();
+							t->UpdatePageIndex();
 						}
 						else
 						{
@@ -3038,6 +3043,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 			dst->m_32_bits_fmt = dst_match->m_32_bits_fmt;
 			dst->OffsetHack_modxy = dst_match->OffsetHack_modxy;
 			dst->m_end_block = dst_match->m_end_block; // If we're copying the size, we need to keep the end block.
+			dst->UpdatePageIndex();
 			dst->m_valid = dst_match->m_valid;
 			dst->m_valid_alpha_low = dst_match->m_valid_alpha_low; //&& psm_s.trbpp != 24;
 			dst->m_valid_alpha_high = dst_match->m_valid_alpha_high; //&& psm_s.trbpp != 24;
@@ -3134,6 +3140,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 	{
 		dst->m_used |= used;
 		dst->readbacks_since_draw = 0;
+		dst->DiscardSpeculativeRead();
 
 		pxAssert(dst && dst->m_texture && dst->m_scale == scale);
 	}
@@ -3614,6 +3621,7 @@ bool GSTextureCache::PreloadTarget(GIFRegTEX0 TEX0, const GSVector2i& size, cons
 							dst->m_valid = t->m_valid;
 							dst->m_drawn_since_read = t->m_drawn_since_read;
 							dst->m_end_block = t->m_end_block;
+							dst->UpdatePageIndex();
 							dst->m_valid_rgb = true;
 							t->m_valid_rgb = false;
 							t->m_was_dst_matched = true;
@@ -3979,6 +3987,8 @@ bool GSTextureCache::CopyRGBFromDepthToColor(Target* dst, Target* depth_src)
 		GSUtil::GetPSMName(depth_src->m_TEX0.PSM), dst->GetUnscaledWidth(), dst->GetUnscaledHeight(), to_string(dst->m_type),
 		dst->m_TEX0.TBP0, GSUtil::GetPSMName(dst->m_TEX0.PSM));
 
+	dst->DiscardSpeculativeRead();
+
 	// The depth target might be larger (Driv3r).
 	const GSVector2i new_size = dst->GetUnscaledSize().max(GSVector2i(depth_src->m_valid.z, depth_src->m_valid.w));
 	const GSVector2i new_scaled_size = ScaleRenderTargetSize(new_size, dst->GetScale());
@@ -4232,6 +4242,9 @@ void GSTextureCache::InvalidateContainedTargets(u32 start_bp, u32 end_bp, u32 wr
 // must invalidate the Target/Depth respectively
 void GSTextureCache::InvalidateVideoMemType(int type, u32 bp, u32 write_psm, u32 write_fbmsk, bool dirty_only)
 {
+	if (!m_dst_pages[type].MayOverlap(bp, bp))
+		return;
+
 	auto& list = m_dst[type];
 	for (auto i = list.begin(); i != list.end(); ++i)
 	{
@@ -4419,6 +4432,10 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 
 	for (int type = 0; type < 2; type++)
 	{
+		// Skip the whole list if no target of this type covers any of the pages, the check below is a subset of this.
+		if (!m_dst_pages[type].MayOverlap(bp, end_bp))
+			continue;
+
 		auto& list = m_dst[type];
 		for (auto i = list.begin(); i != list.end();)
 		{
@@ -4936,6 +4953,7 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 			if (dst->m_was_dst_matched)
 			{
 				dst->m_TEX0 = new_TEX0;
+				dst->UpdatePageIndex();
 			}
 		}
 
@@ -5026,6 +5044,8 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 	GL_CACHE("TC: HW Move after draw %d 0x%x[BW:%u PSM:%s] to 0x%x[BW:%u PSM:%s] <%d,%d->%d,%d> -> <%d,%d->%d,%d>", GSState::s_n, SBP, SBW,
 		GSUtil::GetPSMName(SPSM), DBP, DBW, GSUtil::GetPSMName(DPSM), sx, sy, sx + w, sy + h, dx, dy, dx + w, dy + h);
 
+	dst->DiscardSpeculativeRead();
+
 	const bool cover_whole_target = dst->m_type == RenderTarget && GSVector4i(dx, dy, dx + w, dy + h).rintersect(dst->m_valid).eq(dst->m_valid);
 	if (!cover_whole_target)
 	{
@@ -5235,6 +5255,8 @@ bool GSTextureCache::ShuffleMove(u32 BP, u32 BW, u32 PSM, int sx, int sy, int dx
 	if (read_ba || !write_rg)
 		tgt->UnscaleRTAlpha();
 
+	tgt->DiscardSpeculativeRead();
+
 	GSHWDrawConfig& config = GSRendererHW::GetInstance()->BeginHLEHardwareDraw(tgt->m_texture, nullptr, tgt->m_scale, tgt->m_texture, tgt->m_scale, bbox);
 	config.colormask.wrgba = (write_rg ? (1 | 2) : (4 | 8));
 	config.ps.process_ba = read_ba ? 1 : 0;
@@ -5328,6 +5350,8 @@ void GSTextureCache::CopyPages(Target* src, u32 sbw, u32 src_offset, Target* dst
 	GL_PUSH("TC: GSTextureCache::CopyPages(): %u pages at %x[eff %x] BW %u to %x[eff %x] BW %u", num_pages,
 		src->m_TEX0.TBP0, src->m_TEX0.TBP0 + src_offset, sbw, dst->m_TEX0.TBP0, dst->m_TEX0.TBP0 + dst_offset, dbw);
 
+	dst->DiscardSpeculativeRead();
+
 	// Create rectangles for the pages.
 	const GSVector2i& pgs = GSLocalMemory::m_psm[dst->m_TEX0.PSM].pgs;
 	const GSVector4i page_rc = GSVector4i::loadh(pgs);
@@ -5411,6 +5435,9 @@ GSTextureCache::Target* GSTextureCache::FindOverlappingTarget(u32 BP, u32 end_bp
 {
 	for (int i = 0; i < 2; i++)
 	{
+		if (!m_dst_pages[i].MayOverlap(BP, end_bp))
+			continue;
+
 		for (Target* tgt : m_dst[i])
 		{
 			if (CheckOverlap(tgt->m_TEX0.TBP0, tgt->m_end_block, BP, end_bp))
@@ -6861,18 +6888,10 @@ std::shared_ptr<GSTextureCache::Palette> GSTextureCache::LookupPaletteObject(con
 	return m_palette_map.LookupPalette(clut, pal, need_gs_texture);
 }
 
-void GSTextureCache::Read(Target* t, const GSVector4i& r)
+bool GSTextureCache::GetReadbackFormat(const Target* t, GSTexture::Format* fmt, ShaderConvert* shader)
 {
-	if ((!t->m_dirty.empty() && !t->m_dirty.GetTotalRect(t->m_TEX0, t->m_unscaled_size).rintersect(r).rempty()) || r.width() == 0 || r.height() == 0)
-		return;
-
-	const GIFRegTEX0& TEX0 = t->m_TEX0;
 	const bool is_depth = (t->m_type == DepthStencil);
-
-	GSTexture::Format fmt;
-	ShaderConvert ps_shader;
-	std::unique_ptr<GSDownloadTexture>* dltex;
-	switch (TEX0.PSM)
+	switch (t->m_TEX0.PSM)
 	{
 		case PSMCT32:
 		case PSMCT24:
@@ -6884,55 +6903,41 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 			// better than writing back FP values to local memory.
 			if (is_depth)
 			{
-				fmt = GSTexture::Format::UInt32;
-				ps_shader = ShaderConvert::FLOAT32_TO_32_BITS;
-				dltex = &m_uint32_download_texture;
+				*fmt = GSTexture::Format::UInt32;
+				*shader = ShaderConvert::FLOAT32_TO_32_BITS;
 			}
 			else
 			{
-				fmt = GSTexture::Format::Color;
-				if (t->m_rt_alpha_scale)
-					ps_shader = ShaderConvert::RTA_DECORRECTION;
-				else
-					ps_shader = ShaderConvert::COPY;
-
-				dltex = &m_color_download_texture;
+				*fmt = GSTexture::Format::Color;
+				*shader = t->m_rt_alpha_scale ? ShaderConvert::RTA_DECORRECTION : ShaderConvert::COPY;
 			}
 		}
-		break;
+		return true;
 
 		case PSMCT16:
 		case PSMCT16S:
 		case PSMZ16:
 		case PSMZ16S:
 		{
-			fmt = GSTexture::Format::UInt16;
-			ps_shader = is_depth ? ShaderConvert::FLOAT32_TO_16_BITS : ShaderConvert::RGBA8_TO_16_BITS;
-			dltex = &m_uint16_download_texture;
+			*fmt = GSTexture::Format::UInt16;
+			*shader = is_depth ? ShaderConvert::FLOAT32_TO_16_BITS : ShaderConvert::RGBA8_TO_16_BITS;
 		}
-		break;
+		return true;
 
 		default:
-			return;
-	}
-
-	// Don't overwrite bits which aren't used in the target's format.
-	// Stops Burnout 3's sky from breaking when flushing targets to local memory.
-	const u32 write_mask = (t->m_valid_rgb ? 0x00FFFFFFu : 0) | (t->m_valid_alpha_low ? 0x0F000000u : 0) | (t->m_valid_alpha_high ? 0xF0000000u : 0);
-	if (write_mask == 0)
-	{
-		DbgCon.Warning("Not reading back target %x PSM %s due to no write mask", TEX0.TBP0, GSUtil::GetPSMName(TEX0.PSM));
-		return;
+			return false;
 	}
+}
 
-	GL_PERF("TC: Read Back Target: (0x%x)[fmt: 0x%x]. Size %dx%d", TEX0.TBP0, TEX0.PSM, r.width(), r.height());
-
+bool GSTextureCache::CopyTargetToDownloadTexture(Target* t, const GSVector4i& r, GSTexture::Format fmt, ShaderConvert shader,
+	std::unique_ptr<GSDownloadTexture>* dltex)
+{
 	const GSVector4 src(GSVector4(r) * GSVector4(t->m_scale) / GSVector4(t->m_texture->GetSize()).xyxy());
 	const GSVector4i drc(0, 0, r.width(), r.height());
-	const bool direct_read = t->m_type == RenderTarget && t->m_scale == 1.0f && ps_shader == ShaderConvert::COPY;
+	const bool direct_read = t->m_type == RenderTarget && t->m_scale == 1.0f && shader == ShaderConvert::COPY;
 
 	if (!PrepareDownloadTexture(drc.z, drc.w, fmt, dltex))
-		return;
+		return false;
 
 	if (direct_read)
 	{
@@ -6943,7 +6948,7 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 		GSTexture* tmp = g_gs_device->CreateRenderTarget(drc.z, drc.w, fmt, false);
 		if (tmp)
 		{
-			g_gs_device->StretchRect(t->m_texture, src, tmp, GSVector4(drc), ps_shader, false);
+			g_gs_device->StretchRect(t->m_texture, src, tmp, GSVector4(drc), shader, false);
 			g_perfmon.Put(GSPerfMon::TextureCopies, 1);
 			dltex->get()->CopyFromTexture(drc, tmp, drc, 0, true);
 			g_gs_device->Recycle(tmp);
@@ -6951,18 +6956,18 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 		else
 		{
 			Console.Error("Failed to allocate temporary %dx%d target for read.", drc.z, drc.w);
-			return;
+			return false;
 		}
 	}
 
-	dltex->get()->Flush();
-	if (!dltex->get()->Map(drc))
-		return;
+	return true;
+}
 
+static void WriteReadbackToLocalMemory(const GIFRegTEX0& TEX0, const u8* src, u32 pitch, const GSVector4i& r, u32 write_mask)
+{
 	// Why does WritePixelNN() not take a const pointer?
 	const GSOffset off = g_gs_renderer->m_mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM);
-	u8* bits = const_cast<u8*>(dltex->get()->GetMapPointer());
-	const u32 pitch = dltex->get()->GetMapPitch();
+	u8* bits = const_cast<u8*>(src);
 
 	switch (TEX0.PSM)
 	{
@@ -6983,6 +6988,119 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 			Console.Error("Unknown PSM %u on Read", TEX0.PSM);
 			break;
 	}
+}
+
+u32 GSTextureCache::GetReadbackHistoryKey(const Target* t)
+{
+	return t->m_TEX0.TBP0 | (t->m_TEX0.TBW << 14) | (t->m_TEX0.PSM << 20) | (static_cast<u32>(t->m_type) << 26);
+}
+
+void GSTextureCache::QueueSpeculativeRead(Target* t)
+{
+	t->m_draws_since_read++;
+
+	if (!GSConfig.HWSpeculativeReadbacks || GSConfig.HWDownloadMode != GSHardwareDownloadMode::Enabled)
+		return;
+
+	const auto it = m_readback_history.find(GetReadbackHistoryKey(t));
+	if (it == m_readback_history.end() || it->second != t->m_draws_since_read)
+		return;
+
+	const GSVector4i r = t->m_drawn_since_read.rintersect(t->GetUnscaledRect());
+	GSTexture::Format fmt;
+	ShaderConvert shader;
+	if (r.rempty() || !GetReadbackFormat(t, &fmt, &shader))
+		return;
+
+	GL_PERF("TC: Speculative Read Back Target: (0x%x)[fmt: 0x%x]. Size %dx%d", t->m_TEX0.TBP0, t->m_TEX0.PSM, r.width(), r.height());
+
+	Target::SpeculativeRead& spec = t->m_speculative_read;
+	spec.valid = CopyTargetToDownloadTexture(t, r, fmt, shader, &spec.texture);
+	spec.source = t->m_texture;
+	spec.rect = r;
+	spec.shader = shader;
+	spec.draw = t->m_last_draw;
+}
+
+bool GSTextureCache::ReadSpeculative(Target* t, const GSVector4i& r, ShaderConvert shader, u32 write_mask)
+{
+	Target::SpeculativeRead& spec = t->m_speculative_read;
+	if (!spec.valid || spec.draw != t->m_last_draw || spec.source != t->m_texture || spec.shader != shader ||
+		!spec.rect.rintersect(r).eq(r))
+	{
+		return false;
+	}
+
+	GL_PERF("TC: Using Speculative Read Back: (0x%x)[fmt: 0x%x]. Size %dx%d", t->m_TEX0.TBP0, t->m_TEX0.PSM, r.width(), r.height());
+
+	// Usually already complete, in which case this doesn't wait.
+	GSDownloadTexture* dltex = spec.texture.get();
+	dltex->Flush();
+	if (!dltex->Map(GSVector4i(0, 0, spec.rect.width(), spec.rect.height())))
+		return false;
+
+	const u32 pitch = dltex->GetMapPitch();
+	const u32 bpp = GSTexture::GetCompressedBytesPerBlock(dltex->GetFormat());
+	const u8* bits = dltex->GetMapPointer() + (r.y - spec.rect.y) * pitch + (r.x - spec.rect.x) * bpp;
+	WriteReadbackToLocalMemory(t->m_TEX0, bits, pitch, r, write_mask);
+
+	dltex->Unmap();
+	return true;
+}
+
+void GSTextureCache::Read(Target* t, const GSVector4i& r)
+{
+	if ((!t->m_dirty.empty() && !t->m_dirty.GetTotalRect(t->m_TEX0, t->m_unscaled_size).rintersect(r).rempty()) || r.width() == 0 || r.height() == 0)
+		return;
+
+	const GIFRegTEX0& TEX0 = t->m_TEX0;
+
+	GSTexture::Format fmt;
+	ShaderConvert ps_shader;
+	if (!GetReadbackFormat(t, &fmt, &ps_shader))
+		return;
+
+	// Don't overwrite bits which aren't used in the target's format.
+	// Stops Burnout 3's sky from breaking when flushing targets to local memory.
+	const u32 write_mask = (t->m_valid_rgb ? 0x00FFFFFFu : 0) | (t->m_valid_alpha_low ? 0x0F000000u : 0) | (t->m_valid_alpha_high ? 0xF0000000u : 0);
+	if (write_mask == 0)
+	{
+		DbgCon.Warning("Not reading back target %x PSM %s due to no write mask", TEX0.TBP0, GSUtil::GetPSMName(TEX0.PSM));
+		return;
+	}
+
+	// Remember how many draws it took to get here, so next time the readback can be started early.
+	if (t->m_draws_since_read > 0)
+	{
+		if (m_readback_history.size() >= MAX_READBACK_HISTORY)
+			m_readback_history.clear();
+
+		m_readback_history[GetReadbackHistoryKey(t)] = t->m_draws_since_read;
+		t->m_draws_since_read = 0;
+	}
+
+	if (ReadSpeculative(t, r, ps_shader, write_mask))
+		return;
+
+	GL_PERF("TC: Read Back Target: (0x%x)[fmt: 0x%x]. Size %dx%d", TEX0.TBP0, TEX0.PSM, r.width(), r.height());
+
+	std::unique_ptr<GSDownloadTexture>* dltex;
+	if (fmt == GSTexture::Format::UInt32)
+		dltex = &m_uint32_download_texture;
+	else if (fmt == GSTexture::Format::UInt16)
+		dltex = &m_uint16_download_texture;
+	else
+		dltex = &m_color_download_texture;
+
+	if (!CopyTargetToDownloadTexture(t, r, fmt, ps_shader, dltex))
+		return;
+
+	const GSVector4i drc(0, 0, r.width(), r.height());
+	dltex->get()->Flush();
+	if (!dltex->get()->Map(drc))
+		return;
+
+	WriteReadbackToLocalMemory(TEX0, dltex->get()->GetMapPointer(), dltex->get()->GetMapPitch(), r, write_mask);
 
 	dltex->get()->Unmap();
 }
@@ -7388,6 +7506,10 @@ GSTextureCache::Target::Target(GIFRegTEX0 TEX0, int type, const GSVector2i& unsc
 		m_alpha_max = 0;
 	}
 	m_32_bits_fmt |= (GSLocalMemory::m_psm[TEX0.PSM].trbpp != 16);
+
+	m_indexed_begin_page = static_cast<u16>(m_TEX0.TBP0 >> 5);
+	m_indexed_end_page = m_indexed_begin_page;
+	g_texture_cache->m_dst_pages[m_type].Add(m_indexed_begin_page, m_indexed_end_page);
 }
 
 GSTextureCache::Target::~Target()
@@ -7395,6 +7517,8 @@ GSTextureCache::Target::~Target()
 	// Targets should never be shared.
 	pxAssert(!m_shared_texture);
 
+	g_texture_cache->m_dst_pages[m_type].Remove(m_indexed_begin_page, m_indexed_end_page);
+
 	if (m_texture)
 	{
 		g_texture_cache->m_target_memory_usage -= m_texture->GetMemUsage();
@@ -7447,6 +7571,8 @@ void GSTextureCache::Target::Update(bool cannot_scale)
 		return;
 	}
 
+	DiscardSpeculativeRead();
+
 	const GSVector4i t_offset(total_rect.xyxy());
 	const GSVector4i t_size(total_rect - t_offset);
 	const GSVector4 t_sizef(t_size.zwzw());
@@ -7715,6 +7841,8 @@ void GSTextureCache::Target::ResizeValidity(const GSVector4i& rect)
 
 	// Else No valid size, so need to resize down.
 
+	UpdatePageIndex();
+
 	// GL_CACHE("TC: ResizeValidity (0x%x->0x%x) from R:%d,%d Valid: %d,%d", m_TEX0.TBP0, m_end_block, rect.z, rect.w, m_valid.z, m_valid.w);
 }
 
@@ -7732,9 +7860,25 @@ void GSTextureCache::Target::UpdateValidity(const GSVector4i& rect, bool can_res
 
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
 	}
+
+	UpdatePageIndex();
 	// GL_CACHE("TC: UpdateValidity (0x%x->0x%x) from R:%d,%d Valid: %d,%d", m_TEX0.TBP0, m_end_block, rect.z, rect.w, m_valid.z, m_valid.w);
 }
 
+void GSTextureCache::Target::UpdatePageIndex()
+{
+	const u16 begin_page = static_cast<u16>(m_TEX0.TBP0 >> 5);
+	const u16 end_page = static_cast<u16>(std::min<u32>(UnwrappedEndBlock() >> 5, TargetPageMap::NUM_PAGES - 1));
+	if (begin_page == m_indexed_begin_page && end_page == m_indexed_end_page)
+		return;
+
+	TargetPageMap& map = g_texture_cache->m_dst_pages[m_type];
+	map.Remove(m_indexed_begin_page, m_indexed_end_page);
+	map.Add(begin_page, end_page);
+	m_indexed_begin_page = begin_page;
+	m_indexed_end_page = end_page;
+}
+
 bool GSTextureCache::Target::ResizeTexture(int new_unscaled_width, int new_unscaled_height, bool recycle_old, bool require_new_rect, GSVector4i new_rect, bool keep_old)
 {
 	const GSVector2i size = m_texture->GetSize();
@@ -7744,6 +7888,8 @@ bool GSTextureCache::Target::ResizeTexture(int new_unscaled_width, int new_unsca
 	if (size.x == new_size.x && size.y == new_size.y && !require_new_rect)
 		return true;
 
+	DiscardSpeculativeRead();
+
 	const bool clear = (new_size.x > size.x || new_size.y > size.y);
 
 	GSTexture* tex = m_texture->IsDepthStencil() ?
@@ -7892,6 +8038,49 @@ void GSTextureCache::SourceMap::RemoveAt(Source* s)
 	delete s;
 }
 
+// GSTextureCache::TargetPageMap
+
+void GSTextureCache::TargetPageMap::Add(u32 begin_page, u32 end_page)
+{
+	pxAssert(begin_page <= end_page && end_page < NUM_PAGES);
+	for (u32 page = begin_page; page <= end_page; page++)
+	{
+		if ((m_refs[page]++) == 0)
+			m_bits[page / 64] |= (1ULL << (page % 64));
+	}
+}
+
+void GSTextureCache::TargetPageMap::Remove(u32 begin_page, u32 end_page)
+{
+	pxAssert(begin_page <= end_page && end_page < NUM_PAGES);
+	for (u32 page = begin_page; page <= end_page; page++)
+	{
+		pxAssert(m_refs[page] > 0);
+		if ((--m_refs[page]) == 0)
+			m_bits[page / 64] &= ~(1ULL << (page % 64));
+	}
+}
+
+bool GSTextureCache::TargetPageMap::MayOverlap(u32 start_bp, u32 end_bp) const
+{
+	const u32 begin_page = std::min(start_bp >> 5, NUM_PAGES - 1);
+	const u32 end_page = std::min(std::max(start_bp, end_bp) >> 5, NUM_PAGES - 1);
+	const u32 begin_word = begin_page / 64;
+	const u32 end_word = end_page / 64;
+	for (u32 word = begin_word; word <= end_word; word++)
+	{
+		u64 mask = ~0ULL;
+		if (word == begin_word)
+			mask &= ~0ULL << (begin_page % 64);
+		if (word == end_word)
+			mask &= ~0ULL >> (63 - (end_page % 64));
+		if (m_bits[word] & mask)
+			return true;
+	}
+
+	return false;
+}
+
 void GSTextureCache::AttachPaletteToSource(Source* s, u16 pal, bool need_gs_texture, bool update_alpha_minmax)
 {
 	s->m_palette_obj = m_palette_map.LookupPalette(pal, need_gs_texture);
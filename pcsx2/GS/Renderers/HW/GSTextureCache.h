@@ -241,6 +241,19 @@ public:
 		GSVector4i m_valid{};
 		GSVector4i m_drawn_since_read{};
 		int readbacks_since_draw = 0;
+		int m_draws_since_read = 0;
+
+		/// Readback queued ahead of time at the end of a draw, which is only usable until the target is written again.
+		struct SpeculativeRead
+		{
+			std::unique_ptr<GSDownloadTexture> texture;
+			GSTexture* source = nullptr;
+			GSVector4i rect = {};
+			ShaderConvert shader = ShaderConvert::COPY;
+			int draw = 0;
+			bool valid = false;
+		};
+		SpeculativeRead m_speculative_read;
 
 	public:
 		Target(GIFRegTEX0 TEX0, int type, const GSVector2i& unscaled_size, float scale, GSTexture* texture);
@@ -270,8 +283,18 @@ public:
 		/// Resizes target texture, DOES NOT RESCALE.
 		bool ResizeTexture(int new_unscaled_width, int new_unscaled_height, bool recycle_old = true, bool require_offset = false, GSVector4i offset = GSVector4i::zero(), bool keep_old = false);
 
+		/// Re-registers the target in the cache's page map. Must be called whenever TBP0 or the end block changes.
+		void UpdatePageIndex();
+
+		/// Throws away any speculative readback, called when the texture is modified outside of a draw.
+		__fi void DiscardSpeculativeRead() { m_speculative_read.valid = false; }
+
 	private:
 		void UpdateTextureDebugName();
+
+		// Page range this target is currently registered under in m_dst_pages.
+		u16 m_indexed_begin_page = 0;
+		u16 m_indexed_end_page = 0;
 	};
 
 	class Source : public Surface
@@ -368,6 +391,26 @@ public:
 		void RemoveAt(Source* s);
 	};
 
+	/// Counts how many targets cover each page, so the target lists don't have to be walked for writes and
+	/// lookups which can't touch any of them. Pages are in unwrapped space, i.e. targets which wrap around the
+	/// end of memory extend past GS_MAX_PAGES, to match the UnwrappedEndBlock() overlap tests.
+	/// This only ever over-approximates, it doesn't say which targets overlap.
+	class TargetPageMap
+	{
+	public:
+		static constexpr u32 NUM_PAGES = GS_MAX_PAGES * 2;
+
+		void Add(u32 begin_page, u32 end_page);
+		void Remove(u32 begin_page, u32 end_page);
+
+		/// Returns true if any target might cover a block in [start_bp, end_bp].
+		bool MayOverlap(u32 start_bp, u32 end_bp) const;
+
+	private:
+		std::array<u16, NUM_PAGES> m_refs = {};
+		std::array<u64, NUM_PAGES / 64> m_bits = {};
+	};
+
 	struct TargetHeightElem
 	{
 		union
@@ -426,6 +469,7 @@ protected:
 	u64 m_hash_cache_replacement_memory_usage = 0;
 
 	FastList<Target*> m_dst[2];
+	TargetPageMap m_dst_pages[2];
 	FastList<TargetHeightElem> m_target_heights;
 	u64 m_target_memory_usage = 0;
 
@@ -445,6 +489,10 @@ protected:
 	std::unique_ptr<GSDownloadTexture> m_uint16_download_texture;
 	std::unique_ptr<GSDownloadTexture> m_uint32_download_texture;
 
+	// Number of draws each target was read back after, keyed by TBP0/TBW/PSM/type. Used to predict when to read back.
+	static constexpr size_t MAX_READBACK_HISTORY = 256;
+	std::unordered_map<u32, int> m_readback_history;
+
 	Source* CreateSource(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, Target* t, int x_offset, int y_offset, const GSVector2i* lod, const GSVector4i* src_range, GSTexture* gpu_clut, SourceRegion region);
 
 	bool PreloadTarget(GIFRegTEX0 TEX0, const GSVector2i& size, const GSVector2i& valid_size, bool is_frame,
@@ -460,6 +508,18 @@ protected:
 	/// Resizes the download texture if needed.
 	bool PrepareDownloadTexture(u32 width, u32 height, GSTexture::Format format, std::unique_ptr<GSDownloadTexture>* tex);
 
+	/// Returns the download format and conversion shader for reading back the target, false if it can't be read.
+	static bool GetReadbackFormat(const Target* t, GSTexture::Format* fmt, ShaderConvert* shader);
+
+	/// Queues a copy of r in the target to the download texture. Does not wait for it to complete.
+	bool CopyTargetToDownloadTexture(Target* t, const GSVector4i& r, GSTexture::Format fmt, ShaderConvert shader,
+		std::unique_ptr<GSDownloadTexture>* dltex);
+
+	/// Uses the target's speculative readback for r, if it's still current. Returns false if it needs a normal readback.
+	bool ReadSpeculative(Target* t, const GSVector4i& r, ShaderConvert shader, u32 write_mask);
+
+	static u32 GetReadbackHistoryKey(const Target* t);
+
 	HashCacheEntry* LookupHashCache(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool& paltex, const u32* clut, const GSVector2i* lod, SourceRegion region);
 	void RemoveFromHashCache(HashCacheMap::iterator it);
 	void AgeHashCache();
@@ -484,6 +544,9 @@ public:
 
 	void Read(Target* t, const GSVector4i& r);
 	void Read(Source* t, const GSVector4i& r);
+
+	/// Called at the end of a draw. Starts reading the target back if it was read back after this many draws before.
+	void QueueSpeculativeRead(Target* t);
 	void RemoveAll(bool sources, bool targets, bool hash_cache);
 	void ReadbackAll();
 	static void AddDirtyRectTarget(Target* target, GSVector4i rect, u32 psm, u32 bw, RGBAMask rgba, bool req_linear = false);
@@ -0,0 +1,423 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "GS/Renderers/HW/GSTextureReplacementArchive.h"
+
+#include "common/BitUtils.h"
+#include "common/Console.h"
+#include "common/Error.h"
+
+#ifdef _WIN32
+#include "common/RedtapeWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+GSTextureReplacementArchive::GSTextureReplacementArchive() = default;
+
+GSTextureReplacementArchive::~GSTextureReplacementArchive()
+{
+	Close();
+}
+
+bool GSTextureReplacementArchive::Open(const std::string& path, Error* error)
+{
+	Close();
+
+#ifdef _WIN32
+	const HANDLE file = CreateFileW(FileSystem::GetWin32Path(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		Error::SetWin32(error, "CreateFileW() failed: ", GetLastError());
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+	{
+		Error::SetWin32(error, "GetFileSizeEx() failed: ", GetLastError());
+		CloseHandle(file);
+		return false;
+	}
+
+	const HANDLE mapping = (size.QuadPart > 0) ? CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	CloseHandle(file);
+	if (!mapping)
+	{
+		Error::SetWin32(error, "CreateFileMappingW() failed: ", GetLastError());
+		return false;
+	}
+
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		Error::SetWin32(error, "MapViewOfFile() failed: ", GetLastError());
+		CloseHandle(mapping);
+		return false;
+	}
+
+	m_mapping_handle = mapping;
+	m_size = static_cast<size_t>(size.QuadPart);
+#else
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		Error::SetErrno(error, "open() failed: ", errno);
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0)
+	{
+		Error::SetErrno(error, "fstat() failed: ", errno);
+		close(fd);
+		return false;
+	}
+
+	// The mapping keeps its own reference to the file.
+	void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		Error::SetErrno(error, "mmap() failed: ", errno);
+		return false;
+	}
+
+	m_size = static_cast<size_t>(st.st_size);
+#endif
+
+	m_data = static_cast<const u8*>(data);
+
+	Header header;
+	if (m_size < sizeof(header))
+	{
+		Error::SetStringView(error, "File is too small.");
+		Close();
+		return false;
+	}
+
+	std::memcpy(&header, m_data, sizeof(header));
+	if (header.magic != MAGIC || header.version != VERSION)
+	{
+		Error::SetStringView(error, "Unknown archive format or version.");
+		Close();
+		return false;
+	}
+
+	if (header.entries_offset > m_size || (static_cast<u64>(header.num_entries) * sizeof(Entry)) > (m_size - header.entries_offset) ||
+		(header.entries_offset % alignof(Entry)) != 0 || header.names_offset > m_size ||
+		header.names_size > (m_size - header.names_offset))
+	{
+		Error::SetStringView(error, "Archive index is truncated.");
+		Close();
+		return false;
+	}
+
+	m_entries = reinterpret_cast<const Entry*>(m_data + header.entries_offset);
+	m_names = reinterpret_cast<const char*>(m_data + header.names_offset);
+	m_num_entries = header.num_entries;
+
+	// Check everything up front, so lookups don't have to.
+	for (u32 i = 0; i < m_num_entries; i++)
+	{
+		// Level sizes are shifted by the level index, so the level count has to be checked first.
+		const Entry& entry = m_entries[i];
+		if (entry.num_levels == 0 || entry.width == 0 || entry.height == 0 || entry.format > EntryFormat::BC7 ||
+			entry.num_levels > GetMaxLevels(entry.width, entry.height) ||
+			(static_cast<u64>(entry.name_offset) + entry.name_length) > header.names_size ||
+			entry.data_offset > m_size || GetEntryDataSize(entry) > (m_size - entry.data_offset))
+		{
+			Error::SetStringView(error, fmt::format("Entry {} is corrupted.", i));
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void GSTextureReplacementArchive::Close()
+{
+	if (!m_data)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle(m_mapping_handle);
+	m_mapping_handle = nullptr;
+#else
+	munmap(const_cast<u8*>(m_data), m_size);
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+	m_entries = nullptr;
+	m_names = nullptr;
+	m_num_entries = 0;
+}
+
+std::string_view GSTextureReplacementArchive::GetEntryName(u32 index) const
+{
+	const Entry& entry = m_entries[index];
+	return std::string_view(m_names + entry.name_offset, entry.name_length);
+}
+
+GSTexture::Format GSTextureReplacementArchive::GetTextureFormat(EntryFormat format)
+{
+	switch (format)
+	{
+		case EntryFormat::BC1:
+			return GSTexture::Format::BC1;
+		case EntryFormat::BC2:
+			return GSTexture::Format::BC2;
+		case EntryFormat::BC3:
+			return GSTexture::Format::BC3;
+		case EntryFormat::BC7:
+			return GSTexture::Format::BC7;
+		case EntryFormat::RGBA8:
+		default:
+			return GSTexture::Format::Color;
+	}
+}
+
+void GSTextureReplacementArchive::GetLevelLayout(EntryFormat format, u32 width, u32 height, u32* pitch, u32* rows)
+{
+	const GSTexture::Format tex_format = GetTextureFormat(format);
+	const u32 block_size = GSTexture::GetCompressedBlockSize(tex_format);
+	const u32 bytes_per_block = GSTexture::GetCompressedBytesPerBlock(tex_format);
+	*pitch = ((width + (block_size - 1)) / block_size) * bytes_per_block;
+	*rows = (height + (block_size - 1)) / block_size;
+}
+
+u64 GSTextureReplacementArchive::GetEntryDataSize(const Entry& entry)
+{
+	u64 size = 0;
+	for (u32 level = 0; level < entry.num_levels; level++)
+	{
+		u32 pitch, rows;
+		GetLevelLayout(entry.format, std::max(entry.width >> level, 1u), std::max(entry.height >> level, 1u), &pitch, &rows);
+		size += static_cast<u64>(pitch) * rows;
+	}
+
+	return size;
+}
+
+GSTextureReplacementArchive::Level GSTextureReplacementArchive::GetLevel(u32 index, u32 level) const
+{
+	const Entry& entry = m_entries[index];
+	pxAssert(level < entry.num_levels);
+
+	const u8* data = m_data + entry.data_offset;
+	for (u32 i = 0;; i++)
+	{
+		const u32 width = std::max(entry.width >> i, 1u);
+		const u32 height = std::max(entry.height >> i, 1u);
+		u32 pitch, rows;
+		GetLevelLayout(entry.format, width, height, &pitch, &rows);
+		if (i == level)
+			return Level{data, width, height, pitch};
+
+		data += static_cast<size_t>(pitch) * rows;
+	}
+}
+
+void GSTextureReplacementArchive::Prefetch(u32 index, u32 num_levels) const
+{
+	const Entry& entry = m_entries[index];
+	const Level last = GetLevel(index, std::min<u32>(num_levels, entry.num_levels) - 1);
+	u32 last_pitch, last_rows;
+	GetLevelLayout(entry.format, last.width, last.height, &last_pitch, &last_rows);
+
+	const u8* start = m_data + entry.data_offset;
+	const u8* end = last.data + static_cast<size_t>(last_pitch) * last_rows;
+
+	// Page size is at least 4K everywhere we run.
+	static constexpr size_t STRIDE = 4096;
+	volatile u8 sink = 0;
+	for (const u8* ptr = start; ptr < end; ptr += STRIDE)
+		sink = sink + *ptr;
+	sink = sink + *(end - 1);
+}
+
+void GSTextureReplacementArchive::Load(u32 index, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image) const
+{
+	const Entry& entry = m_entries[index];
+	const u32 num_levels = only_base_image ? 1u : entry.num_levels;
+
+	tex->width = entry.width;
+	tex->height = entry.height;
+	tex->format = GetTextureFormat(entry.format);
+	tex->alpha_minmax = std::make_pair(entry.alpha_min, entry.alpha_max);
+	tex->mips.clear();
+
+	for (u32 level = 0; level < num_levels; level++)
+	{
+		const Level lv = GetLevel(index, level);
+		u32 pitch, rows;
+		GetLevelLayout(entry.format, lv.width, lv.height, &pitch, &rows);
+
+		std::vector<u8>* data;
+		if (level == 0)
+		{
+			tex->pitch = pitch;
+			data = &tex->data;
+		}
+		else
+		{
+			GSTextureReplacements::ReplacementTexture::MipData& md = tex->mips.emplace_back();
+			md.width = lv.width;
+			md.height = lv.height;
+			md.pitch = pitch;
+			data = &md.data;
+		}
+
+		data->resize(static_cast<size_t>(pitch) * rows);
+		std::memcpy(data->data(), lv.data, data->size());
+	}
+}
+
+GSTextureReplacementArchive::Writer::Writer() = default;
+
+GSTextureReplacementArchive::Writer::~Writer() = default;
+
+bool GSTextureReplacementArchive::Writer::Create(const std::string& path, Error* error)
+{
+	m_fp = FileSystem::OpenManagedCFile(path.c_str(), "wb", error);
+	if (!m_fp)
+		return false;
+
+	// Header gets filled in once we know where the index is.
+	const Header header = {};
+	m_entries.clear();
+	m_names.clear();
+	m_offset = 0;
+	return Write(&header, sizeof(header), error);
+}
+
+bool GSTextureReplacementArchive::Writer::Write(const void* data, size_t size, Error* error)
+{
+	if (size > 0 && std::fwrite(data, size, 1, m_fp.get()) != 1)
+	{
+		Error::SetErrno(error, "fwrite() failed: ", errno);
+		return false;
+	}
+
+	m_offset += size;
+	return true;
+}
+
+bool GSTextureReplacementArchive::Writer::AddEntry(std::string_view name, const GSTextureReplacements::ReplacementTexture& tex, Error* error)
+{
+	Entry entry = {};
+	switch (tex.format)
+	{
+		case GSTexture::Format::Color:
+			entry.format = EntryFormat::RGBA8;
+			break;
+		case GSTexture::Format::BC1:
+			entry.format = EntryFormat::BC1;
+			break;
+		case GSTexture::Format::BC2:
+			entry.format = EntryFormat::BC2;
+			break;
+		case GSTexture::Format::BC3:
+			entry.format = EntryFormat::BC3;
+			break;
+		case GSTexture::Format::BC7:
+			entry.format = EntryFormat::BC7;
+			break;
+		default:
+			Error::SetStringView(error, "Unsupported texture format.");
+			return false;
+	}
+
+	if (name.size() > std::numeric_limits<u16>::max() || tex.mips.size() >= GetMaxLevels(tex.width, tex.height))
+	{
+		Error::SetStringView(error, "Name or mip count too large.");
+		return false;
+	}
+
+	static constexpr u8 zero_pad[16] = {};
+	if (!Write(zero_pad, Common::AlignUpPow2(m_offset, 16) - m_offset, error))
+		return false;
+
+	entry.data_offset = m_offset;
+	entry.name_offset = static_cast<u32>(m_names.size());
+	entry.name_length = static_cast<u16>(name.size());
+	entry.num_levels = static_cast<u8>(tex.mips.size() + 1);
+	entry.width = tex.width;
+	entry.height = tex.height;
+	entry.alpha_min = tex.alpha_minmax.first;
+	entry.alpha_max = tex.alpha_minmax.second;
+
+	// Repack each level tightly, the loaders can leave padding on the end of rows.
+	for (u32 level = 0; level < entry.num_levels; level++)
+	{
+		const u32 width = std::max(entry.width >> level, 1u);
+		const u32 height = std::max(entry.height >> level, 1u);
+		const u8* src = (level == 0) ? tex.data.data() : tex.mips[level - 1].data.data();
+		const u32 src_pitch = (level == 0) ? tex.pitch : tex.mips[level - 1].pitch;
+		const size_t src_size = (level == 0) ? tex.data.size() : tex.mips[level - 1].data.size();
+		if ((level > 0 && (tex.mips[level - 1].width != width || tex.mips[level - 1].height != height)))
+		{
+			Error::SetStringView(error, "Mip level has unexpected dimensions.");
+			return false;
+		}
+
+		u32 pitch, rows;
+		GetLevelLayout(entry.format, width, height, &pitch, &rows);
+		if (src_pitch < pitch || src_size < (static_cast<size_t>(src_pitch) * (rows - 1) + pitch))
+		{
+			Error::SetStringView(error, "Level data is smaller than its dimensions.");
+			return false;
+		}
+
+		for (u32 row = 0; row < rows; row++)
+		{
+			if (!Write(src + static_cast<size_t>(row) * src_pitch, pitch, error))
+				return false;
+		}
+	}
+
+	m_names.append(name);
+	m_entries.push_back(entry);
+	return true;
+}
+
+bool GSTextureReplacementArchive::Writer::Finish(Error* error)
+{
+	static constexpr u8 zero_pad[16] = {};
+	if (!Write(zero_pad, Common::AlignUpPow2(m_offset, 16) - m_offset, error))
+		return false;
+
+	Header header = {};
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.num_entries = static_cast<u32>(m_entries.size());
+	header.names_size = static_cast<u32>(m_names.size());
+	header.entries_offset = m_offset;
+	header.names_offset = m_offset + m_entries.size() * sizeof(Entry);
+
+	if (!Write(m_entries.data(), m_entries.size() * sizeof(Entry), error) ||
+		!Write(m_names.data(), m_names.size(), error))
+	{
+		return false;
+	}
+
+	if (FileSystem::FSeek64(m_fp.get(), 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, m_fp.get()) != 1 ||
+		std::fflush(m_fp.get()) != 0)
+	{
+		Error::SetErrno(error, "Failed to write header: ", errno);
+		return false;
+	}
+
+	m_fp.reset();
+	return true;
+}
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/Renderers/HW/GSTextureReplacements.h"
+
+#include "common/FileSystem.h"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Error;
+
+// --------------------------------------------------------------------------------------
+//  GSTextureReplacementArchive
+// --------------------------------------------------------------------------------------
+// Single-file container for a game's replacement textures. Each entry holds every level of
+// one texture in the format it's uploaded in (RGBA8 or BC1/2/3/7), packed tightly, along with
+// its precomputed alpha range. The file is memory mapped, so entries are only paged in when used.
+//
+// Layout: Header, level data for each entry (16 byte aligned), entry table, name table.
+//
+class GSTextureReplacementArchive
+{
+	DeclareNoncopyableObject(GSTextureReplacementArchive);
+
+public:
+	static constexpr u32 MAGIC = 0x41545350; // PSTA
+	static constexpr u32 VERSION = 1;
+
+	enum class EntryFormat : u8
+	{
+		RGBA8,
+		BC1,
+		BC2,
+		BC3,
+		BC7,
+	};
+
+	struct Header
+	{
+		u32 magic;
+		u32 version;
+		u32 num_entries;
+		u32 names_size;
+		u64 entries_offset;
+		u64 names_offset;
+	};
+	static_assert(sizeof(Header) == 32);
+
+	struct Entry
+	{
+		u64 data_offset;
+		u32 name_offset;
+		u16 name_length;
+		EntryFormat format;
+		u8 num_levels;
+		u32 width;
+		u32 height;
+		u8 alpha_min;
+		u8 alpha_max;
+		u8 pad[6];
+	};
+	static_assert(sizeof(Entry) == 32);
+
+	struct Level
+	{
+		const u8* data;
+		u32 width;
+		u32 height;
+		u32 pitch;
+	};
+
+	GSTextureReplacementArchive();
+	~GSTextureReplacementArchive();
+
+	__fi bool IsOpen() const { return (m_data != nullptr); }
+	__fi u32 GetEntryCount() const { return m_num_entries; }
+	__fi const Entry& GetEntry(u32 index) const { return m_entries[index]; }
+
+	bool Open(const std::string& path, Error* error);
+	void Close();
+
+	std::string_view GetEntryName(u32 index) const;
+	static GSTexture::Format GetTextureFormat(EntryFormat format);
+
+	/// Returns where a level of the entry lives in the mapping.
+	Level GetLevel(u32 index, u32 level) const;
+
+	/// Reads every page of the entry's first num_levels levels, so uploading doesn't stall on disk.
+	void Prefetch(u32 index, u32 num_levels) const;
+
+	/// Copies the entry out of the mapping.
+	void Load(u32 index, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image) const;
+
+	/// Writes a new archive, from already loaded replacement textures.
+	class Writer
+	{
+	public:
+		Writer();
+		~Writer();
+
+		bool Create(const std::string& path, Error* error);
+		bool AddEntry(std::string_view name, const GSTextureReplacements::ReplacementTexture& tex, Error* error);
+		bool Finish(Error* error);
+
+		__fi u32 GetEntryCount() const { return static_cast<u32>(m_entries.size()); }
+
+	private:
+		bool Write(const void* data, size_t size, Error* error);
+
+		FileSystem::ManagedCFilePtr m_fp;
+		std::vector<Entry> m_entries;
+		std::string m_names;
+		u64 m_offset = 0;
+	};
+
+private:
+	/// Levels are halved until both dimensions reach 1, so there can't be more than this.
+	static constexpr u32 GetMaxLevels(u32 width, u32 height) { return static_cast<u32>(std::bit_width(std::max(width, height))); }
+
+	static void GetLevelLayout(EntryFormat format, u32 width, u32 height, u32* pitch, u32* rows);
+	static u64 GetEntryDataSize(const Entry& entry);
+
+	const u8* m_data = nullptr;
+	size_t m_size = 0;
+	const Entry* m_entries = nullptr;
+	const char* m_names = nullptr;
+	u32 m_num_entries = 0;
+
+#ifdef _WIN32
+	void* m_mapping_handle = nullptr;
+#endif
+};
@@ -3,6 +3,7 @@
 
 #include "common/AlignedMalloc.h"
 #include "common/Console.h"
+#include "common/Error.h"
 #include "common/HashCombine.h"
 #include "common/FileSystem.h"
 #include "common/Path.h"
@@ -15,6 +16,8 @@
 #include "IconsFontAwesome6.h"
 #include "GS/GSExtra.h"
 #include "GS/GSLocalMemory.h"
+#include "GS/GSWorkStealingPool.h"
+#include "GS/Renderers/HW/GSTextureReplacementArchive.h"
 #include "GS/Renderers/HW/GSTextureReplacements.h"
 #include "VMManager.h"
 
@@ -22,8 +25,8 @@
 #include "pcsx2-winrt/UWPUtils.h"
 #endif
 
+#include <algorithm>
 #include <cinttypes>
-#include <condition_variable>
 #include <cstring>
 #include <deque>
 #include <functional>
@@ -42,6 +45,7 @@
 #define TEXTURE_FILENAME_OLD_REGION_CLUT_FORMAT_STRING "%" PRIx64 "-%" PRIx64 "-r%" PRIx64 "-%08x"
 #define TEXTURE_REPLACEMENT_SUBDIRECTORY_NAME "replacements"
 #define TEXTURE_DUMP_SUBDIRECTORY_NAME "dumps"
+#define TEXTURE_REPLACEMENT_ARCHIVE_NAME "replacements.pack"
 
 namespace
 {
@@ -104,6 +108,13 @@ namespace std
 
 namespace GSTextureReplacements
 {
+	/// Where a replacement lives, either a loose file, or an entry in the game's archive.
+	struct ReplacementSource
+	{
+		std::string filename;
+		s32 archive_entry = -1;
+	};
+
 	static TextureName CreateTextureName(const GSTextureCache::HashCacheKey& hash, u32 miplevel);
 	static GSTextureCache::HashCacheKey HashCacheKeyFromTextureName(const TextureName& tn);
 	static std::optional<TextureName> ParseReplacementName(const std::string& filename);
@@ -112,16 +123,19 @@ namespace GSTextureReplacements
 	template <GSTexture::Format format>
 	std::pair<u8, u8> GetBCAlphaMinMax(ReplacementTexture& rtex);
 	static void SetReplacementTextureAlphaMinMax(ReplacementTexture& rtex);
-	static std::optional<ReplacementTexture> LoadReplacementTexture(const TextureName& name, const std::string& filename, bool only_base_image);
-	static void QueueAsyncReplacementTextureLoad(const TextureName& name, const std::string& filename, bool mipmap, bool cache_only);
+	static std::optional<ReplacementTexture> LoadReplacementTexture(const ReplacementSource& source, bool only_base_image);
+	static void QueueAsyncReplacementTextureLoad(const TextureName& name, const ReplacementSource& source, bool mipmap, bool cache_only);
 	static void PrecacheReplacementTextures();
 	static void ClearReplacementTextures();
-
-	static void StartWorkerThread();
-	static void StopWorkerThread();
-	static void QueueWorkerThreadItem(std::function<void()> fn, bool high_priority);
-	static void WorkerThreadEntryPoint();
-	static void SyncWorkerThread();
+	static void WarnCompressedWithoutMipmaps();
+	static GSTexture* CreateArchiveReplacementTexture(u32 index, bool mipmap);
+
+	static u32 GetWorkerThreadCount();
+	static void StartWorkerPool();
+	static void StopWorkerPool();
+	static void QueueWorkerItem(std::function<void()> fn, bool high_priority);
+	static void RunWorkerItems(void* arg, u32 index);
+	static void SyncWorkerPool();
 	static void CancelPendingLoadsAndDumps();
 
 	static std::string s_current_serial;
@@ -130,7 +144,10 @@ namespace GSTextureReplacements
 	static std::unordered_set<TextureName> s_dumped_textures;
 
 	/// Lookup map of texture names to replacements, if they exist.
-	static std::unordered_map<TextureName, std::string> s_replacement_texture_filenames;
+	static std::unordered_map<TextureName, ReplacementSource> s_replacement_texture_sources;
+
+	/// Packed replacements for the current game, used instead of the replacements directory when present.
+	static GSTextureReplacementArchive s_replacement_archive;
 
 	/// Lookup map of texture names without CLUT hash, to know when we need to disable paltex.
 	static std::unordered_set<TextureName> s_replacement_textures_without_clut_hash;
@@ -146,12 +163,16 @@ namespace GSTextureReplacements
 	/// Second element is whether the texture should be created with mipmaps.
 	static std::vector<std::pair<TextureName, bool>> s_async_loaded_textures;
 
-	/// Loader/dumper thread.
-	static std::thread s_worker_thread;
-	static std::mutex s_worker_thread_mutex;
-	static std::condition_variable s_worker_thread_cv;
-	static std::deque<std::pair<std::function<void()>, bool>> s_worker_thread_queue;
-	static bool s_worker_thread_running = false;
+	/// Loading and dumping runs on a job pool, PNG decoding is slow enough that one thread can't keep up with a busy
+	/// scene. Items wait in the queue in priority order, and up to one job per pool thread drains it.
+	static std::unique_ptr<GSWorkStealingPool> s_worker_pool;
+	static std::mutex s_worker_queue_mutex;
+	static std::deque<std::pair<std::function<void()>, bool>> s_worker_queue;
+	static u32 s_worker_jobs_running = 0;
+	static GSJobCounter s_worker_jobs_counter;
+
+	/// Every job is the same, so they can all share one.
+	static GSJob s_worker_job = {&RunWorkerItems, nullptr, 0, &s_worker_jobs_counter};
 }; // namespace GSTextureReplacements
 
 TextureName GSTextureReplacements::CreateTextureName(const GSTextureCache::HashCacheKey& hash, u32 miplevel)
@@ -347,7 +368,7 @@ void GSTextureReplacements::Initialize()
 	s_current_serial = VMManager::GetDiscSerial();
 
 	if (GSConfig.DumpReplaceableTextures || GSConfig.LoadTextureReplacements)
-		StartWorkerThread();
+		StartWorkerPool();
 
 	ReloadReplacementMap();
 }
@@ -387,12 +408,13 @@ static bool GetWrongCasePath(std::string* output, const char* dir, std::string_v
 
 void GSTextureReplacements::ReloadReplacementMap()
 {
-	SyncWorkerThread();
+	SyncWorkerPool();
 
 	// clear out the caches
 	{
-		s_replacement_texture_filenames.clear();
+		s_replacement_texture_sources.clear();
 		s_replacement_textures_without_clut_hash.clear();
+		s_replacement_archive.Close();
 
 		std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
 		s_replacement_texture_cache.clear();
@@ -425,31 +447,59 @@ void GSTextureReplacements::ReloadReplacementMap()
 			Host::OSD_WARNING_DURATION);
 	}
 
-	if (!FileSystem::FindFiles(replacement_dir.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE, &files))
-		return;
+	const auto add_replacement = [](TextureName name, ReplacementSource source) {
+		s_replacement_texture_sources.emplace(name, std::move(source));
 
-	std::string filename;
-	for (FILESYSTEM_FIND_DATA& fd : files)
+		// zero out the CLUT hash, because we need this for checking if there's any replacements with this hash when using paltex
+		name.CLUTHash = 0;
+		s_replacement_textures_without_clut_hash.insert(name);
+	};
+
+	// a packed archive replaces the directory entirely, rather than mixing the two
+	const std::string archive_path(Path::Combine(texture_dir, TEXTURE_REPLACEMENT_ARCHIVE_NAME));
+	if (FileSystem::FileExists(archive_path.c_str()))
 	{
-		// file format we can handle?
-		filename = Path::GetFileName(fd.FileName);
-		if (!GetLoader(filename))
-			continue;
+		Error error;
+		if (s_replacement_archive.Open(archive_path, &error))
+		{
+			for (u32 i = 0; i < s_replacement_archive.GetEntryCount(); i++)
+			{
+				const std::optional<TextureName> name = ParseReplacementName(std::string(s_replacement_archive.GetEntryName(i)));
+				if (name.has_value())
+					add_replacement(name.value(), ReplacementSource{std::string(), static_cast<s32>(i)});
+			}
 
-		// parse the name if it's valid
-		std::optional<TextureName> name = ParseReplacementName(filename);
-		if (!name.has_value())
-			continue;
+			Console.WriteLn("Using %zu replacement textures from '%s', files in '%s' will be ignored.",
+				s_replacement_texture_sources.size(), archive_path.c_str(), replacement_dir.c_str());
+		}
+		else
+		{
+			Console.Error(fmt::format("Failed to open texture replacement archive '{}': {}", archive_path, error.GetDescription()));
+		}
+	}
+
+	if (!s_replacement_archive.IsOpen() &&
+		FileSystem::FindFiles(replacement_dir.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE, &files))
+	{
+		std::string filename;
+		for (FILESYSTEM_FIND_DATA& fd : files)
+		{
+			// file format we can handle?
+			filename = Path::GetFileName(fd.FileName);
+			if (!GetLoader(filename))
+				continue;
 
-		DbgCon.WriteLn("Found %ux%u replacement '%.*s'", name->Width(), name->Height(), static_cast<int>(filename.size()), filename.data());
-		s_replacement_texture_filenames.emplace(name.value(), std::move(fd.FileName));
+			// parse the name if it's valid
+			std::optional<TextureName> name = ParseReplacementName(filename);
+			if (!name.has_value())
+				continue;
 
-		// zero out the CLUT hash, because we need this for checking if there's any replacements with this hash when using paltex
-		name->CLUTHash = 0;
-		s_replacement_textures_without_clut_hash.insert(name.value());
+			DbgCon.WriteLn("Found %ux%u replacement '%.*s'", name->Width(), name->Height(), static_cast<int>(filename.size()), filename.data());
+			add_replacement(name.value(), ReplacementSource{std::move(fd.FileName)});
+		}
 	}
 
-	if (!s_replacement_texture_filenames.empty())
+	if (!s_replacement_texture_sources.empty())
 	{
 		if (GSConfig.PrecacheTextureReplacements)
 			PrecacheReplacementTextures();
@@ -465,11 +515,11 @@ void GSTextureReplacements::ReloadReplacementMap()
 
 void GSTextureReplacements::UpdateConfig(Pcsx2Config::GSOptions& old_config)
 {
-	// get rid of worker thread if it's no longer needed
-	if (s_worker_thread_running && !GSConfig.DumpReplaceableTextures && !GSConfig.LoadTextureReplacements)
-		StopWorkerThread();
-	if (!s_worker_thread_running && (GSConfig.DumpReplaceableTextures || GSConfig.LoadTextureReplacements))
-		StartWorkerThread();
+	// get rid of the worker pool if it's no longer needed
+	if (s_worker_pool && !GSConfig.DumpReplaceableTextures && !GSConfig.LoadTextureReplacements)
+		StopWorkerPool();
+	if (!s_worker_pool && (GSConfig.DumpReplaceableTextures || GSConfig.LoadTextureReplacements))
+		StartWorkerPool();
 
 	if ((!GSConfig.DumpReplaceableTextures && old_config.DumpReplaceableTextures) ||
 		(!GSConfig.LoadTextureReplacements && old_config.LoadTextureReplacements))
@@ -491,7 +541,7 @@ void GSTextureReplacements::UpdateConfig(Pcsx2Config::GSOptions& old_config)
 
 void GSTextureReplacements::Shutdown()
 {
-	StopWorkerThread();
+	StopWorkerPool();
 
 	std::string().swap(s_current_serial);
 	ClearReplacementTextures();
@@ -505,7 +555,7 @@ u32 GSTextureReplacements::CalcMipmapLevelsForReplacement(u32 width, u32 height)
 
 bool GSTextureReplacements::HasAnyReplacementTextures()
 {
-	return !s_replacement_texture_filenames.empty();
+	return !s_replacement_texture_sources.empty();
 }
 
 bool GSTextureReplacements::HasReplacementTextureWithOtherPalette(const GSTextureCache::HashCacheKey& hash)
@@ -521,8 +571,8 @@ GSTexture* GSTextureReplacements::LookupReplacementTexture(const GSTextureCache:
 	*pending = false;
 
 	// replacement for this name exists?
-	auto fnit = s_replacement_texture_filenames.find(name);
-	if (fnit == s_replacement_texture_filenames.end())
+	auto fnit = s_replacement_texture_sources.find(name);
+	if (fnit == s_replacement_texture_sources.end())
 		return nullptr;
 
 	// try the full cache first, to avoid reloading from disk
@@ -547,10 +597,17 @@ GSTexture* GSTextureReplacements::LookupReplacementTexture(const GSTextureCache:
 		*pending = true;
 		return nullptr;
 	}
+	else if (fnit->second.archive_entry >= 0)
+	{
+		// already in memory (or at least mapped), no point keeping another copy around
+		const GSTextureReplacementArchive::Entry& entry = s_replacement_archive.GetEntry(static_cast<u32>(fnit->second.archive_entry));
+		*alpha_minmax = std::make_pair(entry.alpha_min, entry.alpha_max);
+		return CreateArchiveReplacementTexture(static_cast<u32>(fnit->second.archive_entry), mipmap);
+	}
 	else
 	{
 		// synchronous load
-		std::optional<ReplacementTexture> replacement(LoadReplacementTexture(name, fnit->second, !mipmap));
+		std::optional<ReplacementTexture> replacement(LoadReplacementTexture(fnit->second, !mipmap));
 		if (!replacement.has_value())
 			return nullptr;
 
@@ -641,16 +698,23 @@ void GSTextureReplacements::SetReplacementTextureAlphaMinMax(ReplacementTexture&
 	}
 }
 
-std::optional<GSTextureReplacements::ReplacementTexture> GSTextureReplacements::LoadReplacementTexture(const TextureName& name, const std::string& filename, bool only_base_image)
+std::optional<GSTextureReplacements::ReplacementTexture> GSTextureReplacements::LoadReplacementTexture(const ReplacementSource& source, bool only_base_image)
 {
-	ReplacementTextureLoader loader = GetLoader(filename);
+	ReplacementTexture rtex;
+	if (source.archive_entry >= 0)
+	{
+		// alpha range was worked out when the archive was built
+		s_replacement_archive.Load(static_cast<u32>(source.archive_entry), &rtex, only_base_image);
+		return rtex;
+	}
+
+	ReplacementTextureLoader loader = GetLoader(source.filename);
 	if (!loader)
 		return std::nullopt;
 
-	ReplacementTexture rtex;
-	if (!loader(filename.c_str(), &rtex, only_base_image))
+	if (!loader(source.filename.c_str(), &rtex, only_base_image))
 	{
-		Console.Warning("Failed to load replacement texture %s", filename.c_str());
+		Console.Warning("Failed to load replacement texture %s", source.filename.c_str());
 		return std::nullopt;
 	}
 
@@ -659,7 +723,7 @@ std::optional<GSTextureReplacements::ReplacementTexture> GSTextureReplacements::
 	return rtex;
 }
 
-void GSTextureReplacements::QueueAsyncReplacementTextureLoad(const TextureName& name, const std::string& filename, bool mipmap, bool cache_only)
+void GSTextureReplacements::QueueAsyncReplacementTextureLoad(const TextureName& name, const ReplacementSource& source, bool mipmap, bool cache_only)
 {
 	// check the pending list, so we don't queue it up multiple times
 	auto it = s_pending_async_load_textures.find(name);
@@ -678,9 +742,9 @@ void GSTextureReplacements::QueueAsyncReplacementTextureLoad(const TextureName&
 	}
 
 	s_pending_async_load_textures.emplace(name, cache_only);
-	QueueWorkerThreadItem([name, filename, mipmap]() {
+	QueueWorkerItem([name, source, mipmap]() {
 		// actually load the file, this is what will take the time
-		std::optional<ReplacementTexture> replacement(LoadReplacementTexture(name, filename, !mipmap));
+		std::optional<ReplacementTexture> replacement(LoadReplacementTexture(source, !mipmap));
 
 		// check the pending set, there's a race here if we disable replacements while loading otherwise
 		// also check the full replacement list, if async loading is off, it might already be in there
@@ -718,7 +782,7 @@ void GSTextureReplacements::PrecacheReplacementTextures()
 	const bool mipmap = GSConfig.HWMipmap || GSConfig.TriFilter == TriFiltering::Forced;
 
 	// pretty simple, just go through the filenames and if any aren't cached, cache them
-	for (const auto& it : s_replacement_texture_filenames)
+	for (const auto& it : s_replacement_texture_sources)
 	{
 		if (s_replacement_texture_cache.find(it.first) != s_replacement_texture_cache.end())
 			continue;
@@ -730,8 +794,12 @@ void GSTextureReplacements::PrecacheReplacementTextures()
 
 void GSTextureReplacements::ClearReplacementTextures()
 {
-	s_replacement_texture_filenames.clear();
+	// workers could still be reading from the archive
+	SyncWorkerPool();
+
+	s_replacement_texture_sources.clear();
 	s_replacement_textures_without_clut_hash.clear();
+	s_replacement_archive.Close();
 
 	std::unique_lock<std::mutex> lock(s_replacement_texture_cache_mutex);
 	s_replacement_texture_cache.clear();
@@ -745,17 +813,7 @@ GSTexture* GSTextureReplacements::CreateReplacementTexture(const ReplacementText
 	// in the future I guess we could decompress the dds and generate them... but there's no reason that modders can't generate mips in dds
 	if (mipmap && GSTexture::IsCompressedFormat(rtex.format) && rtex.mips.empty())
 	{
-		static bool log_once = false;
-		if (!log_once)
-		{
-			Console.Warning("Disabling autogenerated mipmaps on one or more compressed replacement textures.");
-			Host::AddIconOSDMessage("DisablingReplacementAutoGeneratedMipmap", ICON_FA_CIRCLE_EXCLAMATION,
-				TRANSLATE_SV("GS", "Disabling autogenerated mipmaps on one or more compressed replacement textures. "
-								   "Please generate mipmaps when compressing your textures."),
-				Host::OSD_WARNING_DURATION);
-			log_once = true;
-		}
-
+		WarnCompressedWithoutMipmaps();
 		mipmap = false;
 	}
 
@@ -779,6 +837,43 @@ GSTexture* GSTextureReplacements::CreateReplacementTexture(const ReplacementText
 	return tex;
 }
 
+void GSTextureReplacements::WarnCompressedWithoutMipmaps()
+{
+	static bool log_once = false;
+	if (log_once)
+		return;
+
+	Console.Warning("Disabling autogenerated mipmaps on one or more compressed replacement textures.");
+	Host::AddIconOSDMessage("DisablingReplacementAutoGeneratedMipmap", ICON_FA_CIRCLE_EXCLAMATION,
+		TRANSLATE_SV("GS", "Disabling autogenerated mipmaps on one or more compressed replacement textures. "
+						   "Please generate mipmaps when compressing your textures."),
+		Host::OSD_WARNING_DURATION);
+	log_once = true;
+}
+
+GSTexture* GSTextureReplacements::CreateArchiveReplacementTexture(u32 index, bool mipmap)
+{
+	const GSTextureReplacementArchive::Entry& entry = s_replacement_archive.GetEntry(index);
+	const GSTexture::Format format = GSTextureReplacementArchive::GetTextureFormat(entry.format);
+	if (mipmap && GSTexture::IsCompressedFormat(format) && entry.num_levels == 1)
+		WarnCompressedWithoutMipmaps();
+
+	// same as a loaded replacement, only include the mips when they're going to be used
+	const u32 num_levels = mipmap ? entry.num_levels : 1;
+	GSTexture* tex = g_gs_device->CreateTexture(entry.width, entry.height, static_cast<int>(num_levels), format);
+	if (!tex)
+		return nullptr;
+
+	// upload straight from the mapping
+	for (u32 i = 0; i < num_levels; i++)
+	{
+		const GSTextureReplacementArchive::Level level = s_replacement_archive.GetLevel(index, i);
+		tex->Update(GSVector4i(0, 0, static_cast<int>(level.width), static_cast<int>(level.height)), level.data, level.pitch, i);
+	}
+
+	return tex;
+}
+
 void GSTextureReplacements::ProcessAsyncLoadedTextures()
 {
 	// this holds the lock while doing the upload, but it should be reasonably quick
@@ -815,7 +910,7 @@ void GSTextureReplacements::DumpTexture(const GSTextureCache::HashCacheKey& hash
 {
 	// check if it's been dumped or replaced already
 	const TextureName name(CreateTextureName(hash, level));
-	if (s_dumped_textures.find(name) != s_dumped_textures.end() || s_replacement_texture_filenames.find(name) != s_replacement_texture_filenames.end())
+	if (s_dumped_textures.find(name) != s_dumped_textures.end() || s_replacement_texture_sources.find(name) != s_replacement_texture_sources.end())
 		return;
 
 	s_dumped_textures.insert(name);
@@ -846,7 +941,7 @@ void GSTextureReplacements::DumpTexture(const GSTextureCache::HashCacheKey& hash
 
 	// okay, now we can actually dump it
 	const u32 buffer_offset = ((rect.top - block_rect.top) * pitch) + ((rect.left - block_rect.left) * sizeof(u32));
-	QueueWorkerThreadItem([filename = std::move(filename), tw, th, pitch, buffer, buffer_offset]() {
+	QueueWorkerItem([filename = std::move(filename), tw, th, pitch, buffer, buffer_offset]() {
 		if (!SavePNGImage(filename.c_str(), tw, th, buffer + buffer_offset, pitch))
 			Console.Error(fmt::format("Failed to dump texture to '{}'.", filename));
 		_aligned_free(buffer);
@@ -858,52 +953,120 @@ void GSTextureReplacements::ClearDumpedTextureList()
 	s_dumped_textures.clear();
 }
 
+bool GSTextureReplacements::BuildReplacementArchive(const std::string& texture_dir, Error* error)
+{
+	const std::string replacement_dir(Path::Combine(texture_dir, TEXTURE_REPLACEMENT_SUBDIRECTORY_NAME));
+	const std::string archive_path(Path::Combine(texture_dir, TEXTURE_REPLACEMENT_ARCHIVE_NAME));
+
+	// only pack what would be picked up from the directory, sorted so the output doesn't depend on the filesystem
+	FileSystem::FindResultsArray files;
+	FileSystem::FindFiles(replacement_dir.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE, &files);
+
+	std::vector<std::string> filenames;
+	for (FILESYSTEM_FIND_DATA& fd : files)
+	{
+		const std::string filename(Path::GetFileName(fd.FileName));
+		if (GetLoader(filename) && ParseReplacementName(filename).has_value())
+			filenames.push_back(std::move(fd.FileName));
+	}
+	std::sort(filenames.begin(), filenames.end());
+
+	if (filenames.empty())
+	{
+		Error::SetStringFmt(error, "No replacement textures found in '{}'.", replacement_dir);
+		return false;
+	}
+
+	Console.WriteLn("Packing %zu replacement textures into '%s'...", filenames.size(), archive_path.c_str());
+
+	const bool result = [&filenames, &archive_path, error]() {
+		GSTextureReplacementArchive::Writer writer;
+		if (!writer.Create(archive_path, error))
+			return false;
+
+		// decoding is the slow part, so do a batch at a time in parallel, without holding everything in memory
+		const u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+		const size_t batch_size = static_cast<size_t>(num_threads) * 4;
+		GSWorkStealingPool pool(num_threads - 1);
+		std::vector<std::optional<ReplacementTexture>> batch;
+		for (size_t start = 0; start < filenames.size(); start += batch_size)
+		{
+			const size_t count = std::min(batch_size, filenames.size() - start);
+			batch.clear();
+			batch.resize(count);
+
+			pool.ParallelFor(static_cast<u32>(count), [&filenames, &batch, start](u32 i) {
+				batch[i] = LoadReplacementTexture(ReplacementSource{filenames[start + i]}, false);
+			});
+
+			for (size_t i = 0; i < count; i++)
+			{
+				// failures were already logged by the loader, leave them out
+				if (batch[i].has_value() && !writer.AddEntry(Path::GetFileName(filenames[start + i]), batch[i].value(), error))
+					return false;
+			}
+		}
+
+		Console.WriteLn("Wrote %u replacement textures.", writer.GetEntryCount());
+		return writer.Finish(error);
+	}();
+
+	// don't leave a truncated archive around, it'd be picked up over the directory
+	if (!result)
+		FileSystem::DeleteFilePath(archive_path.c_str());
+
+	return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Worker Thread
+// Worker Pool
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void GSTextureReplacements::StartWorkerThread()
+u32 GSTextureReplacements::GetWorkerThreadCount()
 {
-	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
+	// leave most of the cores for the EE/GS threads
+	return std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+}
 
-	if (s_worker_thread.joinable())
+void GSTextureReplacements::StartWorkerPool()
+{
+	if (s_worker_pool)
 		return;
 
-	s_worker_thread_running = true;
-	s_worker_thread = std::thread(WorkerThreadEntryPoint);
+	s_worker_pool = std::make_unique<GSWorkStealingPool>(GetWorkerThreadCount());
 }
 
-void GSTextureReplacements::StopWorkerThread()
+void GSTextureReplacements::StopWorkerPool()
 {
-	{
-		std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
-		if (!s_worker_thread.joinable())
-			return;
+	if (!s_worker_pool)
+		return;
 
-		s_worker_thread_running = false;
-		s_worker_thread_cv.notify_one();
+	// drop anything that hasn't started, then let the running items finish
+	{
+		std::unique_lock<std::mutex> lock(s_worker_queue_mutex);
+		s_worker_queue.clear();
 	}
-
-	s_worker_thread.join();
+	s_worker_pool->Wait(s_worker_jobs_counter);
+	s_worker_pool.reset();
 
 	// clear out workery-things too
 	CancelPendingLoadsAndDumps();
 }
 
-void GSTextureReplacements::QueueWorkerThreadItem(std::function<void()> fn, bool high_priority)
+void GSTextureReplacements::QueueWorkerItem(std::function<void()> fn, bool high_priority)
 {
-	pxAssert(s_worker_thread.joinable());
+	pxAssert(s_worker_pool);
 
-	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
+	std::unique_lock<std::mutex> lock(s_worker_queue_mutex);
 	if (!high_priority)
 	{
 		// Low priority => throw on end.
-		s_worker_thread_queue.emplace_back(std::move(fn), false);
+		s_worker_queue.emplace_back(std::move(fn), false);
 	}
 	else
 	{
-		auto iter = s_worker_thread_queue.rbegin();
-		for (; iter != s_worker_thread_queue.rend(); ++iter)
+		auto iter = s_worker_queue.rbegin();
+		for (; iter != s_worker_queue.rend(); ++iter)
 		{
 			// Found our first high priority item?
 			if (iter->second)
@@ -913,63 +1076,56 @@ void GSTextureReplacements::QueueWorkerThreadItem(std::function<void()> fn, bool
 			}
 		}
 
-		if (iter != s_worker_thread_queue.rend())
+		if (iter != s_worker_queue.rend())
 		{
 			// Insert after the last high priority item. Remember base() points to the next element.
-			s_worker_thread_queue.insert(iter.base(), std::make_pair(std::move(fn), true));
+			s_worker_queue.insert(iter.base(), std::make_pair(std::move(fn), true));
 		}
 		else
 		{
 			// All low-priority => insert at beginning.
-			s_worker_thread_queue.emplace_front(std::move(fn), true);
+			s_worker_queue.emplace_front(std::move(fn), true);
 		}
 	}
 
-	s_worker_thread_cv.notify_one();
+	// every running job keeps going until the queue is empty, so only start another if there's an idle thread
+	if (s_worker_jobs_running >= s_worker_pool->GetThreadCount())
+		return;
+
+	s_worker_jobs_running++;
+	lock.unlock();
+	s_worker_pool->Submit(&s_worker_job, 1);
 }
 
-void GSTextureReplacements::WorkerThreadEntryPoint()
+void GSTextureReplacements::RunWorkerItems(void* arg, u32 index)
 {
-	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
-	while (s_worker_thread_running)
+	std::unique_lock<std::mutex> lock(s_worker_queue_mutex);
+	while (!s_worker_queue.empty())
 	{
-		if (s_worker_thread_queue.empty())
-		{
-			s_worker_thread_cv.wait(lock);
-			continue;
-		}
-
-		std::function<void()> fn = std::move(s_worker_thread_queue.front().first);
-		s_worker_thread_queue.pop_front();
+		std::function<void()> fn = std::move(s_worker_queue.front().first);
+		s_worker_queue.pop_front();
 		lock.unlock();
 		fn();
 		lock.lock();
 	}
+
+	// checked under the same lock as the queue, so an item can't be queued without a job to run it
+	s_worker_jobs_running--;
 }
 
-void GSTextureReplacements::SyncWorkerThread()
+void GSTextureReplacements::SyncWorkerPool()
 {
-	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
-	if (!s_worker_thread.joinable())
+	if (!s_worker_pool)
 		return;
 
-	// not the most efficient by far, but it only gets called on config changes, so whatever
-	for (;;)
-	{
-		if (s_worker_thread_queue.empty())
-			break;
-
-		lock.unlock();
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-		lock.lock();
-	}
+	// this also runs items on the calling thread, which is fine, since it's about to wait for them anyway
+	s_worker_pool->Wait(s_worker_jobs_counter);
 }
 
 void GSTextureReplacements::CancelPendingLoadsAndDumps()
 {
-	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
-	while (!s_worker_thread_queue.empty())
-		s_worker_thread_queue.pop_back();
+	std::unique_lock<std::mutex> lock(s_worker_queue_mutex);
+	s_worker_queue.clear();
 	s_async_loaded_textures.clear();
 	s_pending_async_load_textures.clear();
 }
@@ -7,6 +7,8 @@
 
 #include <utility>
 
+class Error;
+
 namespace GSTextureReplacements
 {
 	struct ReplacementTexture
@@ -47,6 +49,9 @@ namespace GSTextureReplacements
 		GSTextureCache::SourceRegion region, GSLocalMemory& mem, u32 level);
 	void ClearDumpedTextureList();
 
+	/// Packs a game's replacements directory into a single archive, which is loaded instead when present.
+	bool BuildReplacementArchive(const std::string& texture_dir, Error* error);
+
 	/// Loader will take a filename and interpret the format (e.g. DDS, PNG, etc).
 	using ReplacementTextureLoader = bool (*)(const std::string& filename, GSTextureReplacements::ReplacementTexture* tex, bool only_base_image);
 	ReplacementTextureLoader GetLoader(const std::string_view filename);
@@ -7,6 +7,7 @@
 #include "GS/Renderers/SW/GSRasterizer.h"
 
 #include "common/Console.h"
+#include "common/Timer.h"
 
 #include <fstream>
 
@@ -180,9 +181,61 @@ void GSDrawScanline::UpdateDrawStats(u64 frame, u64 ticks, int actual, int total
 
 void GSDrawScanline::PrintStats()
 {
+	m_sp_map.PrintCacheStats();
+	m_ds_map.PrintCacheStats();
 	m_ds_map.PrintStats();
 }
 
+void GSDrawScanline::LoadSelectorCache()
+{
+#ifdef ENABLE_JIT_RASTERIZER
+	// Start from an empty cache, so the saved selectors only cover this game.
+	m_sp_map.Clear();
+	m_ds_map.Clear();
+	GSCodeReserve::ResetMemory();
+
+	m_selector_cache_path = GSSelectorCache::GetPath();
+	if (m_selector_cache_path.empty())
+		return;
+
+	std::vector<u64> sp_keys, ds_keys;
+	if (!GSSelectorCache::Load(m_selector_cache_path, &sp_keys, &ds_keys))
+		return;
+
+	// Leave at least half of the code space for selectors we haven't seen before.
+	const size_t max_used = GSCodeReserve::GetMemorySize() / 2;
+	const Common::Timer timer;
+	u32 count = 0;
+	for (const u64 key : sp_keys)
+	{
+		if (GSCodeReserve::GetMemoryUsed() >= max_used)
+			break;
+		m_sp_map.Precompile(key);
+		count++;
+	}
+	for (const u64 key : ds_keys)
+	{
+		if (GSCodeReserve::GetMemoryUsed() >= max_used)
+			break;
+		m_ds_map.Precompile(key);
+		count++;
+	}
+
+	DevCon.WriteLn("SW JIT precompiled %u selectors (%zu bytes) in %.2f ms", count, GSCodeReserve::GetMemoryUsed(),
+		timer.GetTimeMilliseconds());
+#endif
+}
+
+void GSDrawScanline::SaveSelectorCache()
+{
+#ifdef ENABLE_JIT_RASTERIZER
+	if (m_selector_cache_path.empty())
+		return;
+
+	GSSelectorCache::Save(m_selector_cache_path, m_sp_map.GetCompiledKeys(), m_ds_map.GetCompiledKeys());
+#endif
+}
+
 #if _M_SSE >= 0x501
 typedef GSVector8i VectorI;
 typedef GSVector8  VectorF;
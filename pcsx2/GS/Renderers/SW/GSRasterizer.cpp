@@ -125,6 +125,12 @@ int GSRasterizer::GetPixels(bool reset)
 
 void GSRasterizer::Draw(GSRasterizerData& data)
 {
+	if (data.upload.len > 0)
+	{
+		WriteUpload(data);
+		return;
+	}
+
 	if ((data.vertex && data.vertex_count == 0) || (data.index && data.index_count == 0))
 		return;
 
@@ -249,6 +255,30 @@ void GSRasterizer::Draw(GSRasterizerData& data)
 		m_ds->UpdateDrawStats(data.frame, GetCPUTicks() - data.start, m_pixels.actual, m_pixels.total, m_primcount);
 }
 
+void GSRasterizer::WriteUpload(const GSRasterizerData& data)
+{
+	// Bands are aligned to pages in absolute coordinates, so no two threads ever write to the same page.
+	// Each thread takes every m_threads'th band, starting from the one containing the top of the transfer.
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[data.upload.blit.DPSM];
+	GIFRegBITBLTBUF blit = data.upload.blit;
+	GIFRegTRXPOS pos = data.upload.pos;
+	GIFRegTRXREG reg = data.upload.reg;
+	const int band_height = data.upload.band_height;
+	const int top = static_cast<int>(pos.DSAY);
+	const int bottom = top + static_cast<int>(reg.RRH);
+	const int pitch = data.upload.len / static_cast<int>(reg.RRH);
+
+	for (int band = (top / band_height) + m_id; band * band_height < bottom; band += m_threads)
+	{
+		const int y0 = std::max(band * band_height, top);
+		const int y1 = std::min((band + 1) * band_height, bottom);
+
+		int tx = static_cast<int>(pos.DSAX);
+		int ty = y0;
+		psm.wi(*data.upload.mem, tx, ty, data.buff + (y0 - top) * pitch, (y1 - y0) * pitch, blit, pos, reg);
+	}
+}
+
 template <bool scissor_test>
 void GSRasterizer::DrawPoint(const GSVertexSW* vertex, int vertex_count, const u16* index, int index_count)
 {
@@ -1165,6 +1195,11 @@ void GSSingleRasterizer::Draw(GSRasterizerData& data)
 	m_r.Draw(data);
 }
 
+void GSSingleRasterizer::QueueUpload(const GSRingHeap::SharedPtr<GSRasterizerData>& data)
+{
+	m_r.Draw(*data.get());
+}
+
 void GSSingleRasterizer::Sync()
 {
 }
@@ -1186,6 +1221,16 @@ void GSSingleRasterizer::PrintStats()
 #endif
 }
 
+void GSSingleRasterizer::LoadSelectorCache()
+{
+	m_ds.LoadSelectorCache();
+}
+
+void GSSingleRasterizer::SaveSelectorCache()
+{
+	m_ds.SaveSelectorCache();
+}
+
 //
 
 GSRasterizerList::GSRasterizerList(int threads)
@@ -1243,20 +1288,31 @@ void GSRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data
 	int top = r.top >> m_thread_height;
 	int bottom = std::min<int>((r.bottom + (1 << m_thread_height) - 1) >> m_thread_height, top + m_workers.size());
 
+	m_pending.Add(static_cast<u32>(std::max(bottom - top, 0)));
 	while (top < bottom)
 	{
 		m_workers[m_scanline[top++]]->Push(data);
 	}
 }
 
+void GSRasterizerList::QueueUpload(const GSRingHeap::SharedPtr<GSRasterizerData>& data)
+{
+	// Every worker takes a share of the bands, see GSRasterizer::WriteUpload().
+	const int bands = (static_cast<int>(data->upload.pos.DSAY + data->upload.reg.RRH) + data->upload.band_height - 1) /
+						  data->upload.band_height -
+					  static_cast<int>(data->upload.pos.DSAY) / data->upload.band_height;
+	const size_t workers = std::min<size_t>(static_cast<size_t>(bands), m_workers.size());
+	m_pending.Add(static_cast<u32>(workers));
+	for (size_t i = 0; i < workers; i++)
+		m_workers[i]->Push(data);
+}
+
 void GSRasterizerList::Sync()
 {
 	if (!IsSynced())
 	{
-		for (size_t i = 0; i < m_workers.size(); i++)
-		{
-			m_workers[i]->Wait();
-		}
+		// One wait for everything, rather than waking up for each worker in turn.
+		m_pending.Wait();
 
 		g_perfmon.Put(GSPerfMon::SyncPoint, 1);
 	}
@@ -1264,15 +1320,7 @@ void GSRasterizerList::Sync()
 
 bool GSRasterizerList::IsSynced() const
 {
-	for (size_t i = 0; i < m_workers.size(); i++)
-	{
-		if (!m_workers[i]->IsEmpty())
-		{
-			return false;
-		}
-	}
-
-	return true;
+	return m_pending.IsZero();
 }
 
 int GSRasterizerList::GetPixels(bool reset)
@@ -1308,9 +1356,15 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 		const u64 affinity = pin ? (static_cast<u64>(1u) << procs[i]) : 0;
 		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, i, threads)));
 		auto& r = *rl->m_r[i];
+		GSJobCounter& pending = rl->m_pending;
 		rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker(
 			[i, affinity]() { GSRasterizerList::OnWorkerStartup(i, affinity); },
-			[&r](GSRingHeap::SharedPtr<GSRasterizerData>& item) { r.Draw(*item.get()); },
+			[&r, &pending](GSRingHeap::SharedPtr<GSRasterizerData>& item) {
+				// Drop our reference before signalling, the data shouldn't outlive a sync.
+				r.Draw(*item.get());
+				item = nullptr;
+				pending.Done();
+			},
 			[i]() { GSRasterizerList::OnWorkerShutdown(i); })));
 	}
 
@@ -1320,3 +1374,15 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 void GSRasterizerList::PrintStats()
 {
 }
+
+void GSRasterizerList::LoadSelectorCache()
+{
+	// Workers could still be running code we're about to overwrite.
+	Sync();
+	m_ds.LoadSelectorCache();
+}
+
+void GSRasterizerList::SaveSelectorCache()
+{
+	m_ds.SaveSelectorCache();
+}
@@ -8,6 +8,7 @@
 #include "GS/GSAlignedClass.h"
 #include "GS/GSPerfMon.h"
 #include "GS/GSJobQueue.h"
+#include "GS/GSWorkStealingPool.h"
 #include "GS/GSRingHeap.h"
 #include "GS/MultiISA.h"
 
@@ -34,6 +35,17 @@ public:
 	int counter;
 	u8 scanmsk_value;
 
+	/// Set for host->local transfers, which are swizzled from buff in bands of rows instead of being drawn.
+	struct
+	{
+		GSLocalMemory* mem;
+		int len;
+		int band_height;
+		GIFRegBITBLTBUF blit;
+		GIFRegTRXPOS pos;
+		GIFRegTRXREG reg;
+	} upload;
+
 	GSScanlineGlobalData global;
 
 	GSDrawScanline::SetupPrimPtr setup_prim;
@@ -53,6 +65,7 @@ public:
 		, start(0)
 		, pixels(0)
 		, scanmsk_value(0)
+		, upload{}
 	{
 		counter = s_counter++;
 	}
@@ -102,6 +115,8 @@ protected:
 
 	void DrawEdge(const GSVertexSW& v0, const GSVertexSW& v1, const GSVertexSW& dv, int orientation, int side);
 
+	void WriteUpload(const GSRasterizerData& data);
+
 	__forceinline void AddScanline(GSVertexSW* e, int pixels, int left, int top, const GSVertexSW& scan);
 	__forceinline void Flush(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan, bool edge = false);
 
@@ -126,10 +141,17 @@ public:
 	virtual ~IRasterizer() {}
 
 	virtual void Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data) = 0;
+	virtual void QueueUpload(const GSRingHeap::SharedPtr<GSRasterizerData>& data) = 0;
 	virtual void Sync() = 0;
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
+
+	/// Throws away generated code, and compiles the selectors recorded for the running game.
+	virtual void LoadSelectorCache() = 0;
+
+	/// Records the selectors compiled for the running game.
+	virtual void SaveSelectorCache() = 0;
 };
 
 class GSSingleRasterizer final : public IRasterizer
@@ -139,10 +161,13 @@ public:
 	~GSSingleRasterizer() override;
 
 	void Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data) override;
+	void QueueUpload(const GSRingHeap::SharedPtr<GSRasterizerData>& data) override;
 	void Sync() override;
 	bool IsSynced() const override;
 	int GetPixels(bool reset = true) override;
 	void PrintStats() override;
+	void LoadSelectorCache() override;
+	void SaveSelectorCache() override;
 
 	void Draw(GSRasterizerData& data);
 
@@ -158,8 +183,10 @@ protected:
 
 	GSDrawScanline m_ds;
 
-	// Worker threads depend on the rasterizers, so don't change the order.
+	// Worker threads depend on the rasterizers and counter, so don't change the order.
+	// Draws can't be stolen by other workers, since each worker owns its own scanlines.
 	std::vector<std::unique_ptr<GSRasterizer>> m_r;
+	GSJobCounter m_pending;
 	std::vector<std::unique_ptr<GSWorker>> m_workers;
 	u8* m_scanline;
 	int m_thread_height;
@@ -177,10 +204,13 @@ public:
 	// IRasterizer
 
 	void Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data) override;
+	void QueueUpload(const GSRingHeap::SharedPtr<GSRasterizerData>& data) override;
 	void Sync() override;
 	bool IsSynced() const override;
 	int GetPixels(bool reset) override;
 	void PrintStats() override;
+	void LoadSelectorCache() override;
+	void SaveSelectorCache() override;
 };
 
 MULTI_ISA_UNSHARED_END
@@ -28,6 +28,8 @@ GSRendererSW::GSRendererSW(int threads)
 
 	m_tc = std::make_unique<GSTextureCacheSW>();
 	m_rl = GSRasterizerList::Create(threads);
+	m_threaded_uploads = (threads > 0);
+	m_rl->LoadSelectorCache();
 
 	m_output = (u8*)_aligned_malloc(1024 * 1024 * sizeof(u32), VECTOR_ALIGNMENT);
 
@@ -52,9 +54,23 @@ void GSRendererSW::Reset(bool hardware_reset)
 	GSRenderer::Reset(hardware_reset);
 }
 
+void GSRendererSW::GameChanged()
+{
+	m_rl->SaveSelectorCache();
+	m_rl->LoadSelectorCache();
+}
+
+void GSRendererSW::ReadbackTextureCache()
+{
+	// Draws and uploads still in the worker queues haven't reached local memory yet.
+	Sync(8);
+}
+
 void GSRendererSW::Destroy()
 {
 	// Need to destroy worker queue first to stop any pending thread work
+	if (m_rl)
+		m_rl->SaveSelectorCache();
 	m_rl.reset();
 	m_tc.reset();
 
@@ -652,6 +668,52 @@ void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 	}
 }
 
+void GSRendererSW::WriteTransfer(int& tx, int& ty, const u8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
+{
+	// Uploads smaller than this aren't worth the copy and the trip through the worker queues.
+	static constexpr int MIN_THREADED_UPLOAD_SIZE = 64 * 1024;
+
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[BITBLTBUF.DPSM];
+	const int pitch = ((static_cast<int>(TRXREG.RRW) * psm.trbpp) + 7) >> 3;
+	const GSVector4i r = GSVector4i(TRXPOS.DSAX, TRXPOS.DSAY, TRXPOS.DSAX + TRXREG.RRW, TRXPOS.DSAY + TRXREG.RRH);
+
+	// Only whole transfers can be split, and they have to stay within the buffer width and local memory, otherwise
+	// rows would wrap into pages belonging to other bands. Odd width 4-bit writes ignore the transfer position.
+	if (!m_threaded_uploads || len < MIN_THREADED_UPLOAD_SIZE || tx != r.left || ty != r.top ||
+		len != (pitch * r.height()) || BITBLTBUF.DBW == 0 || (psm.trbpp == 4 && (TRXREG.RRW & 1)) ||
+		r.right > static_cast<int>(BITBLTBUF.DBW * 64) ||
+		GSLocalMemory::GetUnwrappedEndBlockAddress(BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM, r) >= GS_MAX_BLOCKS)
+	{
+		GSRenderer::WriteTransfer(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
+		return;
+	}
+
+	auto data = m_vertex_heap.make_shared<SharedData>().cast<GSRasterizerData>();
+	SharedData* sd = static_cast<SharedData*>(data.get());
+	sd->buff = static_cast<u8*>(m_vertex_heap.alloc(len, 64));
+	std::memcpy(sd->buff, src, len);
+	sd->upload.mem = &m_mem;
+	sd->upload.len = len;
+	sd->upload.band_height = psm.pgs.y;
+	sd->upload.blit = BITBLTBUF;
+	sd->upload.pos = TRXPOS;
+	sd->upload.reg = TRXREG;
+	sd->frame = g_perfmon.GetFrame();
+
+	// Track the written pages like a frame buffer, so anything touching them before the workers are done syncs
+	// first. Forget the current target too, because the next draw only checks pages it hasn't already used.
+	GSOffset::PageLooper pages = m_mem.GetOffset(BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM).pageLooperForRect(r);
+	sd->global.sel.fb = 1;
+	sd->UsePages(&pages, BITBLTBUF.DPSM, nullptr, 0);
+	m_fzb = nullptr;
+
+	m_rl->QueueUpload(data);
+
+	// Leave the transfer position where the write would have.
+	tx = r.left;
+	ty = r.bottom;
+}
+
 void GSRendererSW::UsePages(const GSOffset::PageLooper& pages, const int type)
 {
 	pages.loopPages([this, type](u32 page)
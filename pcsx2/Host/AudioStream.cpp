@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Host/AudioStream.h"
+#include "Host/AudioTimeStretcher.h"
 #include "FreeSurroundDecoder.h"
 #include "Host.h"
 #include "GS/GSVector.h"
@@ -458,9 +459,8 @@ void AudioStream::EmptyBuffer()
 
 	if (IsStretchEnabled())
 	{
-		m_soundtouch->clear();
-		if (IsStretchEnabled())
-			m_soundtouch->setTempo(m_nominal_rate);
+		StretchClear();
+		StretchSetTempo(m_nominal_rate);
 	}
 
 	m_wpos.store(m_rpos.load(std::memory_order_acquire), std::memory_order_release);
@@ -483,7 +483,7 @@ void AudioStream::UpdateTargetTempo(float tempo)
 	m_average_position = AVERAGING_WINDOW;
 	m_average_available = AVERAGING_WINDOW;
 	std::fill_n(m_average_fullness.data(), AVERAGING_WINDOW, tempo);
-	m_soundtouch->setTempo(tempo);
+	StretchSetTempo(tempo);
 	m_stretch_reset = 0;
 	m_stretch_inactive = false;
 	m_stretch_ok_count = 0;
@@ -671,18 +671,36 @@ void AudioStream::StretchAllocate()
 	if (!IsStretchEnabled())
 		return;
 
-	m_soundtouch = std::make_unique<soundtouch::SoundTouch>();
-	m_soundtouch->setSampleRate(m_sample_rate);
-	m_soundtouch->setChannels(m_internal_channels);
+	u32 sequence_ms = m_parameters.stretch_sequence_length_ms;
+	u32 seekwindow_ms = m_parameters.stretch_seekwindow_ms;
+	u32 overlap_ms = m_parameters.stretch_overlap_ms;
+	if (m_parameters.stretch_minimal_latency)
+	{
+		sequence_ms = std::min<u32>(sequence_ms, AudioStreamParameters::MINIMAL_LATENCY_STRETCH_SEQUENCE_LENGTH);
+		seekwindow_ms = std::min<u32>(seekwindow_ms, AudioStreamParameters::MINIMAL_LATENCY_STRETCH_SEEKWINDOW);
+		overlap_ms = std::min<u32>(overlap_ms, AudioStreamParameters::MINIMAL_LATENCY_STRETCH_OVERLAP);
+	}
+
+	if (m_parameters.stretch_use_native)
+	{
+		m_native_stretcher = std::make_unique<AudioTimeStretcher>(m_sample_rate, m_internal_channels, sequence_ms,
+			seekwindow_ms, overlap_ms, m_parameters.stretch_use_quickseek);
+	}
+	else
+	{
+		m_soundtouch = std::make_unique<soundtouch::SoundTouch>();
+		m_soundtouch->setSampleRate(m_sample_rate);
+		m_soundtouch->setChannels(m_internal_channels);
 
-	m_soundtouch->setSetting(SETTING_USE_QUICKSEEK, m_parameters.stretch_use_quickseek);
-	m_soundtouch->setSetting(SETTING_USE_AA_FILTER, m_parameters.stretch_use_aa_filter);
+		m_soundtouch->setSetting(SETTING_USE_QUICKSEEK, m_parameters.stretch_use_quickseek);
+		m_soundtouch->setSetting(SETTING_USE_AA_FILTER, m_parameters.stretch_use_aa_filter);
 
-	m_soundtouch->setSetting(SETTING_SEQUENCE_MS, m_parameters.stretch_sequence_length_ms);
-	m_soundtouch->setSetting(SETTING_SEEKWINDOW_MS, m_parameters.stretch_seekwindow_ms);
-	m_soundtouch->setSetting(SETTING_OVERLAP_MS, m_parameters.stretch_overlap_ms);
+		m_soundtouch->setSetting(SETTING_SEQUENCE_MS, sequence_ms);
+		m_soundtouch->setSetting(SETTING_SEEKWINDOW_MS, seekwindow_ms);
+		m_soundtouch->setSetting(SETTING_OVERLAP_MS, overlap_ms);
+	}
 
-	m_soundtouch->setTempo(m_nominal_rate);
+	StretchSetTempo(m_nominal_rate);
 
 	m_stretch_reset = STRETCH_RESET_THRESHOLD;
 	m_stretch_inactive = false;
@@ -696,17 +714,43 @@ void AudioStream::StretchAllocate()
 
 void AudioStream::StretchDestroy()
 {
+	m_native_stretcher.reset();
 	m_soundtouch.reset();
 }
 
+void AudioStream::StretchSetTempo(float tempo)
+{
+	if (m_native_stretcher)
+		m_native_stretcher->SetTempo(tempo);
+	else
+		m_soundtouch->setTempo(tempo);
+}
+
+u32 AudioStream::StretchReceiveFrames(float* frames, u32 max_frames)
+{
+	return m_native_stretcher ? m_native_stretcher->ReceiveFrames(frames, max_frames) :
+								m_soundtouch->receiveSamples(frames, max_frames);
+}
+
+void AudioStream::StretchClear()
+{
+	if (m_native_stretcher)
+		m_native_stretcher->Clear();
+	else
+		m_soundtouch->clear();
+}
+
 void AudioStream::StretchWriteBlock(const float* block)
 {
 	if (IsStretchEnabled())
 	{
-		m_soundtouch->putSamples(block, CHUNK_SIZE);
+		if (m_native_stretcher)
+			m_native_stretcher->PutFrames(block, CHUNK_SIZE);
+		else
+			m_soundtouch->putSamples(block, CHUNK_SIZE);
 
 		u32 tempProgress;
-		while (tempProgress = m_soundtouch->receiveSamples(m_float_buffer.get(), CHUNK_SIZE), tempProgress != 0)
+		while (tempProgress = StretchReceiveFrames(m_float_buffer.get(), CHUNK_SIZE), tempProgress != 0)
 		{
 			FloatChunkToS16(m_staging_buffer.get(), m_float_buffer.get(), tempProgress * m_internal_channels);
 			InternalWriteFrames(m_staging_buffer.get(), tempProgress);
@@ -830,7 +874,7 @@ void AudioStream::UpdateStretchTempo()
 		iterations++;
 	}
 
-	m_soundtouch->setTempo(tempo);
+	StretchSetTempo(tempo);
 
 	if (m_stretch_reset >= STRETCH_RESET_THRESHOLD)
 		m_stretch_reset = 0;
@@ -864,6 +908,8 @@ void AudioStreamParameters::LoadSave(SettingsWrapper& wrap, const char* section)
 	stretch_overlap_ms = static_cast<u16>(std::clamp<int>(wrap.EntryBitfield(section, "StretchOverlapMS", DEFAULT_STRETCH_OVERLAP), 0, std::numeric_limits<u16>::max()));
 	stretch_use_quickseek = wrap.EntryBitBool(section, "StretchUseQuickSeek", DEFAULT_STRETCH_USE_QUICKSEEK);
 	stretch_use_aa_filter = wrap.EntryBitBool(section, "StretchUseAAFilter", DEFAULT_STRETCH_USE_AA_FILTER);
+	stretch_use_native = wrap.EntryBitBool(section, "StretchUseNative", DEFAULT_STRETCH_USE_NATIVE);
+	stretch_minimal_latency = wrap.EntryBitBool(section, "StretchMinimalLatency", DEFAULT_STRETCH_MINIMAL_LATENCY);
 
 	expand_block_size = static_cast<u16>(std::clamp<int>(wrap.EntryBitfield(section, "ExpandBlockSize", DEFAULT_EXPAND_BLOCK_SIZE), 0, std::numeric_limits<u16>::max()));
 	wrap.Entry(section, "ExpandCircularWrap", expand_circular_wrap, DEFAULT_EXPAND_CIRCULAR_WRAP);
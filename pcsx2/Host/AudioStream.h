@@ -15,6 +15,7 @@
 
 class Error;
 
+class AudioTimeStretcher;
 class FreeSurroundDecoder;
 namespace soundtouch
 {
@@ -157,6 +158,9 @@ private:
 	void StretchAllocate();
 	void StretchDestroy();
 	void StretchWriteBlock(const float* block);
+	void StretchSetTempo(float tempo);
+	u32 StretchReceiveFrames(float* frames, u32 max_frames);
+	void StretchClear();
 	void StretchUnderrun();
 	void StretchOverrun();
 
@@ -171,6 +175,7 @@ private:
 	std::atomic<u32> m_wpos{0};
 
 	std::unique_ptr<soundtouch::SoundTouch> m_soundtouch;
+	std::unique_ptr<AudioTimeStretcher> m_native_stretcher;
 
 	u32 m_target_buffer_size = 0;
 	u32 m_stretch_reset = STRETCH_RESET_THRESHOLD;
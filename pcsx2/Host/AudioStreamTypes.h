@@ -38,6 +38,8 @@ struct AudioStreamParameters
 	u16 stretch_overlap_ms = DEFAULT_STRETCH_OVERLAP;
 	bool stretch_use_quickseek = DEFAULT_STRETCH_USE_QUICKSEEK;
 	bool stretch_use_aa_filter = DEFAULT_STRETCH_USE_AA_FILTER;
+	bool stretch_use_native = DEFAULT_STRETCH_USE_NATIVE;
+	bool stretch_minimal_latency = DEFAULT_STRETCH_MINIMAL_LATENCY;
 
 	float expand_circular_wrap = DEFAULT_EXPAND_CIRCULAR_WRAP;
 	float expand_shift = DEFAULT_EXPAND_SHIFT;
@@ -72,6 +74,13 @@ struct AudioStreamParameters
 
 	static constexpr bool DEFAULT_STRETCH_USE_QUICKSEEK = false;
 	static constexpr bool DEFAULT_STRETCH_USE_AA_FILTER = false;
+	static constexpr bool DEFAULT_STRETCH_USE_NATIVE = false;
+	static constexpr bool DEFAULT_STRETCH_MINIMAL_LATENCY = false;
+
+	// Overrides for the sequence/seek/overlap lengths when minimal stretch latency is enabled.
+	static constexpr u16 MINIMAL_LATENCY_STRETCH_SEQUENCE_LENGTH = 16;
+	static constexpr u16 MINIMAL_LATENCY_STRETCH_SEEKWINDOW = 8;
+	static constexpr u16 MINIMAL_LATENCY_STRETCH_OVERLAP = 4;
 
 	void LoadSave(SettingsWrapper& wrap, const char* section);
 
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Host/AudioTimeStretcher.h"
+#include "GS/GSVector.h"
+
+#include "common/Assertions.h"
+#include "common/BitUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+AudioTimeStretcher::AudioTimeStretcher(
+	u32 sample_rate, u32 channels, u32 sequence_ms, u32 seekwindow_ms, u32 overlap_ms, bool quickseek)
+	: m_channels(channels)
+	, m_quickseek(quickseek)
+{
+	// Overlap is rounded to a multiple of 8 frames, so the correlation loop never needs a scalar tail
+	// regardless of the channel count.
+	m_overlap_frames = Common::AlignUpPow2(std::max<u32>((sample_rate * overlap_ms) / 1000, 8), 8);
+	m_sequence_frames = std::max((sample_rate * sequence_ms) / 1000, m_overlap_frames * 2);
+	m_seek_frames = (sample_rate * seekwindow_ms) / 1000;
+
+	m_overlap_buffer = std::make_unique<float[]>(m_overlap_frames * m_channels);
+	m_input.reserve((m_sequence_frames + m_seek_frames) * 2 * m_channels);
+	m_output.reserve(m_sequence_frames * 2 * m_channels);
+}
+
+AudioTimeStretcher::~AudioTimeStretcher() = default;
+
+u32 AudioTimeStretcher::GetLatencyFrames() const
+{
+	const float nominal_skip = m_tempo * static_cast<float>(m_sequence_frames - m_overlap_frames);
+	return std::max(m_sequence_frames + m_seek_frames, static_cast<u32>(nominal_skip) + 1);
+}
+
+u32 AudioTimeStretcher::GetAvailableFrames() const
+{
+	return static_cast<u32>(m_output.size() / m_channels) - m_output_pos;
+}
+
+void AudioTimeStretcher::SetTempo(float tempo)
+{
+	m_tempo = tempo;
+}
+
+void AudioTimeStretcher::Clear()
+{
+	m_input.clear();
+	m_output.clear();
+	m_output_pos = 0;
+	m_skip_fract = 0.0f;
+	m_first_sequence = true;
+}
+
+void AudioTimeStretcher::PutFrames(const float* frames, u32 num_frames)
+{
+	m_input.insert(m_input.end(), frames, frames + num_frames * m_channels);
+	ProcessSequences();
+}
+
+u32 AudioTimeStretcher::ReceiveFrames(float* frames, u32 max_frames)
+{
+	const u32 count = std::min(GetAvailableFrames(), max_frames);
+	if (count == 0)
+		return 0;
+
+	std::memcpy(frames, &m_output[m_output_pos * m_channels], count * m_channels * sizeof(float));
+	m_output_pos += count;
+	if (m_output_pos == (m_output.size() / m_channels))
+	{
+		m_output.clear();
+		m_output_pos = 0;
+	}
+
+	return count;
+}
+
+float AudioTimeStretcher::GetCorrelation(const float* input) const
+{
+	const float* overlap = m_overlap_buffer.get();
+	const u32 num_samples = m_overlap_frames * m_channels;
+
+	GSVector4 corr = GSVector4::zero();
+	GSVector4 norm = GSVector4::zero();
+	for (u32 i = 0; i < num_samples; i += 8)
+	{
+		const GSVector4 in0 = GSVector4::load<false>(input + i);
+		const GSVector4 in1 = GSVector4::load<false>(input + i + 4);
+		corr = corr.addm(in0, GSVector4::load<false>(overlap + i));
+		corr = corr.addm(in1, GSVector4::load<false>(overlap + i + 4));
+		norm = norm.addm(in0, in0);
+		norm = norm.addm(in1, in1);
+	}
+
+	// [corr, norm, corr, norm]
+	const GSVector4 sums = corr.hadd(norm).hadd();
+	return sums.x / std::sqrt(std::max(sums.y, 1e-9f));
+}
+
+u32 AudioTimeStretcher::SeekBestOffset(const float* input) const
+{
+	if (m_seek_frames <= 1)
+		return 0;
+
+	u32 best_offset = 0;
+	float best_corr = GetCorrelation(input);
+
+	// Quickseek does a coarse pass over the window, then refines around the best coarse match.
+	const u32 step = m_quickseek ? 4 : 1;
+	for (u32 offset = step; offset < m_seek_frames; offset += step)
+	{
+		const float corr = GetCorrelation(input + offset * m_channels);
+		if (corr > best_corr)
+		{
+			best_corr = corr;
+			best_offset = offset;
+		}
+	}
+
+	if (m_quickseek)
+	{
+		const u32 start = (best_offset >= step) ? (best_offset - step + 1) : 0;
+		const u32 end = std::min(best_offset + step, m_seek_frames);
+		for (u32 offset = start; offset < end; offset++)
+		{
+			if (offset == best_offset)
+				continue;
+
+			const float corr = GetCorrelation(input + offset * m_channels);
+			if (corr > best_corr)
+			{
+				best_corr = corr;
+				best_offset = offset;
+			}
+		}
+	}
+
+	return best_offset;
+}
+
+void AudioTimeStretcher::ProcessSequences()
+{
+	const u32 output_per_sequence = m_sequence_frames - m_overlap_frames;
+	const float nominal_skip = m_tempo * static_cast<float>(output_per_sequence);
+	const u32 frames_required = GetLatencyFrames();
+
+	u32 input_pos = 0;
+	u32 input_frames = static_cast<u32>(m_input.size() / m_channels);
+	while (input_frames - input_pos >= frames_required)
+	{
+		const float* input = &m_input[input_pos * m_channels];
+
+		u32 offset;
+		if (m_first_sequence)
+		{
+			// Nothing to crossfade from yet, so splice against the input itself.
+			offset = 0;
+			std::memcpy(m_overlap_buffer.get(), input, m_overlap_frames * m_channels * sizeof(float));
+			m_first_sequence = false;
+		}
+		else
+		{
+			offset = SeekBestOffset(input);
+		}
+
+		const float* sequence = input + offset * m_channels;
+		const size_t out_start = m_output.size();
+		m_output.resize(out_start + output_per_sequence * m_channels);
+		float* out = &m_output[out_start];
+
+		// Linear crossfade from the previous tail into the new sequence.
+		const float* overlap = m_overlap_buffer.get();
+		const float fade_step = 1.0f / static_cast<float>(m_overlap_frames);
+		for (u32 i = 0; i < m_overlap_frames; i++)
+		{
+			const float fade_in = static_cast<float>(i) * fade_step;
+			const float fade_out = 1.0f - fade_in;
+			for (u32 c = 0; c < m_channels; c++)
+			{
+				*(out++) = overlap[i * m_channels + c] * fade_out + sequence[i * m_channels + c] * fade_in;
+			}
+		}
+
+		// Middle of the sequence is copied as-is, and the tail kept for the next crossfade.
+		const u32 middle_frames = m_sequence_frames - m_overlap_frames * 2;
+		std::memcpy(out, sequence + m_overlap_frames * m_channels, middle_frames * m_channels * sizeof(float));
+		std::memcpy(m_overlap_buffer.get(), sequence + (m_sequence_frames - m_overlap_frames) * m_channels,
+			m_overlap_frames * m_channels * sizeof(float));
+
+		// Advance the input by the tempo-scaled amount, carrying the fractional part.
+		m_skip_fract += nominal_skip;
+		const u32 skip = static_cast<u32>(m_skip_fract);
+		m_skip_fract -= static_cast<float>(skip);
+		input_pos += skip;
+	}
+
+	if (input_pos > 0)
+		m_input.erase(m_input.begin(), m_input.begin() + input_pos * m_channels);
+}
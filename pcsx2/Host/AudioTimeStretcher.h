@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+#include <memory>
+#include <vector>
+
+/// WSOLA (waveform similarity overlap-add) time stretcher, used as a lighter-weight alternative to SoundTouch.
+/// Input is cut into fixed-length sequences which are crossfaded together, with the splice point chosen by
+/// searching a small window for the best cross-correlation against the tail of the previous sequence.
+/// Samples are interleaved floats, and any channel count up to AudioStream::MAX_OUTPUT_CHANNELS is supported.
+class AudioTimeStretcher
+{
+public:
+	AudioTimeStretcher(u32 sample_rate, u32 channels, u32 sequence_ms, u32 seekwindow_ms, u32 overlap_ms, bool quickseek);
+	~AudioTimeStretcher();
+
+	__fi u32 GetChannels() const { return m_channels; }
+	__fi float GetTempo() const { return m_tempo; }
+
+	/// Returns the number of input frames which have to be buffered before any output is produced.
+	/// This is the sequence plus the seek window, unless the tempo is high enough that the input skipped per
+	/// sequence (tempo * (sequence - overlap)) is larger. That happens above a tempo of 2.5 with the default
+	/// settings and 2.0 with the minimal latency settings, after which the latency grows with the tempo.
+	u32 GetLatencyFrames() const;
+
+	/// Returns the number of processed frames waiting to be received.
+	u32 GetAvailableFrames() const;
+
+	/// Tempo is the ratio of input to output frames, i.e. 2.0 plays back twice as fast.
+	void SetTempo(float tempo);
+
+	/// Drops all buffered input and output.
+	void Clear();
+
+	void PutFrames(const float* frames, u32 num_frames);
+	u32 ReceiveFrames(float* frames, u32 max_frames);
+
+private:
+	void ProcessSequences();
+	u32 SeekBestOffset(const float* input) const;
+	float GetCorrelation(const float* input) const;
+
+	u32 m_channels;
+	u32 m_sequence_frames;
+	u32 m_seek_frames;
+	u32 m_overlap_frames;
+	bool m_quickseek;
+	bool m_first_sequence = true;
+
+	float m_tempo = 1.0f;
+	float m_skip_fract = 0.0f;
+
+	std::vector<float> m_input;
+	std::vector<float> m_output;
+	u32 m_output_pos = 0;
+
+	/// Tail of the previous sequence, crossfaded into the start of the next.
+	std::unique_ptr<float[]> m_overlap_buffer;
+};
@@ -213,6 +213,136 @@ __fi static void BUTTERFLY(int& t0, int& t1, int w0, int w1, int d0, int d1)
 	t1 = tmp - (w1 + w0) * d0;
 }
 
+#if defined(_M_X86) && _M_SSE >= 0x501
+
+// AVX2 version of the IDCT below, bit-exact with it (including the 16-bit truncation between passes).
+// Each pass runs all 8 rows/columns at once in 32-bit lanes, with the block transposed in between.
+
+__fi static void IDCT_Transpose8x8(__m128i* r)
+{
+	const __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+	const __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+	const __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+	const __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+	const __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+	const __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+	const __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+	const __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+	const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+	const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+	const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+	const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+	const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+	const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+	const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+	const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+	r[0] = _mm_unpacklo_epi64(b0, b4);
+	r[1] = _mm_unpackhi_epi64(b0, b4);
+	r[2] = _mm_unpacklo_epi64(b1, b5);
+	r[3] = _mm_unpackhi_epi64(b1, b5);
+	r[4] = _mm_unpacklo_epi64(b2, b6);
+	r[5] = _mm_unpackhi_epi64(b2, b6);
+	r[6] = _mm_unpacklo_epi64(b3, b7);
+	r[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+__fi static __m256i IDCT_Mul(__m256i v, int w)
+{
+	return _mm256_mullo_epi32(v, _mm256_set1_epi32(w));
+}
+
+// Truncates two vectors of 32-bit values to 16 bits (not saturating, to match the scalar stores),
+// returning a in the low half and b in the high half.
+__fi static __m256i IDCT_Pack(__m256i a, __m256i b)
+{
+	a = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+	b = _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16);
+	return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+template <bool column_pass>
+__fi static void IDCT_Pass(__m128i* v)
+{
+	__m256i x[8];
+	for (int i = 0; i < 8; i++)
+		x[i] = _mm256_cvtepi16_epi32(v[i]);
+
+	__m256i a0, a1, a2, a3;
+	{
+		const __m256i d0 = _mm256_add_epi32(_mm256_slli_epi32(x[0], 11), _mm256_set1_epi32(column_pass ? 65536 : 128));
+		const __m256i d2 = _mm256_slli_epi32(x[2], 11);
+		const __m256i t0 = _mm256_add_epi32(d0, d2);
+		const __m256i t1 = _mm256_sub_epi32(d0, d2);
+		const __m256i tmp = IDCT_Mul(_mm256_add_epi32(x[3], x[1]), W6);
+		const __m256i t2 = _mm256_add_epi32(tmp, IDCT_Mul(x[1], W2 - W6));
+		const __m256i t3 = _mm256_sub_epi32(tmp, IDCT_Mul(x[3], W2 + W6));
+		a0 = _mm256_add_epi32(t0, t2);
+		a1 = _mm256_add_epi32(t1, t3);
+		a2 = _mm256_sub_epi32(t1, t3);
+		a3 = _mm256_sub_epi32(t0, t2);
+	}
+
+	__m256i b0, b1, b2, b3;
+	{
+		const __m256i tmp0 = IDCT_Mul(_mm256_add_epi32(x[7], x[4]), W7);
+		__m256i t0 = _mm256_add_epi32(tmp0, IDCT_Mul(x[4], W1 - W7));
+		__m256i t1 = _mm256_sub_epi32(tmp0, IDCT_Mul(x[7], W1 + W7));
+		const __m256i tmp1 = IDCT_Mul(_mm256_add_epi32(x[5], x[6]), W3);
+		const __m256i t2 = _mm256_add_epi32(tmp1, IDCT_Mul(x[6], W5 - W3));
+		const __m256i t3 = _mm256_sub_epi32(tmp1, IDCT_Mul(x[5], W5 + W3));
+		b0 = _mm256_add_epi32(t0, t2);
+		b3 = _mm256_add_epi32(t1, t3);
+		t0 = _mm256_sub_epi32(t0, t2);
+		t1 = _mm256_sub_epi32(t1, t3);
+		if constexpr (column_pass)
+		{
+			t0 = _mm256_srai_epi32(t0, 8);
+			t1 = _mm256_srai_epi32(t1, 8);
+			b1 = IDCT_Mul(_mm256_add_epi32(t0, t1), 181);
+			b2 = IDCT_Mul(_mm256_sub_epi32(t0, t1), 181);
+		}
+		else
+		{
+			b1 = _mm256_srai_epi32(IDCT_Mul(_mm256_add_epi32(t0, t1), 181), 8);
+			b2 = _mm256_srai_epi32(IDCT_Mul(_mm256_sub_epi32(t0, t1), 181), 8);
+		}
+	}
+
+	constexpr int shift = column_pass ? 17 : 8;
+	const __m256i o01 = IDCT_Pack(_mm256_srai_epi32(_mm256_add_epi32(a0, b0), shift), _mm256_srai_epi32(_mm256_add_epi32(a1, b1), shift));
+	const __m256i o23 = IDCT_Pack(_mm256_srai_epi32(_mm256_add_epi32(a2, b2), shift), _mm256_srai_epi32(_mm256_add_epi32(a3, b3), shift));
+	const __m256i o45 = IDCT_Pack(_mm256_srai_epi32(_mm256_sub_epi32(a3, b3), shift), _mm256_srai_epi32(_mm256_sub_epi32(a2, b2), shift));
+	const __m256i o67 = IDCT_Pack(_mm256_srai_epi32(_mm256_sub_epi32(a1, b1), shift), _mm256_srai_epi32(_mm256_sub_epi32(a0, b0), shift));
+	v[0] = _mm256_castsi256_si128(o01);
+	v[1] = _mm256_extracti128_si256(o01, 1);
+	v[2] = _mm256_castsi256_si128(o23);
+	v[3] = _mm256_extracti128_si256(o23, 1);
+	v[4] = _mm256_castsi256_si128(o45);
+	v[5] = _mm256_extracti128_si256(o45, 1);
+	v[6] = _mm256_castsi256_si128(o67);
+	v[7] = _mm256_extracti128_si256(o67, 1);
+}
+
+__ri static void IDCT_Block(s16* block)
+{
+	__m128i v[8];
+	for (int i = 0; i < 8; i++)
+		v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 8 * i));
+
+	// Row pass works across rows, so needs the coefficients in columns.
+	IDCT_Transpose8x8(v);
+	IDCT_Pass<false>(v);
+	IDCT_Transpose8x8(v);
+	IDCT_Pass<true>(v);
+
+	for (int i = 0; i < 8; i++)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(block + 8 * i), v[i]);
+}
+
+#else
+
 __ri static void IDCT_Block(s16* block)
 {
 	for (int i = 0; i < 8; i++)
@@ -322,6 +452,8 @@ __ri static void IDCT_Block(s16* block)
 	}
 }
 
+#endif
+
 __ri static void IDCT_Copy(s16* block, u8* dest, const int stride)
 {
 	IDCT_Block(block);
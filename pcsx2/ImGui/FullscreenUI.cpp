@@ -4145,6 +4145,12 @@ void FullscreenUI::DrawEmulationSettingsPage()
 
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_COMPACT_DISC, "Enable CDVD Precaching"), FSUI_CSTR("Loads the disc image into RAM before starting the virtual machine. Use with caution on UWP"),
 		"EmuCore", "CdvdPrecache", false);
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_COMPACT_DISC, "Enable CDVD Prefetching"),
+		FSUI_CSTR("Learns which parts of the disc each game reads, and loads them into RAM ahead of time. Reduces stutter on slow storage."),
+		"EmuCore", "CdvdPrefetch", false);
+	DrawIntRangeSetting(bsi, FSUI_ICONSTR(ICON_FA_MEMORY, "CDVD Prefetch Cache Size"),
+		FSUI_CSTR("Sets the amount of RAM used for prefetched disc sectors."), "EmuCore", "CdvdPrefetchCacheSize", 64, 8, 1024,
+		FSUI_CSTR("%d MB"), GetEffectiveBoolSetting(bsi, "EmuCore", "CdvdPrefetch", false));
 
 	MenuHeading(FSUI_CSTR("Frame Pacing/Latency Control"));
 
@@ -4831,6 +4837,9 @@ void FullscreenUI::DrawAudioSettingsPage()
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_STOPWATCH, "Minimal Output Latency"),
 		FSUI_CSTR("When enabled, the minimum supported output latency will be used for the host API."),
 		"SPU2/Output", "OutputLatencyMinimal", AudioStreamParameters::DEFAULT_OUTPUT_LATENCY_MINIMAL);
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_MICROCHIP, "Threaded Audio Output"),
+		FSUI_CSTR("Runs time stretching, expansion and output buffering on a separate thread. Sound is still mixed on the emulation thread."),
+		"SPU2/Output", "ThreadedOutput", false);
 
 	EndMenuButtons();
 }
@@ -9104,6 +9113,7 @@ TRANSLATE_NOOP("FullscreenUI", "Determines the amount of audio buffered before b
 TRANSLATE_NOOP("FullscreenUI", "%d ms");
 TRANSLATE_NOOP("FullscreenUI", "Determines how much latency there is between the audio being picked up by the host API, and played through speakers.");
 TRANSLATE_NOOP("FullscreenUI", "When enabled, the minimum supported output latency will be used for the host API.");
+TRANSLATE_NOOP("FullscreenUI", "Runs time stretching, expansion and output buffering on a separate thread. Sound is still mixed on the emulation thread.");
 TRANSLATE_NOOP("FullscreenUI", "Settings and Operations");
 TRANSLATE_NOOP("FullscreenUI", "Creates a new memory card file or folder.");
 TRANSLATE_NOOP("FullscreenUI", "Simulates a larger memory card by filtering saves only to the current game.");
@@ -9625,6 +9635,11 @@ TRANSLATE_NOOP("FullscreenUI", "Thread Pinning");
 TRANSLATE_NOOP("FullscreenUI", "Enable Host Filesystem");
 TRANSLATE_NOOP("FullscreenUI", "Enable Fast CDVD");
 TRANSLATE_NOOP("FullscreenUI", "Enable CDVD Precaching");
+TRANSLATE_NOOP("FullscreenUI", "Enable CDVD Prefetching");
+TRANSLATE_NOOP("FullscreenUI", "Learns which parts of the disc each game reads, and loads them into RAM ahead of time. Reduces stutter on slow storage.");
+TRANSLATE_NOOP("FullscreenUI", "CDVD Prefetch Cache Size");
+TRANSLATE_NOOP("FullscreenUI", "Sets the amount of RAM used for prefetched disc sectors.");
+TRANSLATE_NOOP("FullscreenUI", "%d MB");
 TRANSLATE_NOOP("FullscreenUI", "Maximum Frame Latency");
 TRANSLATE_NOOP("FullscreenUI", "Optimal Frame Pacing");
 TRANSLATE_NOOP("FullscreenUI", "Vertical Sync (VSync)");
@@ -9679,6 +9694,7 @@ TRANSLATE_NOOP("FullscreenUI", "Synchronization");
 TRANSLATE_NOOP("FullscreenUI", "Buffer Size");
 TRANSLATE_NOOP("FullscreenUI", "Output Latency");
 TRANSLATE_NOOP("FullscreenUI", "Minimal Output Latency");
+TRANSLATE_NOOP("FullscreenUI", "Threaded Audio Output");
 TRANSLATE_NOOP("FullscreenUI", "Create Memory Card");
 TRANSLATE_NOOP("FullscreenUI", "Memory Card Directory");
 TRANSLATE_NOOP("FullscreenUI", "Folder Memory Card Filter");
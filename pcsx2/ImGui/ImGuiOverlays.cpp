@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "BuildVersion.h"
+#include "CDVD/IsoPrefetchCache.h"
 #include "Config.h"
 #include "Counters.h"
 #include "GS.h"
@@ -361,6 +362,17 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				FormatProcessorStat(text, PerformanceMetrics::GetCaptureThreadUsage(), PerformanceMetrics::GetCaptureThreadAverageTime());
 				DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 			}
+
+			IsoPrefetchCache::Stats prefetch_stats;
+			if (IsoPrefetchCache::GetStats(&prefetch_stats))
+			{
+				const u64 reads = prefetch_stats.hits + prefetch_stats.misses;
+				text.clear();
+				text.append_format("CDVD: {:.1f}% hit ({} miss) | {}/{}MB",
+					(reads > 0) ? (static_cast<double>(prefetch_stats.hits) * 100.0 / static_cast<double>(reads)) : 0.0,
+					prefetch_stats.misses, prefetch_stats.resident_bytes / _1mb, prefetch_stats.budget_bytes / _1mb);
+				DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
 		}
 
 		if (GSConfig.OsdShowGPU)
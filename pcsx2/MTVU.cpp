@@ -2,11 +2,13 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Common.h"
+#include "DebugTools/GuestProfiler.h"
 #include "Gif_Unit.h"
 #include "MTVU.h"
 #include "VMManager.h"
 #include "Vif_Dynarec.h"
 
+#include <algorithm>
 #include <thread>
 
 VU_Thread vu1Thread;
@@ -123,11 +125,14 @@ void VU_Thread::Reset()
 	for (size_t i = 0; i < 4; ++i)
 		vu1Thread.vuCycles[i] = 0;
 	vu1Thread.mtvuInterrupts = 0;
+	m_recent_start_pcs.fill(NO_START_PC);
+	m_micro_changed = false;
 }
 
 void VU_Thread::ExecuteRingBuffer()
 {
 	Threading::SetNameOfCurrentThread("MTVU");
+	GuestProfiler::RegisterThread(GuestProfiler::SampledThread::MTVU);
 
 	for (;;)
 	{
@@ -150,6 +155,7 @@ void VU_Thread::ExecuteRingBuffer()
 					if (addr != -1)
 						VU1.VI[REG_TPC].UL = addr & 0x7FF;
 					CpuVU1->SetStartPC(VU1.VI[REG_TPC].UL << 3);
+					RecordStartPC(VU1.VI[REG_TPC].UL << 3);
 					CpuVU1->Execute(vu1RunCycles);
 					gifUnit.gifPath[GIF_PATH_1].FinishGSPacketMTVU();
 					semaXGkick.Post(); // Tell MTGS a path1 packet is complete
@@ -163,6 +169,7 @@ void VU_Thread::ExecuteRingBuffer()
 					u32 size = Read();
 					CpuVU1->Clear(vu_micro_addr, size);
 					Read(&VU1.Micro[vu_micro_addr], size);
+					m_micro_changed = true;
 					break;
 				}
 				case MTVU_VU_WRITE_DATA:
@@ -202,12 +209,49 @@ void VU_Thread::ExecuteRingBuffer()
 
 			CommitReadPos();
 		}
+
+		PreTranslatePrograms();
 	}
 
+	GuestProfiler::UnregisterThread(GuestProfiler::SampledThread::MTVU);
 	semaEvent.Kill();
 }
 
 
+void VU_Thread::RecordStartPC(u32 start_pc)
+{
+	auto it = std::find(m_recent_start_pcs.begin(), m_recent_start_pcs.end(), start_pc);
+	if (it == m_recent_start_pcs.end())
+		--it;
+	std::rotate(m_recent_start_pcs.begin(), it, it + 1);
+	m_recent_start_pcs[0] = start_pc;
+}
+
+// Compiling a program normally happens on its first execution, which the EE may be waiting on by then.
+// Uploads are usually followed by calls to the same few addresses, so once the queue has drained, get
+// those compiled while the EE is still busy producing the next batch of work. This has to happen before
+// we report the queue as empty, since the EE thread touches microVU directly once WaitVU() returns.
+void VU_Thread::PreTranslatePrograms()
+{
+	if (!m_micro_changed || !THREAD_VU1)
+		return;
+
+	for (const u32 start_pc : m_recent_start_pcs)
+	{
+		if (start_pc == NO_START_PC)
+			break;
+
+		// Don't hold up new packets or a WaitVU(), they'll compile whatever they need anyway. Leave the flag set
+		// so we carry on afterwards; programs which were already done are only a cache lookup the second time.
+		if (m_ato_read_pos.load(std::memory_order_relaxed) != GetWritePos() || semaEvent.IsWaitingForEmpty())
+			return;
+
+		CpuMicroVU1.PreTranslate(start_pc);
+	}
+
+	m_micro_changed = false;
+}
+
 // Should only be called by ReserveSpace()
 __ri void VU_Thread::WaitOnSize(s32 size)
 {
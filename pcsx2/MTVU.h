@@ -7,6 +7,7 @@
 #include "Vif_Dma.h"
 #include "VUmicro.h"
 
+#include <array>
 #include <thread>
 
 #define MTVU_LOG(...) do{} while(0)
@@ -28,6 +29,13 @@ class VU_Thread final {
 	Threading::WorkSema semaEvent;
 	std::atomic_bool m_shutdown_flag{false};
 
+	// Most recently used program start addresses, which get compiled ahead of time
+	// when new microcode arrives. Only accessed by the VU thread.
+	static constexpr u32 PRETRANSLATE_TARGETS = 4;
+	static constexpr u32 NO_START_PC = 0xFFFFFFFFu;
+	std::array<u32, PRETRANSLATE_TARGETS> m_recent_start_pcs;
+	bool m_micro_changed;
+
 	Threading::Thread m_thread;
 
 public:
@@ -98,6 +106,9 @@ public:
 private:
 	void ExecuteRingBuffer();
 
+	void RecordStartPC(u32 start_pc);
+	void PreTranslatePrograms();
+
 	void WaitOnSize(s32 size);
 	void ReserveSpace(s32 size);
 
@@ -209,6 +209,7 @@ void SysMemory::DumpMemoryMap()
 	DUMP_REGION("VIF1 Unpack Recompiler Cache", s_code_memory, HostMemoryMap::VIF1recOffset, HostMemoryMap::VIF1recSize);
 	DUMP_REGION("VIF Unpack Recompiler Cache", s_code_memory, HostMemoryMap::VIFUnpackRecOffset, HostMemoryMap::VIFUnpackRecSize);
 	DUMP_REGION("GS Software Renderer", s_code_memory, HostMemoryMap::SWrecOffset, HostMemoryMap::SWrecSize);
+	DUMP_REGION("GS Packed Decoders", s_code_memory, HostMemoryMap::GSPackedRecOffset, HostMemoryMap::GSPackedRecSize);
 
 
 #undef DUMP_REGION
@@ -81,8 +81,12 @@ namespace HostMemoryMap
 	static constexpr u32 SWrecOffset = VIFUnpackRecOffset + VIFUnpackRecSize;
 	static constexpr u32 SWrecSize = 0x04000000;
 
+	// GIF PACKED decoder loops (1mb)
+	static constexpr u32 GSPackedRecOffset = SWrecOffset + SWrecSize;
+	static constexpr u32 GSPackedRecSize = 0x100000;
+
 	// Overall size.
-	static constexpr u32 CodeSize = SWrecOffset + SWrecSize; // 305 mb
+	static constexpr u32 CodeSize = GSPackedRecOffset + GSPackedRecSize; // 306 mb
 } // namespace HostMemoryMap
 
 
@@ -137,6 +141,8 @@ namespace SysMemory
 	__fi static u8* GetVIFUnpackRecEnd() { return GetCodePtr(HostMemoryMap::VIFUnpackRecOffset + HostMemoryMap::VIFUnpackRecSize); }
 	__fi static u8* GetSWRec() { return GetCodePtr(HostMemoryMap::SWrecOffset); }
 	__fi static u8* GetSWRecEnd() { return GetCodePtr(HostMemoryMap::SWrecOffset + HostMemoryMap::SWrecSize); }
+	__fi static u8* GetGSPackedRec() { return GetCodePtr(HostMemoryMap::GSPackedRecOffset); }
+	__fi static u8* GetGSPackedRecEnd() { return GetCodePtr(HostMemoryMap::GSPackedRecOffset + HostMemoryMap::GSPackedRecSize); }
 
 	// clang-format on
 } // namespace SysMemory
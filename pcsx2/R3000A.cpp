@@ -3,6 +3,7 @@
 
 #include "R3000A.h"
 #include "Common.h"
+#include "CpuEventQueue.h"
 
 #include "SIO/Sio0.h"
 #include "Sif.h"
@@ -15,6 +16,8 @@
 #include "CDVD/Ps1CD.h"
 #include "CDVD/CDVD.h"
 
+#include <bit>
+
 using namespace R3000A;
 
 R3000Acpu *psxCpu;
@@ -34,9 +37,14 @@ bool iopEventTestIsActive = false;
 
 alignas(16) psxRegisters psxRegs;
 
+static CpuEventQueue s_iop_events;
+static CpuEventStats s_iop_event_stats;
+
 void psxReset()
 {
 	std::memset(&psxRegs, 0, sizeof(psxRegs));
+	s_iop_events.Clear();
+	s_iop_event_stats.Reset();
 
 	psxRegs.pc = 0xbfc00000; // Start in bootstrap
 	psxRegs.CP0.n.Status = 0x00400000; // BEV = 1
@@ -57,6 +65,18 @@ void psxShutdown() {
 	//psxCpu->Shutdown();
 }
 
+void psxRebuildEventQueue()
+{
+	s_iop_events.Rebuild(psxRegs.interrupt, psxRegs.sCycle, psxRegs.eCycle);
+}
+
+void psxLogEventStats()
+{
+	static constexpr const char* names[] = {"SIF2", "Cdvd", "SIF0", "SIF1", "Dma11", "Dma12", "SIO", "Cdrom",
+		"CdromRead", "CdvdRead", "CdvdSectorReady", "DEV9", "USB"};
+	s_iop_event_stats.Log("IOP", names, std::size(names));
+}
+
 void psxException(u32 code, u32 bd)
 {
 //	PSXCPU_LOG("psxException %x: %x, %x", code, psxHu32(0x1070), psxHu32(0x1074));
@@ -134,6 +154,7 @@ __fi void PSX_INT( IopEventId n, s32 ecycle )
 
 	psxRegs.sCycle[n] = psxRegs.cycle;
 	psxRegs.eCycle[n] = ecycle;
+	s_iop_events.Schedule(n, psxRegs.cycle + ecycle);
 
 	psxSetNextBranchDelta(ecycle);
 	const float mutiplier = static_cast<float>(PS2CLK) / static_cast<float>(PSXCLK);
@@ -153,55 +174,71 @@ static __fi void IopTestEvent( IopEventId n, void (*callback)() )
 
 	if( psxTestCycle( psxRegs.sCycle[n], psxRegs.eCycle[n] ) )
 	{
+		s_iop_event_stats.Record(n, static_cast<s32>(psxRegs.cycle - (psxRegs.sCycle[n] + psxRegs.eCycle[n])));
 		psxRegs.interrupt &= ~(1 << n);
 		callback();
 	}
 	else
-		psxSetNextBranch( psxRegs.sCycle[n], psxRegs.eCycle[n] );
-}
-
-static __fi void Sio0TestEvent(IopEventId n)
-{
-	if (!(psxRegs.interrupt & (1 << n)))
 	{
-		return;
+		// An earlier handler pushed it back without going through PSX_INT.
+		s_iop_events.Schedule(n, psxRegs.sCycle[n] + psxRegs.eCycle[n]);
 	}
+}
 
-	if (psxTestCycle(psxRegs.sCycle[n], psxRegs.eCycle[n]))
-	{
-		psxRegs.interrupt &= ~(1 << n);
-		g_Sio0.Interrupt(Sio0Interrupt::TEST_EVENT);
-	}
-	else
-	{
-		psxSetNextBranch(psxRegs.sCycle[n], psxRegs.eCycle[n]);
-	}
+static void Sio0EventInterrupt()
+{
+	g_Sio0.Interrupt(Sio0Interrupt::TEST_EVENT);
 }
 
+struct IopEventHandler
+{
+	IopEventId id;
+	void (*callback)();
+};
+
+// Events which are due on the same cycle are handled in this order.
+static constexpr IopEventHandler s_iop_event_handlers[] = {
+	{IopEvt_SIF0, sif0Interrupt},
+	{IopEvt_SIF1, sif1Interrupt},
+	{IopEvt_SIF2, sif2Interrupt},
+	{IopEvt_SIO, Sio0EventInterrupt},
+	{IopEvt_CdvdSectorReady, cdvdSectorReady},
+	{IopEvt_CdvdRead, cdvdReadInterrupt},
+
+	{IopEvt_Cdvd, cdvdActionInterrupt},
+	{IopEvt_Dma11, psxDMA11Interrupt}, // SIO2
+	{IopEvt_Dma12, psxDMA12Interrupt}, // SIO2
+	{IopEvt_Cdrom, cdrInterrupt},
+	{IopEvt_CdromRead, cdrReadInterrupt},
+	{IopEvt_DEV9, dev9Interrupt},
+	{IopEvt_USB, usbInterrupt},
+};
+
+// Maps event id to position in s_iop_event_handlers. Every IOP event has a handler.
+static constexpr std::array<u8, CpuEventQueue::MAX_EVENTS> s_iop_event_handler_index = []() {
+	std::array<u8, CpuEventQueue::MAX_EVENTS> ret = {};
+	for (size_t i = 0; i < std::size(s_iop_event_handlers); i++)
+		ret[s_iop_event_handlers[i].id] = static_cast<u8>(i);
+	return ret;
+}();
+
 static __fi void _psxTestInterrupts()
 {
-	IopTestEvent(IopEvt_SIF0,		sif0Interrupt);	// SIF0
-	IopTestEvent(IopEvt_SIF1,		sif1Interrupt);	// SIF1
-	IopTestEvent(IopEvt_SIF2,		sif2Interrupt);	// SIF2
-	Sio0TestEvent(IopEvt_SIO);
-	IopTestEvent(IopEvt_CdvdSectorReady, cdvdSectorReady);
-	IopTestEvent(IopEvt_CdvdRead,	cdvdReadInterrupt);
-
-	// Profile-guided Optimization (sorta)
-	// The following ints are rarely called.  Encasing them in a conditional
-	// as follows helps speed up most games.
-
-	if( psxRegs.interrupt & ((1 << IopEvt_Cdvd) | (1 << IopEvt_Dma11) | (1 << IopEvt_Dma12)
-		| (1 << IopEvt_Cdrom) | (1 << IopEvt_CdromRead) | (1 << IopEvt_DEV9) | (1 << IopEvt_USB)))
+	// Only look at the events which are due, in handler order.
+	u32 handlers = 0;
+	const u32 due = s_iop_events.PopDue(psxRegs.cycle, psxRegs.interrupt, psxRegs.sCycle, psxRegs.eCycle);
+	for (u32 pending = due; pending != 0; pending &= pending - 1)
+		handlers |= 1u << s_iop_event_handler_index[std::countr_zero(pending)];
+
+	for (; handlers != 0; handlers &= handlers - 1)
 	{
-		IopTestEvent(IopEvt_Cdvd,		cdvdActionInterrupt);
-		IopTestEvent(IopEvt_Dma11,		psxDMA11Interrupt);	// SIO2
-		IopTestEvent(IopEvt_Dma12,		psxDMA12Interrupt);	// SIO2
-		IopTestEvent(IopEvt_Cdrom,		cdrInterrupt);
-		IopTestEvent(IopEvt_CdromRead,	cdrReadInterrupt);
-		IopTestEvent(IopEvt_DEV9,		dev9Interrupt);
-		IopTestEvent(IopEvt_USB,		usbInterrupt);
+		const IopEventHandler& handler = s_iop_event_handlers[std::countr_zero(handlers)];
+		IopTestEvent(handler.id, handler.callback);
 	}
+
+	s_iop_events.Validate(psxRegs.interrupt, psxRegs.sCycle, psxRegs.eCycle);
+	if (!s_iop_events.IsEmpty())
+		psxSetNextBranch(s_iop_events.GetNextDeadline(), 0);
 }
 
 __ri void iopEventTest()
@@ -194,6 +194,8 @@ extern R3000Acpu psxInt;
 extern R3000Acpu psxRec;
 
 extern void psxReset();
+extern void psxRebuildEventQueue();
+extern void psxLogEventStats();
 extern void psxException(u32 code, u32 step);
 extern void iopEventTest();
 
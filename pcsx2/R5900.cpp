@@ -2,11 +2,11 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Common.h"
-
 #include "common/StringUtil.h"
 #include "ps2/BiosTools.h"
 #include "R5900.h"
 #include "R3000A.h"
+#include "CpuEventQueue.h"
 #include "ps2/pgif.h" // pgif init
 #include "VUmicro.h"
 #include "COP0.h"
@@ -29,6 +29,8 @@
 
 #include "fmt/format.h"
 
+#include <bit>
+
 using namespace R5900;	// for R5900 disasm tools
 
 s32 EEsCycle;		// used to sync the IOP to the EE
@@ -45,6 +47,9 @@ static constexpr uint eeWaitCycles = 3072;
 bool eeEventTestIsActive = false;
 EE_intProcessStatus eeRunInterruptScan = INT_NOT_RUNNING;
 
+static CpuEventQueue s_ee_events;
+static CpuEventStats s_ee_event_stats;
+
 u32 g_eeloadMain = 0, g_eeloadExec = 0, g_osdsys_str = 0;
 
 /* I don't know how much space for args there is in the memory block used for args in full boot mode,
@@ -60,8 +65,11 @@ void cpuReset()
 {
 	std::memset(&cpuRegs, 0, sizeof(cpuRegs));
 	std::memset(&fpuRegs, 0, sizeof(fpuRegs));
+	s_ee_events.Clear();
+	s_ee_event_stats.Reset();
 	std::memset(&tlb, 0, sizeof(tlb));
 	cachedTlbs.count = 0;
+	vtlb_UpdateCachedPages();
 
 	cpuRegs.pc				= 0xbfc00000; //set pc reg to stack
 	cpuRegs.CP0.n.Config	= 0x440;
@@ -240,6 +248,20 @@ __fi void cpuClearInt( uint i )
 	pxAssume( i < 32 );
 	cpuRegs.interrupt &= ~(1 << i);
 	cpuRegs.dmastall &= ~(1 << i);
+	s_ee_events.Remove(i);
+}
+
+void cpuRebuildEventQueue()
+{
+	s_ee_events.Rebuild(cpuRegs.interrupt, cpuRegs.sCycle, cpuRegs.eCycle);
+}
+
+void cpuLogEventStats()
+{
+	static constexpr const char* names[] = {"VIF0", "VIF1", "GIF", "FROM_IPU", "TO_IPU", "SIF0", "SIF1", "SIF2",
+		"FROM_SPR", "TO_SPR", "MFIFO_VIF", "MFIFO_GIF", nullptr, nullptr, nullptr, nullptr, "GIF_UNIT",
+		"VIF_VU0_FINISH", "VIF_VU1_FINISH", "IPU_PROCESS", "VU_MTVU_BUSY"};
+	s_ee_event_stats.Log("EE", names, std::size(names));
 }
 
 static __fi void TESTINT( u8 n, void (*callback)() )
@@ -248,13 +270,55 @@ static __fi void TESTINT( u8 n, void (*callback)() )
 
 	if(CHECK_INSTANTDMAHACK || cpuTestCycle( cpuRegs.sCycle[n], cpuRegs.eCycle[n] ) )
 	{
+		s_ee_event_stats.Record(n, static_cast<s32>(cpuRegs.cycle - (cpuRegs.sCycle[n] + cpuRegs.eCycle[n])));
 		cpuClearInt( n );
 		callback();
 	}
 	else
-		cpuSetNextEvent( cpuRegs.sCycle[n], cpuRegs.eCycle[n] );
+	{
+		// An earlier handler pushed it back without going through CPU_INT.
+		s_ee_events.Schedule(n, cpuRegs.sCycle[n] + cpuRegs.eCycle[n]);
+	}
 }
 
+struct EEEventHandler
+{
+	EE_EventType type;
+	void (*callback)();
+};
+
+// Events which are due on the same cycle are handled in this order.
+// The last group are rarely used, and used to sit behind a mask check.
+static constexpr EEEventHandler s_ee_event_handlers[] = {
+	{VU_MTVU_BUSY, MTVUInterrupt},
+	{DMAC_VIF1, vif1Interrupt},
+	{DMAC_GIF, gifInterrupt},
+	{DMAC_SIF0, EEsif0Interrupt},
+	{DMAC_SIF1, EEsif1Interrupt},
+
+	{DMAC_VIF0, vif0Interrupt},
+	{DMAC_FROM_IPU, ipu0Interrupt},
+	{DMAC_TO_IPU, ipu1Interrupt},
+	{IPU_PROCESS, ipuCMDProcess},
+	{DMAC_FROM_SPR, SPRFROMinterrupt},
+	{DMAC_TO_SPR, SPRTOinterrupt},
+	{DMAC_MFIFO_VIF, vifMFIFOInterrupt},
+	{DMAC_MFIFO_GIF, gifMFIFOInterrupt},
+	{VIF_VU0_FINISH, vif0VUFinish},
+	{VIF_VU1_FINISH, vif1VUFinish},
+};
+
+static constexpr u8 NO_EE_EVENT_HANDLER = 0xFF;
+
+// Maps event type to position in s_ee_event_handlers.
+static constexpr std::array<u8, CpuEventQueue::MAX_EVENTS> s_ee_event_handler_index = []() {
+	std::array<u8, CpuEventQueue::MAX_EVENTS> ret = {};
+	ret.fill(NO_EE_EVENT_HANDLER);
+	for (size_t i = 0; i < std::size(s_ee_event_handlers); i++)
+		ret[s_ee_event_handlers[i].type] = static_cast<u8>(i);
+	return ret;
+}();
+
 // [TODO] move this function to Dmac.cpp, and remove most of the DMAC-related headers from
 // being included into R5900.cpp.
 static __fi bool _cpuTestInterrupts()
@@ -271,34 +335,23 @@ static __fi bool _cpuTestInterrupts()
 	while (eeRunInterruptScan == INT_RUNNING)
 	{
 		/* These are 'pcsx2 interrupts', they handle asynchronous stuff
-		   that depends on the cycle timings */
-		TESTINT(VU_MTVU_BUSY, MTVUInterrupt);
-		TESTINT(DMAC_VIF1, vif1Interrupt);
-		TESTINT(DMAC_GIF, gifInterrupt);
-		TESTINT(DMAC_SIF0, EEsif0Interrupt);
-		TESTINT(DMAC_SIF1, EEsif1Interrupt);
-		// Profile-guided Optimization (sorta)
-		// The following ints are rarely called.  Encasing them in a conditional
-		// as follows helps speed up most games.
-
-		if (cpuRegs.interrupt & ((1 << DMAC_VIF0) | (1 << DMAC_FROM_IPU) | (1 << DMAC_TO_IPU)
-			| (1 << DMAC_FROM_SPR) | (1 << DMAC_TO_SPR) | (1 << DMAC_MFIFO_VIF) | (1 << DMAC_MFIFO_GIF)
-			| (1 << VIF_VU0_FINISH) | (1 << VIF_VU1_FINISH) | (1 << IPU_PROCESS)))
-		{
-			TESTINT(DMAC_VIF0, vif0Interrupt);
-
-			TESTINT(DMAC_FROM_IPU, ipu0Interrupt);
-			TESTINT(DMAC_TO_IPU, ipu1Interrupt);
-			TESTINT(IPU_PROCESS, ipuCMDProcess);
+		   that depends on the cycle timings. Only the ones which are due get looked at,
+		   so the cost doesn't depend on how many DMAs are in flight. */
+		const u32 due = CHECK_INSTANTDMAHACK ? cpuRegs.interrupt :
+			s_ee_events.PopDue(cpuRegs.cycle, cpuRegs.interrupt, cpuRegs.sCycle, cpuRegs.eCycle);
 
-			TESTINT(DMAC_FROM_SPR, SPRFROMinterrupt);
-			TESTINT(DMAC_TO_SPR, SPRTOinterrupt);
-
-			TESTINT(DMAC_MFIFO_VIF, vifMFIFOInterrupt);
-			TESTINT(DMAC_MFIFO_GIF, gifMFIFOInterrupt);
+		u32 handlers = 0;
+		for (u32 pending = due; pending != 0; pending &= pending - 1)
+		{
+			const u8 index = s_ee_event_handler_index[std::countr_zero(pending)];
+			if (index != NO_EE_EVENT_HANDLER)
+				handlers |= 1u << index;
+		}
 
-			TESTINT(VIF_VU0_FINISH, vif0VUFinish);
-			TESTINT(VIF_VU1_FINISH, vif1VUFinish);
+		for (; handlers != 0; handlers &= handlers - 1)
+		{
+			const EEEventHandler& handler = s_ee_event_handlers[std::countr_zero(handlers)];
+			TESTINT(handler.type, handler.callback);
 		}
 
 		if (eeRunInterruptScan == INT_REQ_LOOP)
@@ -309,6 +362,10 @@ static __fi bool _cpuTestInterrupts()
 
 	eeRunInterruptScan = INT_NOT_RUNNING;
 
+	s_ee_events.Validate(cpuRegs.interrupt, cpuRegs.sCycle, cpuRegs.eCycle);
+	if (!s_ee_events.IsEmpty())
+		cpuSetNextEvent(s_ee_events.GetNextDeadline(), 0);
+
 	if ((cpuRegs.interrupt & 0x1FFFF) & ~cpuRegs.dmastall)
 		return true;
 	else
@@ -528,6 +585,7 @@ __fi void CPU_INT( EE_EventType n, s32 ecycle)
 		cpuRegs.interrupt |= 1 << n;
 		cpuRegs.sCycle[n] = cpuRegs.cycle;
 		cpuRegs.eCycle[n] = 0;
+		s_ee_events.Schedule(n, cpuRegs.cycle);
 		return;
 	}
 
@@ -540,6 +598,7 @@ __fi void CPU_INT( EE_EventType n, s32 ecycle)
 	cpuRegs.interrupt |= 1 << n;
 	cpuRegs.sCycle[n] = cpuRegs.cycle;
 	cpuRegs.eCycle[n] = ecycle;
+	s_ee_events.Schedule(n, cpuRegs.cycle + ecycle);
 
 	// Interrupt is happening soon: make sure both EE and IOP are aware.
 
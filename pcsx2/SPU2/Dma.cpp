@@ -258,14 +258,7 @@ void V_Core::FinishDMAwrite()
 
 	const int cacheIdxStart = ActiveTSA / pcm_WordsPerBlock;
 	const int cacheIdxEnd = (buff1end + pcm_WordsPerBlock - 1) / pcm_WordsPerBlock;
-	PcmCacheEntry* cacheLine = &pcm_cache_data[cacheIdxStart];
-	PcmCacheEntry& cacheEnd = pcm_cache_data[cacheIdxEnd];
-
-	do
-	{
-		cacheLine->Validated = false;
-		cacheLine++;
-	} while (cacheLine != &cacheEnd);
+	PcmCache::InvalidateRange(cacheIdxStart, cacheIdxEnd);
 
 	//ConLog( "* SPU2: Cache Clear Range!  TSA=0x%x, TDA=0x%x (low8=0x%x, high8=0x%x, len=0x%x)\n",
 	//	ActiveTSA, buff1end, flagTSA, flagTDA, clearLen );
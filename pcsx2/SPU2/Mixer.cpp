@@ -9,6 +9,9 @@
 
 #include "common/Assertions.h"
 
+#include <cstring>
+#include <memory>
+
 static const s32 tbl_XA_Factor[16][2] =
 	{
 		{0, 0},
@@ -74,11 +77,140 @@ static void __forceinline IncrementNextA(V_Core& thiscore, uint voiceidx)
 // decoded pcm data, used to cache the decoded data so that it needn't be decoded
 // multiple times.  Cache chunks are decoded when the mixer requests the blocks, and
 // invalided when DMA transfers and memory writes are performed.
-PcmCacheEntry pcm_cache_data[pcm_BlockCount];
+namespace PcmCache
+{
+	struct Page
+	{
+		PcmCacheEntry Entries[pcm_BlocksPerPage];
+	};
+
+	static constexpr u32 INVALID_SLOT = 0xFFFFFFFFu;
+	static_assert(pcm_MaxResidentPages < 0xFF);
+
+	static u32 AllocatePage(u32 page);
+	static u32 GetPageSlot(u32 page);
+
+	static std::unique_ptr<Page> s_slot_data[pcm_MaxResidentPages];
+	static u64 s_slot_last_use[pcm_MaxResidentPages];
+	static u16 s_slot_page[pcm_MaxResidentPages];
+
+	// Slot index + 1 for each page, zero when the page isn't resident.
+	static u8 s_page_slot[pcm_PageCount];
+	static u32 s_slots_used = 0;
+	static u64 s_use_counter = 0;
+
+	s16 SilentBlock[pcm_DecodedSamplesPerBlock];
+} // namespace PcmCache
 
 int g_counter_cache_hits = 0;
 int g_counter_cache_misses = 0;
 int g_counter_cache_ignores = 0;
+int g_counter_cache_evictions = 0;
+
+u32 PcmCache::AllocatePage(u32 page)
+{
+	u32 slot;
+	if (s_slots_used < pcm_MaxResidentPages)
+	{
+		slot = s_slots_used++;
+		if (!s_slot_data[slot])
+			s_slot_data[slot] = std::make_unique<Page>();
+	}
+	else
+	{
+		// Recycle the least recently used page, skipping any a voice is still reading
+		// samples from, since SBuffer points directly into the page.
+		slot = INVALID_SLOT;
+		u64 oldest = UINT64_MAX;
+		for (u32 i = 0; i < pcm_MaxResidentPages; i++)
+		{
+			if (s_slot_last_use[i] >= oldest)
+				continue;
+
+			const s16* page_start = s_slot_data[i]->Entries[0].Sampledata;
+			const s16* page_end = page_start + sizeof(Page) / sizeof(s16);
+			bool in_use = false;
+			for (const V_Core& core : Cores)
+			{
+				for (const V_Voice& voice : core.Voices)
+					in_use |= (voice.SBuffer >= page_start && voice.SBuffer < page_end);
+			}
+			if (in_use)
+				continue;
+
+			slot = i;
+			oldest = s_slot_last_use[i];
+		}
+
+		// 48 voices can't pin more than 48 pages.
+		pxAssume(slot != INVALID_SLOT);
+		s_page_slot[s_slot_page[slot]] = 0;
+
+		if (IsDevBuild)
+			g_counter_cache_evictions++;
+	}
+
+	for (PcmCacheEntry& entry : s_slot_data[slot]->Entries)
+		entry.Validated = false;
+
+	s_slot_page[slot] = static_cast<u16>(page);
+	s_page_slot[page] = static_cast<u8>(slot + 1);
+	return slot;
+}
+
+__forceinline u32 PcmCache::GetPageSlot(u32 page)
+{
+	return static_cast<u32>(s_page_slot[page]) - 1;
+}
+
+PcmCacheEntry& PcmCache::GetEntry(u32 block)
+{
+	const u32 page = block / pcm_BlocksPerPage;
+	u32 slot = GetPageSlot(page);
+	if (slot == INVALID_SLOT) [[unlikely]]
+		slot = AllocatePage(page);
+
+	s_slot_last_use[slot] = ++s_use_counter;
+	return s_slot_data[slot]->Entries[block % pcm_BlocksPerPage];
+}
+
+void PcmCache::InvalidateBlock(u32 block)
+{
+	const u32 slot = GetPageSlot(block / pcm_BlocksPerPage);
+	if (slot != INVALID_SLOT)
+		s_slot_data[slot]->Entries[block % pcm_BlocksPerPage].Validated = false;
+}
+
+void PcmCache::InvalidateRange(u32 start_block, u32 end_block)
+{
+	while (start_block < end_block)
+	{
+		const u32 page = start_block / pcm_BlocksPerPage;
+		const u32 page_end = std::min(end_block, (page + 1) * pcm_BlocksPerPage);
+		const u32 slot = GetPageSlot(page);
+		if (slot != INVALID_SLOT)
+		{
+			PcmCacheEntry* entries = s_slot_data[slot]->Entries;
+			for (u32 block = start_block; block < page_end; block++)
+				entries[block % pcm_BlocksPerPage].Validated = false;
+		}
+
+		start_block = page_end;
+	}
+}
+
+void PcmCache::Clear()
+{
+	std::memset(s_page_slot, 0, sizeof(s_page_slot));
+	s_slots_used = 0;
+	s_use_counter = 0;
+	std::memset(s_slot_last_use, 0, sizeof(s_slot_last_use));
+}
+
+u32 PcmCache::GetResidentPageCount()
+{
+	return s_slots_used;
+}
 
 // LOOP/END sets the ENDX bit and sets NAX to LSA, and the voice is muted if LOOP is not set
 // LOOP seems to only have any effect on the block with LOOP/END set, where it prevents muting the voice
@@ -159,7 +291,7 @@ static __forceinline s32 GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 		}
 
 		const int cacheIdx = vc.NextA / pcm_WordsPerBlock;
-		PcmCacheEntry& cacheLine = pcm_cache_data[cacheIdx];
+		PcmCacheEntry& cacheLine = PcmCache::GetEntry(cacheIdx);
 		vc.SBuffer = cacheLine.Sampledata;
 
 		if (cacheLine.Validated && vc.Prev1 == cacheLine.Prev1 && vc.Prev2 == cacheLine.Prev2)
@@ -654,15 +786,20 @@ __forceinline void spu2Mix()
 			p_cachestat_counter = 0;
 			if (SPU2::MsgCache())
 			{
-				SPU2::ConLog(" * SPU2 > CacheStats > Hits: %d  Misses: %d  Ignores: %d\n",
+				const int lookups = g_counter_cache_hits + g_counter_cache_misses;
+				SPU2::ConLog(" * SPU2 > CacheStats > Hits: %d  Misses: %d  Ignores: %d  Hit rate: %.1f%%  Pages: %u/%d  Evictions: %d\n",
 					   g_counter_cache_hits,
 					   g_counter_cache_misses,
-					   g_counter_cache_ignores);
+					   g_counter_cache_ignores,
+					   lookups ? (g_counter_cache_hits * 100.0 / lookups) : 0.0,
+					   PcmCache::GetResidentPageCount(), pcm_MaxResidentPages,
+					   g_counter_cache_evictions);
 			}
 
 			g_counter_cache_hits =
 				g_counter_cache_misses =
-					g_counter_cache_ignores = 0;
+					g_counter_cache_ignores =
+						g_counter_cache_evictions = 0;
 		}
 	}
 }
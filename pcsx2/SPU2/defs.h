@@ -620,9 +620,14 @@ namespace SPU2Savestate
 // --------------------------------------------------------------------------------------
 //  the cache data size is determined by taking the number of adpcm blocks
 //  (2MB / 16) and multiplying it by the decoded block size (28 samples).
-//  Thus: pcm_cache_data = 7,340,032 bytes (ouch!)
+//  Thus: a flat cache would be 7,340,032 bytes (ouch!)
 //  Expanded: 16 bytes expands to 56 bytes [3.5:1 ratio]
 //    Resulting in 2MB * 3.5.
+//
+//  Most of that is never touched by a game, so the cache is sparse: blocks are grouped into
+//  pages which are only allocated once a voice decodes a block inside them, and only a
+//  limited working set of pages stays resident.  When the budget is exhausted, the least
+//  recently used page which no voice is currently playing from gets recycled.
 
 // The SPU2 has a dynamic memory range which is used for several internal operations, such as
 // registers, CORE 1/2 mixing, AutoDMAs, and some other fancy stuff.  We exclude this range
@@ -646,4 +651,30 @@ struct PcmCacheEntry
 	s32 Prev2;
 };
 
-extern PcmCacheEntry pcm_cache_data[pcm_BlockCount];
+// number of ADPCM blocks grouped into a single cache page.
+static constexpr int pcm_BlocksPerPage = 256;
+static constexpr int pcm_PageCount = pcm_BlockCount / pcm_BlocksPerPage;
+
+// maximum number of pages resident at once (~2.2MB worth of decoded data).
+static constexpr int pcm_MaxResidentPages = 128;
+
+namespace PcmCache
+{
+	/// Returns the cache entry for the specified block, allocating (or recycling) its page if needed.
+	extern PcmCacheEntry& GetEntry(u32 block);
+
+	/// Clears the validated flag on a single block, if its page is resident.
+	extern void InvalidateBlock(u32 block);
+
+	/// Clears the validated flag on all resident blocks in [start_block, end_block).
+	extern void InvalidateRange(u32 start_block, u32 end_block);
+
+	/// Drops every resident page. Page memory is kept around for reuse.
+	extern void Clear();
+
+	/// Returns the number of pages currently mapped to a block range.
+	extern u32 GetResidentPageCount();
+
+	/// Silent decoded block, used as the sample buffer for voices which haven't fetched a block yet.
+	extern s16 SilentBlock[pcm_DecodedSamplesPerBlock];
+} // namespace PcmCache
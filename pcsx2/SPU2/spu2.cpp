@@ -13,6 +13,10 @@
 #include "VMManager.h"
 
 #include "common/Error.h"
+#include "common/FPControl.h"
+#include "common/Threading.h"
+
+#include <atomic>
 
 const StereoOut32 StereoOut32::Empty(0, 0);
 
@@ -22,6 +26,12 @@ namespace SPU2
 	static void UpdateSampleRate();
 	static float GetNominalRate();
 	static void InternalReset(bool psxmode);
+
+	static void StartOutputThread();
+	static void StopOutputThread();
+	static void SyncOutputThread();
+	static void QueueOutputChunk(const s16* chunk);
+	static void OutputThreadEntryPoint();
 } // namespace SPU2
 
 u32 lClocks = 0;
@@ -33,6 +43,17 @@ static std::unique_ptr<AudioStream> s_output_stream;
 static std::array<s16, AudioStream::CHUNK_SIZE * 2> s_current_chunk;
 static u32 s_current_chunk_pos;
 
+// When threaded output is enabled, mixed chunks are handed to the output thread through this
+// single-producer/single-consumer ring, so time stretching doesn't run on the IOP thread.
+// Mixing itself stays inline, since IRQs and ENDX/DMA status are observed by the IOP.
+static constexpr u32 OUTPUT_QUEUE_SIZE = 64; // ~85ms at 48KHz
+static std::array<std::array<s16, AudioStream::CHUNK_SIZE * 2>, OUTPUT_QUEUE_SIZE> s_output_queue;
+static std::atomic<u32> s_output_queue_rpos{0};
+static std::atomic<u32> s_output_queue_wpos{0};
+static Threading::Thread s_output_thread;
+static Threading::WorkSema s_output_thread_sema;
+static std::atomic_bool s_output_thread_shutdown{false};
+
 u32 SPU2::GetConsoleSampleRate()
 {
 	return s_psxmode ? PSX_SAMPLE_RATE : SAMPLE_RATE;
@@ -97,6 +118,8 @@ void SPU2writeDMA7Mem(u16* pMem, u32 size)
 
 void SPU2::CreateOutputStream()
 {
+	SyncOutputThread();
+
 	// Persist volume through stream recreates.
 	const u32 volume = s_output_stream ? s_output_stream->GetOutputVolume() : GetResetVolume();
 	const u32 sample_rate = GetConsoleSampleRate();
@@ -186,6 +209,8 @@ void SPU2::InternalReset(bool psxmode)
 
 		Spdif.Info = 0; // Reset IRQ Status if it got set in a previously run game
 
+		PcmCache::Clear();
+
 		Cores[0].Init(0);
 		Cores[1].Init(1);
 	}
@@ -202,6 +227,8 @@ void SPU2::OnTargetSpeedChanged()
 	if (!s_output_stream)
 		return;
 
+	SyncOutputThread();
+
 	if (!s_output_stream->IsStretchEnabled())
 	{
 		s_output_stream->EmptyBuffer();
@@ -232,6 +259,9 @@ bool SPU2::Open()
 	InternalReset(false);
 
 	CreateOutputStream();
+	if (EmuConfig.SPU2.ThreadedOutput)
+		StartOutputThread();
+
 #ifdef PCSX2_DEVBUILD
 	WaveDump::Open();
 #endif
@@ -243,6 +273,7 @@ void SPU2::Close()
 {
 	FileLog("[%10d] SPU2 Close\n", Cycles);
 
+	StopOutputThread();
 	s_output_stream.reset();
 
 #ifdef PCSX2_DEVBUILD
@@ -282,9 +313,18 @@ void SPU2::CheckForConfigChanges(const Pcsx2Config& old_config)
 	}
 	else if (opts.IsTimeStretchEnabled() != oldopts.IsTimeStretchEnabled())
 	{
+		SyncOutputThread();
 		s_output_stream->SetStretchEnabled(opts.IsTimeStretchEnabled());
 	}
 
+	if (opts.ThreadedOutput != oldopts.ThreadedOutput)
+	{
+		if (opts.ThreadedOutput)
+			StartOutputThread();
+		else
+			StopOutputThread();
+	}
+
 #ifdef PCSX2_DEVBUILD
 	// AccessLog controls file output.
 	if (opts.AccessLog != oldopts.AccessLog)
@@ -421,9 +461,82 @@ __forceinline void spu2Output(StereoOut32 out)
 	{
 		s_current_chunk_pos = 0;
 
-		s_output_stream->WriteChunk(s_current_chunk.data());
+		if (s_output_thread.Joinable())
+			SPU2::QueueOutputChunk(s_current_chunk.data());
+		else
+			s_output_stream->WriteChunk(s_current_chunk.data());
 
 		if (SPU2::IsAudioCaptureActive()) [[unlikely]]
 			GSCapture::DeliverAudioPacket(s_current_chunk.data());
 	}
 }
+
+void SPU2::StartOutputThread()
+{
+	if (s_output_thread.Joinable())
+		return;
+
+	s_output_queue_rpos.store(0, std::memory_order_relaxed);
+	s_output_queue_wpos.store(0, std::memory_order_relaxed);
+	s_output_thread_shutdown.store(false, std::memory_order_relaxed);
+	s_output_thread_sema.Reset();
+	s_output_thread.Start(&SPU2::OutputThreadEntryPoint);
+}
+
+void SPU2::StopOutputThread()
+{
+	if (!s_output_thread.Joinable())
+		return;
+
+	// Remaining chunks get flushed before the thread exits.
+	s_output_thread_shutdown.store(true, std::memory_order_release);
+	s_output_thread_sema.NotifyOfWork();
+	s_output_thread.Join();
+}
+
+void SPU2::SyncOutputThread()
+{
+	if (s_output_thread.Joinable())
+		s_output_thread_sema.WaitForEmpty();
+}
+
+void SPU2::QueueOutputChunk(const s16* chunk)
+{
+	const u32 wpos = s_output_queue_wpos.load(std::memory_order_relaxed);
+	const u32 next_wpos = (wpos + 1) % OUTPUT_QUEUE_SIZE;
+
+	// Queue's full, the output thread has fallen behind. Shouldn't happen unless the host is overloaded.
+	if (next_wpos == s_output_queue_rpos.load(std::memory_order_acquire)) [[unlikely]]
+		s_output_thread_sema.WaitForEmpty();
+
+	std::memcpy(s_output_queue[wpos].data(), chunk, sizeof(s_output_queue[wpos]));
+	s_output_queue_wpos.store(next_wpos, std::memory_order_release);
+	s_output_thread_sema.NotifyOfWork();
+}
+
+void SPU2::OutputThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("SPU2 Output");
+
+	// Don't inherit the EE's rounding mode, SoundTouch expects the default.
+	FPControlRegister::SetCurrent(FPControlRegister::GetDefault());
+
+	for (;;)
+	{
+		s_output_thread_sema.WaitForWork();
+
+		u32 rpos = s_output_queue_rpos.load(std::memory_order_relaxed);
+		while (rpos != s_output_queue_wpos.load(std::memory_order_acquire))
+		{
+			s_output_stream->WriteChunk(s_output_queue[rpos].data());
+			rpos = (rpos + 1) % OUTPUT_QUEUE_SIZE;
+			s_output_queue_rpos.store(rpos, std::memory_order_release);
+		}
+
+		if (s_output_thread_shutdown.load(std::memory_order_acquire))
+		{
+			s_output_thread_sema.Kill();
+			break;
+		}
+	}
+}
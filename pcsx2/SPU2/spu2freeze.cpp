@@ -18,7 +18,7 @@ namespace SPU2Savestate
 
 	static void wipe_the_cache()
 	{
-		memset(pcm_cache_data, 0, pcm_BlockCount * sizeof(PcmCacheEntry));
+		PcmCache::Clear();
 	}
 } // namespace SPU2Savestate
 
@@ -145,16 +145,13 @@ s32 SPU2Savestate::ThawIt(DataBlock& spud)
 
 		wipe_the_cache();
 
-		// Go through the V_Voice structs and recalculate SBuffer pointer from
-		// the NextA setting.
+		// The cache is empty now, so point every voice at silence until it fetches
+		// its next block (same result as reading from a wiped cache entry).
 
 		for (int c = 0; c < 2; c++)
 		{
 			for (int v = 0; v < 24; v++)
-			{
-				const int cacheIdx = Cores[c].Voices[v].NextA / pcm_WordsPerBlock;
-				Cores[c].Voices[v].SBuffer = pcm_cache_data[cacheIdx].Sampledata;
-			}
+				Cores[c].Voices[v].SBuffer = PcmCache::SilentBlock;
 		}
 	}
 	return 0;
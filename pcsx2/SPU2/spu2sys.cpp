@@ -81,7 +81,7 @@ __forceinline void spu2M_Write(u32 addr, s16 value)
 	if (addr >= SPU2_DYN_MEMLINE)
 	{
 		const int cacheIdx = addr / pcm_WordsPerBlock;
-		pcm_cache_data[cacheIdx].Validated = false;
+		PcmCache::InvalidateBlock(cacheIdx);
 
 		if (SPU2::MsgToConsole() && SPU2::MsgCache())
 			SPU2::ConLog("* SPU2: PcmCache Block Clear at 0x%x (cacheIdx=0x%x)\n", addr, cacheIdx);
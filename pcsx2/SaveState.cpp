@@ -75,6 +75,7 @@ static void PostLoadPrep()
 			MapTLB(tlb[i], i);
 		}
 	}
+	vtlb_UpdateCachedPages();
 
 	if (EmuConfig.Gamefixes.GoemonTlbHack) GoemonPreloadTlb();
 	CBreakPoints::SetSkipFirst(BREAKPOINT_EE, 0);
@@ -185,6 +186,11 @@ bool SaveStateBase::FreezeInternals(Error* error)
 
 	Freeze(cpuRegs);		// cpu regs + COP0
 	Freeze(psxRegs);		// iop regs
+	if (IsLoading())
+	{
+		cpuRebuildEventQueue();
+		psxRebuildEventQueue();
+	}
 	Freeze(fpuRegs);
 	Freeze(tlb);			// tlbs
 	Freeze(cachedTlbs);		// cached tlbs
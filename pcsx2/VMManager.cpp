@@ -5,9 +5,11 @@
 #include "BuildVersion.h"
 #include "CDVD/CDVD.h"
 #include "CDVD/IsoReader.h"
+#include "Cache.h"
 #include "Counters.h"
 #include "DEV9/DEV9.h"
 #include "DebugTools/DebugInterface.h"
+#include "DebugTools/GuestProfiler.h"
 #include "DebugTools/SymbolImporter.h"
 #include "Elfheader.h"
 #include "FW.h"
@@ -1569,6 +1571,10 @@ bool VMManager::Initialize(VMBootParameters boot_params)
 
 	SetEmuThreadAffinities();
 
+	// Nothing has been compiled yet, so every block will be seen.
+	if (EmuConfig.Profiler.Enabled)
+		GuestProfiler::Start(EmuConfig.Profiler);
+
 	// do we want to load state?
 	if (!GSDumpReplayer::IsReplayingDump() && !state_to_load.empty())
 	{
@@ -1596,6 +1602,10 @@ void VMManager::Shutdown(bool save_resume_state)
 		vu1Thread.WaitVU();
 	MTGS::WaitGS();
 
+	cpuLogEventStats();
+	psxLogEventStats();
+	GuestProfiler::Stop();
+
 	if (!GSDumpReplayer::IsReplayingDump() && save_resume_state)
 	{
 		std::string resume_file_name(GetCurrentSaveStateFileName(-1));
@@ -2862,12 +2872,28 @@ void VMManager::CheckForCPUConfigChanges(const Pcsx2Config& old_config)
 
 	Console.WriteLn("Updating CPU configuration...");
 	FPControlRegister::SetCurrent(EmuConfig.Cpu.FPUFPCR);
+
+	// Restarting before the caches are cleared means every block gets registered again.
+	if (EmuConfig.Profiler != old_config.Profiler)
+	{
+		GuestProfiler::Stop();
+		if (EmuConfig.Profiler.Enabled)
+			GuestProfiler::Start(EmuConfig.Profiler);
+	}
+
 	Internal::ClearCPUExecutionCaches();
 	memBindConditionalHandlers();
 
 	if (EmuConfig.Cpu.Recompiler.EnableFastmem != old_config.Cpu.Recompiler.EnableFastmem)
 		vtlb_ResetFastmem();
 
+	// Lines left dirty in the data cache would otherwise never make it back to memory.
+	if (old_config.Cpu.Recompiler.EnableEECache && !EmuConfig.Cpu.Recompiler.EnableEECache)
+	{
+		writebackCache();
+		resetCache();
+	}
+
 	// did we toggle recompilers?
 	if (EmuConfig.Cpu.CpusChanged(old_config.Cpu))
 	{
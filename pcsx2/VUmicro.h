@@ -156,6 +156,9 @@ public:
 	void Execute(u32 cycles) override;
 	void Clear(u32 addr, u32 size) override;
 	void ResumeXGkick() override;
+
+	// Compiles the program entry at startPC for the current microcode, without running it.
+	void PreTranslate(u32 startPC);
 };
 
 extern InterpVU0 CpuIntVU0;
@@ -6,6 +6,7 @@
 #include "GS.h"
 #include "Gif_Unit.h"
 #include "MTVU.h"
+#include "GS/GSVector.h"
 
 #include <cmath>
 u32 laststall = 0;
@@ -462,7 +463,69 @@ static __fi float vuDouble(u32 f)
 }
 #endif
 
-static __fi float vuADD_TriAceHack(u32 a, u32 b)
+// The FMAC ops below work on all four fields at once with GSVector4, which maps to SSE or NEON
+// depending on the host. Results and flags have to match the scalar versions (vuDouble and
+// VU_MACx_UPDATE and friends) bit for bit, vu_interpreter_tests checks that they do.
+
+/// Bit-reverses a 4-bit lane mask, as the dest field and flag nibbles have x in the top bit.
+static constexpr u8 s_xyzw_reverse[16] = {0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf};
+
+static __fi GSVector4i vuFieldMask(u32 xyzw)
+{
+	return GSVector4i(-static_cast<s32>((xyzw >> 3) & 1), -static_cast<s32>((xyzw >> 2) & 1),
+		-static_cast<s32>((xyzw >> 1) & 1), -static_cast<s32>(xyzw & 1));
+}
+
+static __fi u32 vuLaneBits(const GSVector4i& mask)
+{
+	return s_xyzw_reverse[GSVector4::cast(mask).mask()];
+}
+
+static __fi GSVector4 vuDoubleVec(GSVector4i v)
+{
+#ifndef INT_VUDOUBLEHACK
+	const GSVector4i sign = GSVector4i(static_cast<s32>(0x80000000));
+	const GSVector4i exp_mask = GSVector4i(0x7f800000);
+	const GSVector4i exp = v & exp_mask;
+	v = v.blend(v & sign, exp.eq32(GSVector4i::zero()));
+	if (CHECK_VU_OVERFLOW(0))
+		v = v.blend((v & sign) | GSVector4i(0x7f7fffff), exp.eq32(exp_mask));
+#endif
+	return GSVector4::cast(v);
+}
+
+/// Vector version of VU_MAC_UPDATE. Returns the new MAC flags for all four fields, and fixes up
+/// denormal and overflowed results the same way.
+static __fi u32 vuMACFlagsVec(VURegs* VU, GSVector4i& result)
+{
+	const GSVector4i sign = GSVector4i(static_cast<s32>(0x80000000));
+	const GSVector4i v = result;
+	const GSVector4i exp = v.srl32<23>() & GSVector4i::x000000ff();
+	const GSVector4i zero = GSVector4i::cast(GSVector4::cast(v) == GSVector4::zero());
+	const GSVector4i under = exp.eq32(GSVector4i::zero()).andnot(zero);
+	const GSVector4i over = exp.eq32(GSVector4i::x000000ff());
+
+	result = v.blend(v & sign, under);
+	if (CHECK_VU_OVERFLOW((VU == &VU1) ? 1 : 0))
+		result = result.blend((v & sign) | GSVector4i(0x7f7fffff), over);
+
+	return vuLaneBits(zero | under) | (vuLaneBits(v) << 4) | (vuLaneBits(under) << 8) | (vuLaneBits(over) << 12);
+}
+
+/// Writes the fields of an FMAC result selected by xyzw to dst, and sets the MAC and status flags.
+/// Fields in keep_flags have their MAC flags left alone, rather than cleared when not written.
+static __fi void vuStoreMACResult(VURegs* VU, VECTOR* dst, const GSVector4& value, u32 xyzw, u32 keep_flags = 0)
+{
+	GSVector4i result = GSVector4i::cast(value);
+	const u32 flags = vuMACFlagsVec(VU, result);
+	const u32 write_flags = xyzw * 0x1111;
+	const u32 update_flags = (keep_flags * 0x1111) ^ 0xffff;
+	VU->macflag = (VU->macflag & ~update_flags) | (flags & write_flags & update_flags);
+	GSVector4i::store<true>(dst, GSVector4i::load<true>(dst).blend(result, vuFieldMask(xyzw)));
+	VU_STAT_UPDATE(VU);
+}
+
+static __fi GSVector4 vuADD_TriAceHack(const GSVector4i& fs, const GSVector4i& ft)
 {
 	// On VU0 TriAce Games use ADDi and expects these bit-perfect results:
 	//if (a == 0xb3e2a619 && b == 0x42546666) return vuDouble(0x42546666);
@@ -481,15 +544,13 @@ static __fi float vuADD_TriAceHack(u32 a, u32 b)
 	// but VU interpreters don't seem to need it currently:
 
 	// Update Sept 2021, now the interpreters don't suck, they do - Refraction
-	s32 aExp = (a >> 23) & 0xff;
-	s32 bExp = (b >> 23) & 0xff;
-	if (aExp - bExp >= 25) b &= 0x80000000;
-	if (aExp - bExp <=-25) a &= 0x80000000;
-	float ret = vuDouble(a) + vuDouble(b);
-	//DevCon.WriteLn("aExp = %d, bExp = %d", aExp, bExp);
-	//DevCon.WriteLn("0x%08x + 0x%08x = 0x%08x", a, b, (u32&)ret);
-	//DevCon.WriteLn("%f + %f = %f", vuDouble(a), vuDouble(b), ret);
-	return ret;
+	const GSVector4i sign = GSVector4i(static_cast<s32>(0x80000000));
+	const GSVector4i aExp = fs.srl32<23>() & GSVector4i::x000000ff();
+	const GSVector4i bExp = ft.srl32<23>() & GSVector4i::x000000ff();
+	const GSVector4i diff = aExp.sub32(bExp);
+	const GSVector4i a = fs.blend(fs & sign, diff.lt32(GSVector4i(-24)));
+	const GSVector4i b = ft.blend(ft & sign, diff.gt32(GSVector4i(24)));
+	return vuDoubleVec(a) + vuDoubleVec(b);
 }
 
 template <u32(*Fn)(u32)>
@@ -527,31 +588,24 @@ static __fi VECTOR* _getDst(VURegs* VU)
 		return &VU->VF[_Fd_];
 }
 
-template <float(*Fn)(u32, u32), MACOpDst Dst>
+template <GSVector4(*Fn)(const GSVector4i&, const GSVector4i&), MACOpDst Dst>
 static __fi void applyBinaryMACOp(VURegs* VU)
 {
-	VECTOR* dst = _getDst<Dst>(VU);
-	if (_X) { dst->i.x = VU_MACx_UPDATE(VU, Fn(VU->VF[_Fs_].i.x, VU->VF[_Ft_].i.x)); } else VU_MACx_CLEAR(VU);
-	if (_Y) { dst->i.y = VU_MACy_UPDATE(VU, Fn(VU->VF[_Fs_].i.y, VU->VF[_Ft_].i.y)); } else VU_MACy_CLEAR(VU);
-	if (_Z) { dst->i.z = VU_MACz_UPDATE(VU, Fn(VU->VF[_Fs_].i.z, VU->VF[_Ft_].i.z)); } else VU_MACz_CLEAR(VU);
-	if (_W) { dst->i.w = VU_MACw_UPDATE(VU, Fn(VU->VF[_Fs_].i.w, VU->VF[_Ft_].i.w)); } else VU_MACw_CLEAR(VU);
-	VU_STAT_UPDATE(VU);
+	const GSVector4i fs = GSVector4i::load<true>(&VU->VF[_Fs_]);
+	const GSVector4i ft = GSVector4i::load<true>(&VU->VF[_Ft_]);
+	vuStoreMACResult(VU, _getDst<Dst>(VU), Fn(fs, ft), _XYZW);
 }
 
-template <float(*Fn)(u32, u32), MACOpDst Dst>
+template <GSVector4(*Fn)(const GSVector4i&, const GSVector4i&), MACOpDst Dst>
 static __fi void applyBinaryMACOpBroadcast(VURegs* VU, u32 bc)
 {
-	VECTOR* dst = _getDst<Dst>(VU);
-	if (_X) { dst->i.x = VU_MACx_UPDATE(VU, Fn(VU->VF[_Fs_].i.x, bc)); } else VU_MACx_CLEAR(VU);
-	if (_Y) { dst->i.y = VU_MACy_UPDATE(VU, Fn(VU->VF[_Fs_].i.y, bc)); } else VU_MACy_CLEAR(VU);
-	if (_Z) { dst->i.z = VU_MACz_UPDATE(VU, Fn(VU->VF[_Fs_].i.z, bc)); } else VU_MACz_CLEAR(VU);
-	if (_W) { dst->i.w = VU_MACw_UPDATE(VU, Fn(VU->VF[_Fs_].i.w, bc)); } else VU_MACw_CLEAR(VU);
-	VU_STAT_UPDATE(VU);
+	const GSVector4i fs = GSVector4i::load<true>(&VU->VF[_Fs_]);
+	vuStoreMACResult(VU, _getDst<Dst>(VU), Fn(fs, GSVector4i(static_cast<s32>(bc))), _XYZW);
 }
 
-static __fi float _vuOpADD(u32 fs, u32 ft)
+static __fi GSVector4 _vuOpADD(const GSVector4i& fs, const GSVector4i& ft)
 {
-	return vuDouble(fs) + vuDouble(ft);
+	return vuDoubleVec(fs) + vuDoubleVec(ft);
 }
 
 static __fi void _vuADD(VURegs* VU)
@@ -600,9 +654,9 @@ static __fi void _vuADDAy(VURegs* VU) { vuADDAbc(VU, VU->VF[_Ft_].i.y); }
 static __fi void _vuADDAz(VURegs* VU) { vuADDAbc(VU, VU->VF[_Ft_].i.z); }
 static __fi void _vuADDAw(VURegs* VU) { vuADDAbc(VU, VU->VF[_Ft_].i.w); }
 
-static __fi float _vuOpSUB(u32 fs, u32 ft)
+static __fi GSVector4 _vuOpSUB(const GSVector4i& fs, const GSVector4i& ft)
 {
-	return vuDouble(fs) - vuDouble(ft);
+	return vuDoubleVec(fs) - vuDoubleVec(ft);
 }
 
 static __fi void _vuSUB(VURegs* VU)
@@ -639,9 +693,9 @@ static __fi void _vuSUBAy(VURegs* VU) { vuSUBAbc(VU, VU->VF[_Ft_].i.y); }
 static __fi void _vuSUBAz(VURegs* VU) { vuSUBAbc(VU, VU->VF[_Ft_].i.z); }
 static __fi void _vuSUBAw(VURegs* VU) { vuSUBAbc(VU, VU->VF[_Ft_].i.w); }
 
-static __fi float _vuOpMUL(u32 fs, u32 ft)
+static __fi GSVector4 _vuOpMUL(const GSVector4i& fs, const GSVector4i& ft)
 {
-	return vuDouble(fs) * vuDouble(ft);
+	return vuDoubleVec(fs) * vuDoubleVec(ft);
 }
 
 static __fi void _vuMUL(VURegs* VU)
@@ -679,31 +733,27 @@ static __fi void _vuMULAy(VURegs* VU) { vuMULAbc(VU, VU->VF[_Ft_].i.y); }
 static __fi void _vuMULAz(VURegs* VU) { vuMULAbc(VU, VU->VF[_Ft_].i.z); }
 static __fi void _vuMULAw(VURegs* VU) { vuMULAbc(VU, VU->VF[_Ft_].i.w); }
 
-template <float(*Fn)(u32, u32, u32), MACOpDst Dst>
+template <GSVector4(*Fn)(const GSVector4i&, const GSVector4i&, const GSVector4i&), MACOpDst Dst>
 static __fi void applyTernaryMACOp(VURegs* VU)
 {
-	VECTOR* dst = _getDst<Dst>(VU);
-	if (_X) { dst->i.x = VU_MACx_UPDATE(VU, Fn(VU->ACC.i.x, VU->VF[_Fs_].i.x, VU->VF[_Ft_].i.x)); } else VU_MACx_CLEAR(VU);
-	if (_Y) { dst->i.y = VU_MACy_UPDATE(VU, Fn(VU->ACC.i.y, VU->VF[_Fs_].i.y, VU->VF[_Ft_].i.y)); } else VU_MACy_CLEAR(VU);
-	if (_Z) { dst->i.z = VU_MACz_UPDATE(VU, Fn(VU->ACC.i.z, VU->VF[_Fs_].i.z, VU->VF[_Ft_].i.z)); } else VU_MACz_CLEAR(VU);
-	if (_W) { dst->i.w = VU_MACw_UPDATE(VU, Fn(VU->ACC.i.w, VU->VF[_Fs_].i.w, VU->VF[_Ft_].i.w)); } else VU_MACw_CLEAR(VU);
-	VU_STAT_UPDATE(VU);
+	const GSVector4i acc = GSVector4i::load<true>(&VU->ACC);
+	const GSVector4i fs = GSVector4i::load<true>(&VU->VF[_Fs_]);
+	const GSVector4i ft = GSVector4i::load<true>(&VU->VF[_Ft_]);
+	vuStoreMACResult(VU, _getDst<Dst>(VU), Fn(acc, fs, ft), _XYZW);
 }
 
-template <float(*Fn)(u32, u32, u32), MACOpDst Dst>
+template <GSVector4(*Fn)(const GSVector4i&, const GSVector4i&, const GSVector4i&), MACOpDst Dst>
 static __fi void applyTernaryMACOpBroadcast(VURegs* VU, u32 bc)
 {
-	VECTOR* dst = _getDst<Dst>(VU);
-	if (_X) { dst->i.x = VU_MACx_UPDATE(VU, Fn(VU->ACC.i.x, VU->VF[_Fs_].i.x, bc)); } else VU_MACx_CLEAR(VU);
-	if (_Y) { dst->i.y = VU_MACy_UPDATE(VU, Fn(VU->ACC.i.y, VU->VF[_Fs_].i.y, bc)); } else VU_MACy_CLEAR(VU);
-	if (_Z) { dst->i.z = VU_MACz_UPDATE(VU, Fn(VU->ACC.i.z, VU->VF[_Fs_].i.z, bc)); } else VU_MACz_CLEAR(VU);
-	if (_W) { dst->i.w = VU_MACw_UPDATE(VU, Fn(VU->ACC.i.w, VU->VF[_Fs_].i.w, bc)); } else VU_MACw_CLEAR(VU);
-	VU_STAT_UPDATE(VU);
+	const GSVector4i acc = GSVector4i::load<true>(&VU->ACC);
+	const GSVector4i fs = GSVector4i::load<true>(&VU->VF[_Fs_]);
+	vuStoreMACResult(VU, _getDst<Dst>(VU), Fn(acc, fs, GSVector4i(static_cast<s32>(bc))), _XYZW);
 }
 
-static __fi float _vuOpMADD(u32 acc, u32 fs, u32 ft)
+// Kept as a separate multiply and add, the VU doesn't fuse them.
+static __fi GSVector4 _vuOpMADD(const GSVector4i& acc, const GSVector4i& fs, const GSVector4i& ft)
 {
-	return vuDouble(acc) + vuDouble(fs) * vuDouble(ft);
+	return vuDoubleVec(acc) + vuDoubleVec(fs) * vuDoubleVec(ft);
 }
 
 static __fi void _vuMADD(VURegs* VU)
@@ -740,9 +790,9 @@ static __fi void _vuMADDAy(VURegs* VU) { vuMADDAbc(VU, VU->VF[_Ft_].i.y); }
 static __fi void _vuMADDAz(VURegs* VU) { vuMADDAbc(VU, VU->VF[_Ft_].i.z); }
 static __fi void _vuMADDAw(VURegs* VU) { vuMADDAbc(VU, VU->VF[_Ft_].i.w); }
 
-static __fi float _vuOpMSUB(u32 acc, u32 fs, u32 ft)
+static __fi GSVector4 _vuOpMSUB(const GSVector4i& acc, const GSVector4i& fs, const GSVector4i& ft)
 {
-	return vuDouble(acc) - vuDouble(fs) * vuDouble(ft);
+	return vuDoubleVec(acc) - vuDoubleVec(fs) * vuDoubleVec(ft);
 }
 
 static __fi void _vuMSUB(VURegs* VU)
@@ -782,38 +832,37 @@ static __fi void _vuMSUBAw(VURegs* VU) { vuMSUBAbc(VU, VU->VF[_Ft_].i.w); }
 // The functions below are floating point semantics min/max on integer representations to get
 // the effect of a floating point min/max without issues with denormal and special numbers.
 
-static __fi u32 fp_max(u32 a, u32 b)
+static __fi GSVector4i fp_max(const GSVector4i& a, const GSVector4i& b)
 {
-	return ((s32)a < 0 && (s32)b < 0) ? std::min<s32>(a, b) : std::max<s32>(a, b);
+	return a.max_i32(b).blend(a.min_i32(b), (a & b).sra32<31>());
 }
 
-static __fi u32 fp_min(u32 a, u32 b)
+static __fi GSVector4i fp_min(const GSVector4i& a, const GSVector4i& b)
 {
-	return ((s32)a < 0 && (s32)b < 0) ? std::max<s32>(a, b) : std::min<s32>(a, b);
+	return a.min_i32(b).blend(a.max_i32(b), (a & b).sra32<31>());
 }
 
-template <u32(*Fn)(u32, u32)>
-static __fi void applyMinMax(VURegs* VU)
+template <GSVector4i(*Fn)(const GSVector4i&, const GSVector4i&)>
+static __fi void applyMinMaxVec(VURegs* VU, const GSVector4i& ft)
 {
 	if (_Fd_ == 0)
 		return;
 
-	if (_X) VU->VF[_Fd_].i.x = Fn(VU->VF[_Fs_].i.x, VU->VF[_Ft_].i.x);
-	if (_Y) VU->VF[_Fd_].i.y = Fn(VU->VF[_Fs_].i.y, VU->VF[_Ft_].i.y);
-	if (_Z) VU->VF[_Fd_].i.z = Fn(VU->VF[_Fs_].i.z, VU->VF[_Ft_].i.z);
-	if (_W) VU->VF[_Fd_].i.w = Fn(VU->VF[_Fs_].i.w, VU->VF[_Ft_].i.w);
+	const GSVector4i fs = GSVector4i::load<true>(&VU->VF[_Fs_]);
+	const GSVector4i fd = GSVector4i::load<true>(&VU->VF[_Fd_]);
+	GSVector4i::store<true>(&VU->VF[_Fd_], fd.blend(Fn(fs, ft), vuFieldMask(_XYZW)));
 }
 
-template <u32(*Fn)(u32, u32)>
-static __fi void applyMinMaxBroadcast(VURegs* VU, u32 bc)
+template <GSVector4i(*Fn)(const GSVector4i&, const GSVector4i&)>
+static __fi void applyMinMax(VURegs* VU)
 {
-	if (_Fd_ == 0)
-		return;
+	applyMinMaxVec<Fn>(VU, GSVector4i::load<true>(&VU->VF[_Ft_]));
+}
 
-	if (_X) VU->VF[_Fd_].i.x = Fn(VU->VF[_Fs_].i.x, bc);
-	if (_Y) VU->VF[_Fd_].i.y = Fn(VU->VF[_Fs_].i.y, bc);
-	if (_Z) VU->VF[_Fd_].i.z = Fn(VU->VF[_Fs_].i.z, bc);
-	if (_W) VU->VF[_Fd_].i.w = Fn(VU->VF[_Fs_].i.w, bc);
+template <GSVector4i(*Fn)(const GSVector4i&, const GSVector4i&)>
+static __fi void applyMinMaxBroadcast(VURegs* VU, u32 bc)
+{
+	applyMinMaxVec<Fn>(VU, GSVector4i(static_cast<s32>(bc)));
 }
 
 static __fi void _vuMAX(VURegs* VU)
@@ -838,35 +887,21 @@ static __fi void _vuMINIy(VURegs* VU) { applyMinMaxBroadcast<fp_min>(VU, VU->VF[
 static __fi void _vuMINIz(VURegs* VU) { applyMinMaxBroadcast<fp_min>(VU, VU->VF[_Ft_].i.z); }
 static __fi void _vuMINIw(VURegs* VU) { applyMinMaxBroadcast<fp_min>(VU, VU->VF[_Ft_].i.w); }
 
+// The outer product ops always write xyz, and leave the w MAC flags as they were.
+
 static __fi void _vuOPMULA(VURegs* VU)
 {
-	VU->ACC.i.x = VU_MACx_UPDATE(VU, vuDouble(VU->VF[_Fs_].i.y) * vuDouble(VU->VF[_Ft_].i.z));
-	VU->ACC.i.y = VU_MACy_UPDATE(VU, vuDouble(VU->VF[_Fs_].i.z) * vuDouble(VU->VF[_Ft_].i.x));
-	VU->ACC.i.z = VU_MACz_UPDATE(VU, vuDouble(VU->VF[_Fs_].i.x) * vuDouble(VU->VF[_Ft_].i.y));
-	VU_STAT_UPDATE(VU);
+	const GSVector4 fs = vuDoubleVec(GSVector4i::load<true>(&VU->VF[_Fs_]));
+	const GSVector4 ft = vuDoubleVec(GSVector4i::load<true>(&VU->VF[_Ft_]));
+	vuStoreMACResult(VU, &VU->ACC, fs.yzxw() * ft.zxyw(), 0xe, 0x1);
 }
 
 static __fi void _vuOPMSUB(VURegs* VU)
 {
-	VECTOR* dst;
-	float ftx, fty, ftz;
-	float fsx, fsy, fsz;
-	if (_Fd_ == 0)
-		dst = &RDzero;
-	else
-		dst = &VU->VF[_Fd_];
-
-	ftx = vuDouble(VU->VF[_Ft_].i.x);
-	fty = vuDouble(VU->VF[_Ft_].i.y);
-	ftz = vuDouble(VU->VF[_Ft_].i.z);
-	fsx = vuDouble(VU->VF[_Fs_].i.x);
-	fsy = vuDouble(VU->VF[_Fs_].i.y);
-	fsz = vuDouble(VU->VF[_Fs_].i.z);
-
-	dst->i.x = VU_MACx_UPDATE(VU, vuDouble(VU->ACC.i.x) - fsy * ftz);
-	dst->i.y = VU_MACy_UPDATE(VU, vuDouble(VU->ACC.i.y) - fsz * ftx);
-	dst->i.z = VU_MACz_UPDATE(VU, vuDouble(VU->ACC.i.z) - fsx * fty);
-	VU_STAT_UPDATE(VU);
+	const GSVector4 acc = vuDoubleVec(GSVector4i::load<true>(&VU->ACC));
+	const GSVector4 fs = vuDoubleVec(GSVector4i::load<true>(&VU->VF[_Fs_]));
+	const GSVector4 ft = vuDoubleVec(GSVector4i::load<true>(&VU->VF[_Ft_]));
+	vuStoreMACResult(VU, _getDst<MACOpDst::Fd>(VU), acc - fs.yzxw() * ft.zxyw(), 0xe, 0x1);
 }
 
 static __fi void _vuNOP(VURegs* VU)
@@ -29,10 +29,12 @@
 
 #include "fmt/format.h"
 
+#include <algorithm>
 #include <bit>
 #include <map>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
 #define FASTMEM_LOG(...)
 //#define FASTMEM_LOG(...) Console.WriteLn(__VA_ARGS__)
@@ -219,6 +221,29 @@ __inline int CheckCache(u32 addr)
 
 	return false;
 }
+
+// Mirrors CheckCache() at page granularity, so it may give false positives for partial pages but never misses.
+// Called whenever the TLB changes, which is also when cache lines can start resolving to a different host address.
+void vtlb_UpdateCachedPages()
+{
+	std::memset(vtlbdata.cached_pages, 0, sizeof(vtlbdata.cached_pages));
+
+	const auto mark = [](u32 start, u32 mask) {
+		const u32 end = static_cast<u32>(std::min<u64>(static_cast<u64>(start) + mask, 0xFFFFFFFFu));
+		for (u32 page = start >> VTLB_PAGE_BITS; page <= (end >> VTLB_PAGE_BITS); page++)
+			vtlbdata.cached_pages[page >> 3] |= static_cast<u8>(1u << (page & 7));
+	};
+
+	for (size_t i = 0; i < cachedTlbs.count; i++)
+	{
+		if (cachedTlbs.CacheEnabled0[i])
+			mark(cachedTlbs.PFN0s[i], cachedTlbs.PageMasks[i]);
+		if (cachedTlbs.CacheEnabled1[i])
+			mark(cachedTlbs.PFN1s[i], cachedTlbs.PageMasks[i]);
+	}
+
+	clearCacheFastTags();
+}
 // --------------------------------------------------------------------------------------
 // Interpreter Implementations of VTLB Memory Operations.
 // --------------------------------------------------------------------------------------
@@ -232,27 +257,24 @@ DataType vtlb_memRead(u32 addr)
 
 	if (!vmv.isHandler(addr))
 	{
-		if (!CHECK_EEREC)
+		if (CHECK_CACHE && CheckCache(addr))
 		{
-			if (CHECK_CACHE && CheckCache(addr))
+			switch (DataSize)
 			{
-				switch (DataSize)
-				{
-					case 8:
-						return readCache8(addr);
-						break;
-					case 16:
-						return readCache16(addr);
-						break;
-					case 32:
-						return readCache32(addr);
-						break;
-					case 64:
-						return readCache64(addr);
-						break;
-
-						jNO_DEFAULT;
-				}
+				case 8:
+					return readCache8(addr);
+					break;
+				case 16:
+					return readCache16(addr);
+					break;
+				case 32:
+					return readCache32(addr);
+					break;
+				case 64:
+					return readCache64(addr);
+					break;
+
+					jNO_DEFAULT;
 			}
 		}
 
@@ -287,12 +309,9 @@ RETURNS_R128 vtlb_memRead128(u32 mem)
 
 	if (!vmv.isHandler(mem))
 	{
-		if (!CHECK_EEREC)
+		if (CHECK_CACHE && CheckCache(mem))
 		{
-			if (CHECK_CACHE && CheckCache(mem))
-			{
-				return readCache128(mem);
-			}
+			return readCache128(mem);
 		}
 
 		return r128_load(reinterpret_cast<const void*>(vmv.assumePtr(mem)));
@@ -315,25 +334,22 @@ void vtlb_memWrite(u32 addr, DataType data)
 
 	if (!vmv.isHandler(addr))
 	{
-		if (!CHECK_EEREC)
+		if (CHECK_CACHE && CheckCache(addr))
 		{
-			if (CHECK_CACHE && CheckCache(addr))
+			switch (DataSize)
 			{
-				switch (DataSize)
-				{
-					case 8:
-						writeCache8(addr, data);
-						return;
-					case 16:
-						writeCache16(addr, data);
-						return;
-					case 32:
-						writeCache32(addr, data);
-						return;
-					case 64:
-						writeCache64(addr, data);
-						return;
-				}
+				case 8:
+					writeCache8(addr, data);
+					return;
+				case 16:
+					writeCache16(addr, data);
+					return;
+				case 32:
+					writeCache32(addr, data);
+					return;
+				case 64:
+					writeCache64(addr, data);
+					return;
 			}
 		}
 
@@ -354,14 +370,11 @@ void TAKES_R128 vtlb_memWrite128(u32 mem, r128 value)
 
 	if (!vmv.isHandler(mem))
 	{
-		if (!CHECK_EEREC)
+		if (CHECK_CACHE && CheckCache(mem))
 		{
-			if (CHECK_CACHE && CheckCache(mem))
-			{
-				alignas(16) const u128 r = r128_to_u128(value);
-				writeCache128(mem, &r);
-				return;
-			}
+			alignas(16) const u128 r = r128_to_u128(value);
+			writeCache128(mem, &r);
+			return;
 		}
 
 		r128_store_unaligned((void*)vmv.assumePtr(mem), value);
@@ -637,7 +650,7 @@ static void TAKES_R128 vtlbUnmappedVWriteLg(u32 addr, r128 data) { vtlb_Miss(add
 template <typename OperandType>
 static OperandType vtlbUnmappedPReadSm(u32 addr) {
 	vtlb_BusError(addr, 0);
-	if(!CHECK_EEREC && CHECK_CACHE && CheckCache(addr)){
+	if(CHECK_CACHE && CheckCache(addr)){
 		switch (sizeof(OperandType)) {
 			case 1: return readCache8(addr, false);
 			case 2: return readCache16(addr, false);
@@ -648,12 +661,12 @@ static OperandType vtlbUnmappedPReadSm(u32 addr) {
 	}
 	return 0;
 }
-static RETURNS_R128 vtlbUnmappedPReadLg(u32 addr) { vtlb_BusError(addr, 0); if (!CHECK_EEREC && CHECK_CACHE && CheckCache(addr)){ return readCache128(addr, false); } return r128_zero(); }
+static RETURNS_R128 vtlbUnmappedPReadLg(u32 addr) { vtlb_BusError(addr, 0); if (CHECK_CACHE && CheckCache(addr)){ return readCache128(addr, false); } return r128_zero(); }
 
 template <typename OperandType>
 static void vtlbUnmappedPWriteSm(u32 addr, OperandType data) {
 	vtlb_BusError(addr, 1);
-	if (!CHECK_EEREC && CHECK_CACHE && CheckCache(addr)) {
+	if (CHECK_CACHE && CheckCache(addr)) {
 		switch (sizeof(OperandType)) {
 			case 1: writeCache8(addr, data, false); break;
 			case 2: writeCache16(addr, data, false); break;
@@ -663,7 +676,7 @@ static void vtlbUnmappedPWriteSm(u32 addr, OperandType data) {
 		}
 	}
 }
-static void TAKES_R128 vtlbUnmappedPWriteLg(u32 addr, r128 data) { vtlb_BusError(addr, 1); if (!CHECK_EEREC && CHECK_CACHE && CheckCache(addr)) { writeCache128(addr, reinterpret_cast<mem128_t*>(&data) /*Safe??*/, false); }}
+static void TAKES_R128 vtlbUnmappedPWriteLg(u32 addr, r128 data) { vtlb_BusError(addr, 1); if (CHECK_CACHE && CheckCache(addr)) { writeCache128(addr, reinterpret_cast<mem128_t*>(&data) /*Safe??*/, false); }}
 // clang-format on
 
 // --------------------------------------------------------------------------------------
@@ -1479,9 +1492,24 @@ struct vtlb_PageProtectionInfo
 	u32 ReverseRamMap;
 
 	vtlb_ProtectionMode Mode;
+
+	// Which 32nds of the page have had blocks recompiled from them since the page was protected.
+	// Lets a write fault tell apart code being modified from data which happens to share the page.
+	u32 CodeLines;
+
+	// Set when the write which took the page out of write protection landed on code.
+	bool CodeWritten;
 };
 
+static constexpr u32 CODE_LINE_SHIFT = __pageshift - 5;
+
 alignas(16) static vtlb_PageProtectionInfo m_PageProtectInfo[Ps2MemSize::TotalRam >> __pageshift];
+static vtlb_PageProtectionStats m_PageProtectStats[Ps2MemSize::TotalRam >> __pageshift];
+
+static __fi uptr mmap_GetRamPage(u32 paddr)
+{
+	return ((uptr)PSM(paddr & ~__pagemask) - (uptr)eeMem->Main) >> __pageshift;
+}
 
 
 // returns:
@@ -1529,10 +1557,39 @@ void mmap_MarkCountedRamPage(u32 paddr)
 		paddr >> __pageshift);
 
 	m_PageProtectInfo[rampage].Mode = ProtMode_Write;
+	m_PageProtectInfo[rampage].CodeLines = 0;
+	m_PageProtectInfo[rampage].CodeWritten = false;
+	m_PageProtectStats[rampage].Protects++;
 	HostSys::MemProtect(&eeMem->Main[rampage << __pageshift], __pagesize, PageAccess_ReadOnly());
 	vtlb_UpdateFastmemProtection(rampage << __pageshift, __pagesize, PageAccess_ReadOnly());
 }
 
+// paddr - physically mapped PS2 address of a block which has just been recompiled.
+void mmap_MarkRamPageCode(u32 paddr, u32 size)
+{
+	pxAssert(eeMem);
+
+	const uptr rampage = mmap_GetRamPage(paddr);
+	const u32 first = (paddr & __pagemask) >> CODE_LINE_SHIFT;
+	const u32 last = ((paddr & __pagemask) + std::max(size, 1u) - 1) >> CODE_LINE_SHIFT;
+	m_PageProtectInfo[rampage].CodeLines |= ((2u << last) - 1) & ~((1u << first) - 1);
+}
+
+// Returns false if the page last lost its write protection to a write which didn't touch any code.
+bool mmap_RamPageHadCodeWrite(u32 paddr)
+{
+	pxAssert(eeMem);
+
+	return m_PageProtectInfo[mmap_GetRamPage(paddr)].CodeWritten;
+}
+
+vtlb_PageProtectionStats& mmap_GetRamPageStats(u32 paddr)
+{
+	pxAssert(eeMem);
+
+	return m_PageProtectStats[mmap_GetRamPage(paddr)];
+}
+
 // offset - offset of address relative to psM.
 // All recompiled blocks belonging to the page are cleared, and any new blocks recompiled
 // from code residing in this page will use manual protection.
@@ -1542,6 +1599,14 @@ static __fi void mmap_ClearCpuBlock(uint offset)
 
 	int rampage = offset >> __pageshift;
 
+	vtlb_PageProtectionInfo& info = m_PageProtectInfo[rampage];
+	info.CodeWritten = (info.CodeLines & (1u << ((offset & __pagemask) >> CODE_LINE_SHIFT))) != 0;
+	info.CodeLines = 0;
+	if (info.CodeWritten)
+		m_PageProtectStats[rampage].CodeFaults++;
+	else
+		m_PageProtectStats[rampage].DataFaults++;
+
 	// Assertion: This function should never be run on a block that's already under
 	// manual protection.  Indicates a logic error in the recompiler or protection code.
 	pxAssertMsg(m_PageProtectInfo[rampage].Mode != ProtMode_Manual,
@@ -1553,6 +1618,37 @@ static __fi void mmap_ClearCpuBlock(uint offset)
 	Cpu->Clear(m_PageProtectInfo[rampage].ReverseRamMap, __pagesize);
 }
 
+// Lists the pages which changed protection mode the most, worst first.
+static void mmap_LogBlockTrackingStats()
+{
+	static constexpr size_t MAX_PAGES = 32;
+
+	const auto changes = [](const vtlb_PageProtectionStats& stats) {
+		return stats.CodeFaults + stats.DataFaults + stats.Resets + stats.Discards;
+	};
+
+	std::vector<u32> pages;
+	for (u32 i = 0; i < std::size(m_PageProtectStats); i++)
+	{
+		if (changes(m_PageProtectStats[i]) > 0)
+			pages.push_back(i);
+	}
+	if (pages.empty())
+		return;
+
+	std::sort(pages.begin(), pages.end(), [&changes](u32 lhs, u32 rhs) {
+		return changes(m_PageProtectStats[lhs]) > changes(m_PageProtectStats[rhs]);
+	});
+
+	DevCon.WriteLn("(mmap) Block tracking: %zu pages changed protection mode", pages.size());
+	for (size_t i = 0; i < std::min(pages.size(), MAX_PAGES); i++)
+	{
+		const vtlb_PageProtectionStats& stats = m_PageProtectStats[pages[i]];
+		DevCon.WriteLn("  0x%07x: %u protects, %u code faults, %u data faults, %u resets, %u discards, %u uncounted",
+			pages[i] << __pageshift, stats.Protects, stats.CodeFaults, stats.DataFaults, stats.Resets, stats.Discards, stats.Uncounted);
+	}
+}
+
 PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exception_pc, void* fault_address, bool is_write)
 {
 	pxAssert(eeMem);
@@ -1599,7 +1695,9 @@ PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exceptio
 void mmap_ResetBlockTracking()
 {
 	//DbgCon.WriteLn( "vtlb/mmap: Block Tracking reset..." );
+	mmap_LogBlockTrackingStats();
 	std::memset(m_PageProtectInfo, 0, sizeof(m_PageProtectInfo));
+	std::memset(m_PageProtectStats, 0, sizeof(m_PageProtectStats));
 	if (eeMem)
 		HostSys::MemProtect(eeMem->Main, Ps2MemSize::ExposedRam, PageAccess_ReadWrite());
 	vtlb_UpdateFastmemProtection(0, Ps2MemSize::ExposedRam, PageAccess_ReadWrite());
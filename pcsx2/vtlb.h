@@ -71,6 +71,7 @@ extern void vtlb_DynV2P();
 extern void vtlb_VMap(u32 vaddr,u32 paddr,u32 sz);
 extern void vtlb_VMapBuffer(u32 vaddr,void* buffer,u32 sz);
 extern void vtlb_VMapUnmap(u32 vaddr,u32 sz);
+extern void vtlb_UpdateCachedPages();
 extern bool vtlb_ResolveFastmemMapping(uptr* addr);
 extern bool vtlb_GetGuestAddress(uptr host_addr, u32* guest_addr);
 extern void vtlb_UpdateFastmemProtection(u32 paddr, u32 size, PageProtectionMode prot);
@@ -197,6 +198,10 @@ namespace vtlb_private
 
 		uptr fastmem_base;
 
+		// One bit per virtual page, set if any of the page falls inside a cached TLB entry.
+		// Lets the recompiler skip the cache lookup for pages which can never hit.
+		u8 cached_pages[VTLB_VMAP_ITEMS / 8];
+
 		MapData()
 		{
 			vmap = NULL;
@@ -228,8 +233,22 @@ enum vtlb_ProtectionMode
 	ProtMode_NotRequired // page doesn't require any protection
 };
 
+// How often a page has changed protection mode, for the block tracking report.
+struct vtlb_PageProtectionStats
+{
+	u32 Protects; // put under write protection
+	u32 CodeFaults; // write protection fault on a part of the page with recompiled code in it
+	u32 DataFaults; // write protection fault on a part of the page with only data in it
+	u32 Resets; // manually checked page re-protected after running long enough
+	u32 Discards; // manually checked block found its code had changed
+	u32 Uncounted; // manually checked page gave up on being re-protected
+};
+
 extern vtlb_ProtectionMode mmap_GetRamPageInfo(u32 paddr);
 extern void mmap_MarkCountedRamPage(u32 paddr);
+extern void mmap_MarkRamPageCode(u32 paddr, u32 size);
+extern bool mmap_RamPageHadCodeWrite(u32 paddr);
+extern vtlb_PageProtectionStats& mmap_GetRamPageStats(u32 paddr);
 extern void mmap_ResetBlockTracking();
 
 // --------------------------------------------------------------------------------------
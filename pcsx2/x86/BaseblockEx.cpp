@@ -66,3 +66,16 @@ void BaseBlocks::Link(u32 pc, s32* jumpptr)
 		*jumpptr = (s32)(recompiler - (sptr)(jumpptr + 1));
 	links.insert(std::pair<u32, uptr>(pc, (uptr)jumpptr));
 }
+
+void BaseBlocks::Unlink(u32 pc, s32* jumpptr)
+{
+	std::pair<linkiter_t, linkiter_t> range = links.equal_range(pc);
+	for (linkiter_t i = range.first; i != range.second; ++i)
+	{
+		if (i->second == (uptr)jumpptr)
+		{
+			links.erase(i);
+			return;
+		}
+	}
+}
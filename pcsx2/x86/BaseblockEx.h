@@ -188,6 +188,29 @@ public:
 		return (*this)[Index(startpc)];
 	}
 
+	/// Calls func(idx, block) for every block covering part of [addr, addr + size * 4), last block first.
+	/// Blocks compiled through the start of another block can end past blocks after them, so this can't
+	/// stop at the first block ending before addr. Blocks never cross a 4K page though, so it stops there.
+	/// func is allowed to remove blocks at or after idx.
+	template <class F>
+	void ForEachOverlapping(u32 addr, u32 size, const F& func)
+	{
+		const u32 page_start = addr & ~0xfffu;
+		for (int idx = LastIndex(addr + size * 4 - 4); idx >= 0; idx--)
+		{
+			BASEBLOCKEX* pexblock = &blocks[idx];
+			if (pexblock->startpc + pexblock->size * 4 <= addr)
+			{
+				if (pexblock->startpc < page_start)
+					break;
+
+				continue;
+			}
+
+			func(idx, pexblock);
+		}
+	}
+
 	__fi void Remove(int first, int last)
 	{
 		pxAssert(first <= last);
@@ -219,6 +242,10 @@ public:
 
 	void Link(u32 pc, s32* jumpptr);
 
+	/// Stops a jump added with Link() from being updated when the block at pc is compiled or removed.
+	/// Needed before pointing the jump somewhere else.
+	void Unlink(u32 pc, s32* jumpptr);
+
 	__fi void Reset()
 	{
 		blocks.clear();
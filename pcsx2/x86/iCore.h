@@ -197,6 +197,9 @@ void _flushXMMregs();
 #define EEINST_XMM    0x20 // var will be used in xmm ops
 #define EEINST_USED   0x40
 
+#define EEINST_COP1_DEAD_OU_FLAGS 0x2 // full-mode FPU: O/U flags are overwritten before being read
+#define EEINST_COP1_DEAD_ACC_FLAG 0x4 // full-mode FPU: ACC overflow flag is overwritten before being read
+
 #define EEINST_COP2_DENORMALIZE_STATUS_FLAG 0x100
 #define EEINST_COP2_NORMALIZE_STATUS_FLAG 0x200
 #define EEINST_COP2_STATUS_FLAG 0x400
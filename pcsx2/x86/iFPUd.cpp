@@ -11,6 +11,9 @@
 
 /* Can be made faster by not converting stuff back and forth between instructions. */
 
+/* COP1FlagPass marks instructions whose O/U or ACC flag updates get overwritten later in the block,
+   those updates are skipped (sticky flags are always set). */
+
 
 //----------------------------------------------------------------
 // FPU emulation status:
@@ -85,8 +88,7 @@ struct FPUd_Globals
 {
 	u32 neg[4], pos[4];
 
-	u32 pos_inf[4], neg_inf[4],
-	    one_exp[4];
+	u32 one_exp[4];
 
 	u64 dbl_one_exp[2];
 
@@ -105,9 +107,7 @@ alignas(32) static const FPUd_Globals s_const =
 	{0x80000000, 0xffffffff, 0xffffffff, 0xffffffff},
 	{0x7fffffff, 0xffffffff, 0xffffffff, 0xffffffff},
 
-	{SINGLE(0, 0xff, 0), 0, 0, 0},
-	{SINGLE(1, 0xff, 0), 0, 0, 0},
-	{SINGLE(0,    1, 0), 0, 0, 0},
+	{SINGLE(0, 1, 0), 0, 0, 0},
 
 	{DOUBLE(0, 1, 0), 0},
 
@@ -122,20 +122,30 @@ alignas(32) static const FPUd_Globals s_const =
 };
 
 
+static bool AreOUFlagsDead()
+{
+	return (g_pCurInstInfo->info & EEINST_COP1_DEAD_OU_FLAGS) != 0;
+}
+
+static bool IsACCFlagDead()
+{
+	return (g_pCurInstInfo->info & EEINST_COP1_DEAD_ACC_FLAG) != 0;
+}
+
 // ToDouble : converts single-precision PS2 float to double-precision IEEE float
 
 void ToDouble(int reg)
 {
-	xUCOMI.SS(xRegisterSSE(reg), ptr[s_const.pos_inf]); // Sets ZF if reg is equal or incomparable to pos_inf
-	u8* to_complex = JE8(0); // Complex conversion if positive infinity or NaN
-	xUCOMI.SS(xRegisterSSE(reg), ptr[s_const.neg_inf]);
-	u8* to_complex2 = JE8(0); // Complex conversion if negative infinity
+	// Exponent of 0xff is what IEEE sees as INF/NaN, test it in one go with the sign shifted out.
+	xMOVD(eax, xRegisterSSE(reg));
+	xADD(eax, eax);
+	xCMP(eax, 0xff000000);
+	u8* to_complex = JAE8(0); // Complex conversion if INF/NaN
 
 	xCVTSS2SD(xRegisterSSE(reg), xRegisterSSE(reg)); // Simply convert
 	u8* end = JMP8(0);
 
 	x86SetJ8(to_complex);
-	x86SetJ8(to_complex2);
 
 	// Special conversion for when IEEE sees the value in reg as an INF/NaN
 	xPSUB.D(xRegisterSSE(reg), ptr[s_const.one_exp]); // Lower exponent by one
@@ -164,7 +174,9 @@ void ToDouble(int reg)
 
 void ToPS2FPU_Full(int reg, bool flags, int absreg, bool acc, bool addsub)
 {
-	if (flags)
+	acc = acc && !IsACCFlagDead();
+
+	if (flags && !AreOUFlagsDead())
 		xAND(ptr32[&fpuRegs.fprc[31]], ~(FPUflagO | FPUflagU));
 	if (flags && acc)
 		xAND(ptr32[&fpuRegs.ACCflag], ~1);
@@ -305,7 +317,8 @@ void SetMaxValue(int regd)
 
 #define CLEAR_OU_FLAGS \
 	do { \
-		xAND(ptr32[&fpuRegs.fprc[31]], ~(FPUflagO | FPUflagU)); \
+		if (!AreOUFlagsDead()) \
+			xAND(ptr32[&fpuRegs.fprc[31]], ~(FPUflagO | FPUflagU)); \
 	} while (0)
 
 
@@ -651,6 +664,10 @@ void recMaddsub(int info, int regd, int op, bool acc)
 	int sreg, treg;
 	ALLOC_S(sreg); ALLOC_T(treg);
 
+	// The multiply's overflow flag is tested below, so it can't be left over from a previous instruction.
+	if (AreOUFlagsDead())
+		xAND(ptr32[&fpuRegs.fprc[31]], ~(FPUflagO | FPUflagU));
+
 	FPU_MUL(info, sreg, sreg, treg, false);
 
 	GET_ACC(treg);
@@ -679,7 +696,7 @@ void recMaddsub(int info, int regd, int op, bool acc)
 	CLEAR_OU_FLAGS; //clear U flag
 	if (FPU_FLAGS_OVERFLOW)
 		xOR(ptr32[&fpuRegs.fprc[31]], FPUflagO | FPUflagSO);
-	if (FPU_FLAGS_OVERFLOW && acc)
+	if (FPU_FLAGS_OVERFLOW && acc && !IsACCFlagDead())
 		xOR(ptr32[&fpuRegs.ACCflag], 1);
 	u32* skipall = JMP32(0);
 
@@ -11,6 +11,7 @@
 #include "VMManager.h"
 
 #include <time.h>
+#include <unordered_map>
 
 #ifndef _WIN32
 #include <sys/types.h>
@@ -25,6 +26,7 @@
 #include "common/Path.h"
 #include "common/Perf.h"
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/GuestProfiler.h"
 
 //#define DUMP_BLOCKS 1
 //#define TRACE_BLOCKS 1
@@ -71,6 +73,20 @@ static u32 s_nEndBlock = 0; // what psxpc the current block ends
 static u32 s_branchTo;
 static bool s_nBlockFF;
 
+// Indirect branches (JR/JALR) end in an inline cache of the last target they went to, which jumps
+// straight to that block when psxRegs.pc matches. The jump is a regular block link, so it follows
+// the target being recompiled or cleared. Sites which keep missing are switched to the dispatcher.
+//
+// Site layout, starting from the cmp immediate:
+//   cmp eax, imm32     ; cached pc
+//   jne rel32          ; miss stub, or the dispatcher once the site gives up
+//   jmp rel32          ; cached target's block
+static constexpr u32 INDIRECT_BRANCH_EMPTY_PC = 0x7fffffff; // never a valid pc, needs an imm32
+static constexpr u32 INDIRECT_BRANCH_MISS_OFFSET = 4 + 2;
+static constexpr u32 INDIRECT_BRANCH_TARGET_OFFSET = INDIRECT_BRANCH_MISS_OFFSET + 4 + 1;
+static constexpr u32 INDIRECT_BRANCH_MAX_MISSES = 16;
+static std::unordered_map<uptr, u32> s_indirectBranchMisses;
+
 static u32 s_saveConstRegs[32];
 static u32 s_saveHasConstReg = 0, s_saveFlushedConstReg = 0;
 static EEINST* s_psaveInstInfo = nullptr;
@@ -933,6 +949,7 @@ void recResetIOP()
 		memset(s_pInstCache, 0, sizeof(EEINST) * s_nInstCacheSize);
 
 	recBlocks.Reset();
+	s_indirectBranchMisses.clear();
 	g_psxMaxRecMem = 0;
 
 	psxbranch = 0;
@@ -1051,6 +1068,46 @@ static __fi void recClearIOP(u32 Addr, u32 Size)
 		pc += PSXREC_CLEARM(pc);
 }
 
+static void iopRecUpdateIndirectBranchCache(u8* site)
+{
+	u32* cached_pc = reinterpret_cast<u32*>(site);
+	s32* miss_jump = reinterpret_cast<s32*>(site + INDIRECT_BRANCH_MISS_OFFSET);
+	s32* target_jump = reinterpret_cast<s32*>(site + INDIRECT_BRANCH_TARGET_OFFSET);
+
+	if (*cached_pc != INDIRECT_BRANCH_EMPTY_PC)
+		recBlocks.Unlink(HWADDR(*cached_pc), target_jump);
+
+	if (++s_indirectBranchMisses[reinterpret_cast<uptr>(site)] > INDIRECT_BRANCH_MAX_MISSES)
+	{
+		// Too many targets (returns through $ra, usually), don't bother caching.
+		*cached_pc = INDIRECT_BRANCH_EMPTY_PC;
+		*miss_jump = static_cast<s32>(reinterpret_cast<uptr>(iopDispatcherReg) - reinterpret_cast<uptr>(miss_jump + 1));
+		*target_jump = static_cast<s32>(reinterpret_cast<uptr>(iopDispatcherReg) - reinterpret_cast<uptr>(target_jump + 1));
+		return;
+	}
+
+	// If the target isn't compiled yet, this links to the JIT compiler, which gets patched over later.
+	*cached_pc = psxRegs.pc;
+	recBlocks.Link(HWADDR(psxRegs.pc), target_jump);
+}
+
+static void psxEmitIndirectBranchCache()
+{
+	xMOV(eax, ptr32[&psxRegs.pc]);
+	xCMP(eax, INDIRECT_BRANCH_EMPTY_PC);
+	u8* site = xGetPtr() - sizeof(u32);
+
+	s32* miss_jump = xJcc32(Jcc_NotEqual);
+	s32* target_jump = xJcc32(Jcc_Unconditional);
+	pxAssert(reinterpret_cast<u8*>(miss_jump) == site + INDIRECT_BRANCH_MISS_OFFSET);
+	pxAssert(reinterpret_cast<u8*>(target_jump) == site + INDIRECT_BRANCH_TARGET_OFFSET);
+	*target_jump = static_cast<s32>(reinterpret_cast<uptr>(iopDispatcherReg) - reinterpret_cast<uptr>(target_jump + 1));
+
+	*miss_jump = static_cast<s32>(reinterpret_cast<uptr>(xGetPtr()) - reinterpret_cast<uptr>(miss_jump + 1));
+	xFastCall((void*)iopRecUpdateIndirectBranchCache, site);
+	xJMP((void*)iopDispatcherReg);
+}
+
 void psxSetBranchReg(u32 reg)
 {
 	psxbranch = 1;
@@ -1094,7 +1151,7 @@ void psxSetBranchReg(u32 reg)
 	_psxFlushCall(FLUSH_EVERYTHING);
 	iPsxBranchTest(0xffffffff, 1);
 
-	JMP32((uptr)iopDispatcherReg - ((uptr)x86Ptr + 5));
+	psxEmitIndirectBranchCache();
 }
 
 void psxSetBranchImm(u32 imm)
@@ -1755,6 +1812,7 @@ StartRecomp:
 	s_pCurBlockEx->x86size = xGetPtr() - recPtr;
 
 	Perf::iop.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+	GuestProfiler::RegisterBlock(GuestProfiler::Source::IOP, (void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
 
 	recPtr = xGetPtr();
 
@@ -349,6 +349,121 @@ void COP2MicroFinishPass::Run(u32 start, u32 end, EEINST* inst_cache)
 #endif
 }
 
+COP1FlagPass::COP1FlagPass() = default;
+
+COP1FlagPass::~COP1FlagPass() = default;
+
+void COP1FlagPass::Run(u32 start, u32 end, EEINST* inst_cache)
+{
+	m_last_ou_write = nullptr;
+	m_last_acc_write = nullptr;
+
+	ForEachInstruction(start, end, inst_cache, [this](u32 apc, EEINST* inst) {
+		// Other instructions don't touch the FPU flags. Anything reading them is a COP1 instruction.
+		if (_Opcode_ != 021)
+		{
+			// syscall/break, the handler could look at FCR31.
+			if (_Opcode_ == 0 && (_Funct_ == 12 || _Funct_ == 13))
+				m_last_ou_write = m_last_acc_write = nullptr;
+
+			return true;
+		}
+
+		bool writes_ou = false, writes_acc = false, reads_acc = false;
+		if (_Rs_ == 16)
+		{
+			switch (_Funct_)
+			{
+				case 0: // add.s
+				case 1: // sub.s
+				case 2: // mul.s
+				case 5: // abs.s
+				case 7: // neg.s
+				case 40: // max.s
+				case 41: // min.s
+					writes_ou = true;
+					break;
+
+				case 24: // adda.s
+				case 25: // suba.s
+				case 26: // mula.s
+					writes_ou = writes_acc = true;
+					break;
+
+				case 28: // madd.s
+				case 29: // msub.s
+					writes_ou = reads_acc = true;
+					break;
+
+				case 30: // madda.s
+				case 31: // msuba.s
+					writes_ou = writes_acc = reads_acc = true;
+					break;
+
+				case 3: // div.s
+				case 4: // sqrt.s
+				case 6: // mov.s
+				case 22: // rsqrt.s
+				case 48: // c.f.s
+				case 50: // c.eq.s
+				case 52: // c.lt.s
+				case 54: // c.le.s
+					// don't touch O/U or ACC
+					return true;
+
+				default:
+					// cvt goes through the regular FPU, assume it can read anything
+					m_last_ou_write = m_last_acc_write = nullptr;
+					return true;
+			}
+		}
+		else if (_Rs_ == 0 || _Rs_ == 4)
+		{
+			// mfc1/mtc1
+			return true;
+		}
+		else
+		{
+			// cfc1/ctc1/bc1
+			m_last_ou_write = m_last_acc_write = nullptr;
+			return true;
+		}
+
+		// Each of these clears O/U before setting them, so a previous write is dead unless read in between.
+		if (writes_ou)
+		{
+			if (m_last_ou_write)
+				m_last_ou_write->info |= EEINST_COP1_DEAD_OU_FLAGS;
+			m_last_ou_write = inst;
+		}
+
+		if (reads_acc)
+			m_last_acc_write = nullptr;
+		if (writes_acc)
+		{
+			if (m_last_acc_write)
+				m_last_acc_write->info |= EEINST_COP1_DEAD_ACC_FLAG;
+			m_last_acc_write = inst;
+		}
+
+		return true;
+	});
+
+#if 0
+	DumpAnnotatedBlock(start, end, inst_cache);
+#endif
+}
+
+void COP1FlagPass::DumpAnnotatedBlock(u32 start, u32 end, EEINST* inst_cache)
+{
+	AnalysisPass::DumpAnnotatedBlock(start, end, inst_cache, [](u32, EEINST* eeinst, std::string& d) {
+		if (eeinst->info & EEINST_COP1_DEAD_OU_FLAGS)
+			d.append(" COP1_DEAD_OU_FLAGS");
+		if (eeinst->info & EEINST_COP1_DEAD_ACC_FLAG)
+			d.append(" COP1_DEAD_ACC_FLAG");
+	});
+}
+
 /////////////////////////////////////////////////////////////////////
 // Back-Prop Function Tables - Gathering Info
 // Note to anyone changing these: writes must go before reads.
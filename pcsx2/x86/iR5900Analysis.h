@@ -59,6 +59,23 @@ namespace R5900
 
 		void Run(u32 start, u32 end, EEINST* inst_cache) override;
 	};
+
+	/// Finds full-accuracy FPU instructions whose O/U and ACC overflow flag updates are overwritten by a
+	/// later instruction in the block before anything can read them, so the recompiler can skip them.
+	class COP1FlagPass final : public AnalysisPass
+	{
+	public:
+		COP1FlagPass();
+		~COP1FlagPass();
+
+		void Run(u32 start, u32 end, EEINST* inst_cache) override;
+
+	private:
+		void DumpAnnotatedBlock(u32 start, u32 end, EEINST* inst_cache);
+
+		EEINST* m_last_ou_write = nullptr;
+		EEINST* m_last_acc_write = nullptr;
+	};
 } // namespace R5900
 
 void recBackpropBSC(u32 code, EEINST* prev, EEINST* pinst);
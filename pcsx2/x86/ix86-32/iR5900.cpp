@@ -4,6 +4,7 @@
 #include "Common.h"
 #include "CDVD/CDVD.h"
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/GuestProfiler.h"
 #include "Elfheader.h"
 #include "GS.h"
 #include "Memory.h"
@@ -37,6 +38,8 @@
 #include <zlib.h>
 #endif
 
+#include <unordered_set>
+
 using namespace x86Emitter;
 using namespace R5900;
 
@@ -90,6 +93,15 @@ static BASEBLOCKEX* s_pCurBlockEx = nullptr;
 u32 s_nEndBlock = 0; // what pc the current block ends
 u32 s_branchTo;
 static bool s_nBlockFF;
+static bool s_nBlockHot; // second tier, don't stop at the start of other blocks
+
+// Blocks which stopped early because the next instruction already started a block count down from
+// this each time they run, and are recompiled without stopping there when it reaches zero.
+static constexpr u16 HOT_BLOCK_THRESHOLD = 4096;
+static constexpr u32 HOT_BLOCK_COUNTER_COUNT = 0x10000;
+
+alignas(16) static u16 s_hotBlockCounters[HOT_BLOCK_COUNTER_COUNT];
+static std::unordered_set<u32> s_hotBlocks;
 
 // save states for branches
 GPR_reg64 s_saveConstRegs[32];
@@ -346,6 +358,7 @@ void recCall(void (*func)())
 static void recRecompile(const u32 startpc);
 static void dyna_block_discard(u32 start, u32 sz);
 static void dyna_page_reset(u32 start, u32 sz);
+static void dyna_block_promote(u32 start);
 
 static const void* DispatcherEvent = nullptr;
 static const void* DispatcherReg = nullptr;
@@ -353,6 +366,7 @@ static const void* JITCompile = nullptr;
 static const void* EnterRecompiledCode = nullptr;
 static const void* DispatchBlockDiscard = nullptr;
 static const void* DispatchPageReset = nullptr;
+static const void* DispatchHotBlock = nullptr;
 
 static void recEventTest()
 {
@@ -461,6 +475,14 @@ static const void* _DynGen_DispatchPageReset()
 	return retval;
 }
 
+static const void* _DynGen_DispatchHotBlock()
+{
+	u8* retval = xGetPtr();
+	xFastCall((const void*)dyna_block_promote);
+	xJMP(DispatcherReg);
+	return retval;
+}
+
 static void _DynGen_Dispatchers()
 {
 	const u8* start = xGetAlignedCallTarget();
@@ -474,6 +496,7 @@ static void _DynGen_Dispatchers()
 	EnterRecompiledCode = _DynGen_EnterRecompiledCode();
 	DispatchBlockDiscard = _DynGen_DispatchBlockDiscard();
 	DispatchPageReset = _DynGen_DispatchPageReset();
+	DispatchHotBlock = _DynGen_DispatchHotBlock();
 
 	recBlocks.SetJITCompile(JITCompile);
 
@@ -562,6 +585,8 @@ static void recReserve()
 
 alignas(16) static u16 manual_page[Ps2MemSize::TotalRam >> 12];
 alignas(16) static u8 manual_counter[Ps2MemSize::TotalRam >> 12];
+alignas(16) static u32 manual_uncounted_runs[Ps2MemSize::TotalRam >> 12];
+static u32 manual_counter_decay_cycle;
 
 ////////////////////////////////////////////////////
 static void recResetRaw()
@@ -597,6 +622,11 @@ static void recResetRaw()
 
 	memset(manual_page, 0, sizeof(manual_page));
 	memset(manual_counter, 0, sizeof(manual_counter));
+	memset(manual_uncounted_runs, 0, sizeof(manual_uncounted_runs));
+	manual_counter_decay_cycle = cpuRegs.cycle;
+
+	memset(s_hotBlockCounters, 0, sizeof(s_hotBlockCounters));
+	s_hotBlocks.clear();
 }
 
 void recShutdown()
@@ -741,41 +771,35 @@ void recClear(u32 addr, u32 size)
 	if (pexblock)
 		ceiling = pexblock->startpc;
 
-	int toRemoveLast = blockidx;
+	// Blocks to remove are batched into runs of consecutive indices. Promoted blocks can overlap
+	// blocks which don't reach addr, and those have to stay.
+	int toRemoveFirst = -1, toRemoveLast = -1;
 
-	while ((pexblock = recBlocks[blockidx]))
-	{
-		u32 blockstart = pexblock->startpc;
-		u32 blockend = pexblock->startpc + pexblock->size * 4;
+	recBlocks.ForEachOverlapping(addr, size, [&](int idx, BASEBLOCKEX* pexblock) {
+		const u32 blockstart = pexblock->startpc;
+		const u32 blockend = pexblock->startpc + pexblock->size * 4;
 		BASEBLOCK* pblock = PC_GETBLOCK(blockstart);
 
-		if (pblock == s_pCurBlock)
+		if (toRemoveFirst >= 0 && idx != toRemoveFirst - 1)
 		{
-			if (toRemoveLast != blockidx)
-			{
-				recBlocks.Remove((blockidx + 1), toRemoveLast);
-			}
-			toRemoveLast = --blockidx;
-			continue;
+			recBlocks.Remove(toRemoveFirst, toRemoveLast);
+			toRemoveFirst = -1;
 		}
 
-		if (blockend <= addr)
-		{
-			lowerextent = std::max(lowerextent, blockend);
-			break;
-		}
+		if (pblock == s_pCurBlock)
+			return;
 
 		lowerextent = std::min(lowerextent, blockstart);
 		upperextent = std::max(upperextent, blockend);
 		pblock->SetFnptr((uptr)JITCompile);
 
-		blockidx--;
-	}
+		if (toRemoveFirst < 0)
+			toRemoveLast = idx;
+		toRemoveFirst = idx;
+	});
 
-	if (toRemoveLast != blockidx)
-	{
-		recBlocks.Remove((blockidx + 1), toRemoveLast);
-	}
+	if (toRemoveFirst >= 0)
+		recBlocks.Remove(toRemoveFirst, toRemoveLast);
 
 	upperextent = std::min(upperextent, ceiling);
 
@@ -792,7 +816,17 @@ void recClear(u32 addr, u32 size)
 	}
 
 	if (upperextent > lowerextent)
+	{
 		ClearRecLUT(PC_GETBLOCK(lowerextent), upperextent - lowerextent);
+
+		// Put back the entry points of blocks inside the cleared range which didn't reach addr.
+		for (int i = std::max(recBlocks.LastIndex(lowerextent), 0); (pexblock = recBlocks[i]) && pexblock->startpc < upperextent; i++)
+		{
+			BASEBLOCK* pblock = PC_GETBLOCK(pexblock->startpc);
+			if (pexblock->startpc >= lowerextent && pblock != s_pCurBlock)
+				pblock->SetFnptr(pexblock->fnptr);
+		}
+	}
 }
 
 
@@ -1982,12 +2016,29 @@ static void PreBlockCheck(u32 blockpc)
 }
 #endif
 
+// Tweakpoint!  3 is a 'magic' number representing the number of times a counted block
+// is re-protected before the recompiler gives up and sets it up as an uncounted (permanent)
+// manual block.  Higher thresholds result in more recompilations for blocks that share code
+// and data on the same page.  Side effects of a lower threshold: over extended gameplay
+// with several map changes, a game's overall performance could degrade, which is what the
+// decay below is for.
+static constexpr u8 MANUAL_COUNTER_LIMIT = 3;
+
+// The re-protect counts are halved this often, so pages which have settled down get another
+// chance at write protection.
+static constexpr u32 MANUAL_COUNTER_DECAY_CYCLES = PS2CLK * 4;
+
+// Blocks at least this big check their code 16 bytes at a time against a copy, instead of a
+// compare and branch per instruction.
+static constexpr u32 MANUAL_BLOCK_VECTOR_CHECK_SIZE = 32;
+
 // Called when a block under manual protection fails it's pre-execution integrity check.
 // (meaning the actual code area has been modified -- ie dynamic modules being loaded or,
 //  less likely, self-modifying code)
 void dyna_block_discard(u32 start, u32 sz)
 {
 	eeRecPerfLog.Write(Color_StrongGray, "Clearing Manual Block @ 0x%08X  [size=%d]", start, sz * 4);
+	mmap_GetRamPageStats(start).Discards++;
 	recClear(start, sz);
 }
 
@@ -1996,16 +2047,70 @@ void dyna_block_discard(u32 start, u32 sz)
 // and the block is re-assigned for write protection.
 void dyna_page_reset(u32 start, u32 sz)
 {
+	vtlb_PageProtectionStats& stats = mmap_GetRamPageStats(start);
+	stats.Resets++;
+
+	u8& counter = manual_counter[start >> 12];
+	if (counter < 0xFF && ++counter == (MANUAL_COUNTER_LIMIT + 1))
+		stats.Uncounted++;
+
 	recClear(start & ~0xfffUL, 0x400);
-	manual_counter[start >> 12]++;
 	mmap_MarkCountedRamPage(start);
 }
 
+// Emits the check that a manually protected block's code is the same as when it was recompiled.
+// Expects the block's address and size to already be in arg1/arg2 for DispatchBlockDiscard.
+static void recEmitManualBlockCheck(u32 inpage_ptr, u32 inpage_sz)
+{
+	if (inpage_sz < MANUAL_BLOCK_VECTOR_CHECK_SIZE)
+	{
+		for (u32 offset = 0; offset < inpage_sz; offset += 4)
+		{
+			xCMP(ptr32[PSM(inpage_ptr + offset)], *(u32*)PSM(inpage_ptr + offset));
+			xJNE(DispatchBlockDiscard);
+		}
+
+		return;
+	}
+
+	// Keep a copy of the code just before the check, in 16 byte chunks so each one is aligned. If the
+	// block isn't a multiple of 16 bytes, the last chunk overlaps the one before it.
+	const u32 num_chunks = (inpage_sz + 15) / 16;
+	const auto chunk_offset = [inpage_sz](u32 chunk) { return std::min(chunk * 16, inpage_sz - 16); };
+
+	xForwardJump32 skip_copy;
+	xAlignPtr(16);
+	u8* const copy = xGetPtr();
+	xAdvancePtr(num_chunks * 16);
+	for (u32 i = 0; i < num_chunks; i++)
+		std::memcpy(copy + i * 16, PSM(inpage_ptr + chunk_offset(i)), 16);
+	skip_copy.SetTarget();
+
+	// Nothing is cached in xmm registers at the start of a block, so they're free to use.
+	for (u32 i = 0; i < num_chunks; i++)
+	{
+		const xRegisterSSE& reg = (i == 0) ? xmm0 : xmm1;
+		xMOVDQU(reg, ptr128[PSM(inpage_ptr + chunk_offset(i))]);
+		xPXOR(reg, ptr128[copy + i * 16]);
+		if (i != 0)
+			xPOR(xmm0, xmm1);
+	}
+	xPTEST(xmm0, xmm0);
+	xJNE(DispatchBlockDiscard);
+}
+
 static void memory_protect_recompiled_code(u32 startpc, u32 size)
 {
 	u32 inpage_ptr = HWADDR(startpc);
 	const u32 inpage_sz = size * 4;
 
+	if ((cpuRegs.cycle - manual_counter_decay_cycle) >= MANUAL_COUNTER_DECAY_CYCLES)
+	{
+		manual_counter_decay_cycle = cpuRegs.cycle;
+		for (u8& counter : manual_counter)
+			counter >>= 1;
+	}
+
 	// The kernel context register is stored @ 0x800010C0-0x80001300
 	// The EENULL thread context register is stored @ 0x81000-....
 	const bool contains_thread_stack = ((startpc >> 12) == 0x81) || ((startpc >> 12) == 0x80001);
@@ -2021,35 +2126,29 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
 		case ProtMode_None:
 		case ProtMode_Write:
 			mmap_MarkCountedRamPage(inpage_ptr);
+			mmap_MarkRamPageCode(inpage_ptr, inpage_sz);
 			manual_page[inpage_ptr >> 12] = 0;
 			break;
 
 		case ProtMode_Manual:
+		{
+			const u32 page = inpage_ptr >> 12;
+
 			xMOV(arg1regd, inpage_ptr);
 			xMOV(arg2regd, inpage_sz / 4);
 			//xMOV( eax, startpc );		// uncomment this to access startpc (as eax) in dyna_block_discard
 
-			u32 lpc = inpage_ptr;
-			u32 stg = inpage_sz;
+			recEmitManualBlockCheck(inpage_ptr, inpage_sz);
 
-			while (stg > 0)
+			// If the write which took the page out of write protection didn't touch any code, it's data
+			// sharing the page with code. Protecting it again would just fault again, so don't bother.
+			if (!contains_thread_stack && manual_counter[page] <= MANUAL_COUNTER_LIMIT && !mmap_RamPageHadCodeWrite(inpage_ptr))
 			{
-				xCMP(ptr32[PSM(lpc)], *(u32*)PSM(lpc));
-				xJNE(DispatchBlockDiscard);
-
-				stg -= 4;
-				lpc += 4;
+				manual_counter[page] = MANUAL_COUNTER_LIMIT + 1;
+				mmap_GetRamPageStats(inpage_ptr).Uncounted++;
 			}
 
-			// Tweakpoint!  3 is a 'magic' number representing the number of times a counted block
-			// is re-protected before the recompiler gives up and sets it up as an uncounted (permanent)
-			// manual block.  Higher thresholds result in more recompilations for blocks that share code
-			// and data on the same page.  Side effects of a lower threshold: over extended gameplay
-			// with several map changes, a game's overall performance could degrade.
-
-			// (ideally, perhaps, manual_counter should be reset to 0 every few minutes?)
-
-			if (!contains_thread_stack && manual_counter[inpage_ptr >> 12] <= 3)
+			if (!contains_thread_stack && manual_counter[page] <= MANUAL_COUNTER_LIMIT)
 			{
 				// Counted blocks add a weighted (by block size) value into manual_page each time they're
 				// run.  If the block gets run a lot, it resets and re-protects itself in the hope
@@ -2059,30 +2158,64 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
 				// to 'uncounted' mode if it's recompiled several times.  This protects against excessive
 				// recompilation of blocks that reside on the same codepage as data.
 
-				// fixme? Currently this algo is kinda dumb and results in the forced recompilation of a
-				// lot of blocks before it decides to mark a 'busy' page as uncounted.  There might be
-				// be a more clever approach that could streamline this process, by doing a first-pass
-				// test using the vtlb memory protection (without recompilation!) to reprotect a counted
-				// block.  But unless a new algo is relatively simple in implementation, it's probably
-				// not worth the effort (tests show that we have lots of recompiler memory to spare, and
-				// that the current amount of recompilation is fairly cheap).
-
-				xADD(ptr16[&manual_page[inpage_ptr >> 12]], size);
+				xADD(ptr16[&manual_page[page]], size);
 				xJC(DispatchPageReset);
 
 				// note: clearcnt is measured per-page, not per-block!
 				eeRecPerfLog.Write("Manual block @ %08X : size =%3d  page/offs = 0x%05X/0x%03X  inpgsz = %d  clearcnt = %d",
-					startpc, size, inpage_ptr >> 12, inpage_ptr & 0xfff, inpage_sz, manual_counter[inpage_ptr >> 12]);
+					startpc, size, page, inpage_ptr & 0xfff, inpage_sz, manual_counter[page]);
 			}
 			else
 			{
+				// Uncounted blocks still reset the page after a (much) longer run, so that once the
+				// counter has decayed the page can go back to write protection.
+				if (!contains_thread_stack)
+				{
+					xADD(ptr32[&manual_uncounted_runs[page]], size);
+					xJC(DispatchPageReset);
+				}
+
 				eeRecPerfLog.Write("Uncounted Manual block @ 0x%08X : size =%3d page/offs = 0x%05X/0x%03X  inpgsz = %d",
-					startpc, size, inpage_ptr >> 12, inpage_ptr & 0xfff, inpage_sz);
+					startpc, size, page, inpage_ptr & 0xfff, inpage_sz);
 			}
-			break;
+		}
+		break;
 	}
 }
 
+// Called when a block which was split at the start of another block has run often enough to be
+// worth recompiling without the split.
+void dyna_block_promote(u32 start)
+{
+	eeRecPerfLog.Write("Promoting hot block @ 0x%08X", start);
+	s_hotBlocks.insert(start);
+
+	// Rearm the counter, otherwise the next block sharing it would wrap around to 0xFFFF.
+	s_hotBlockCounters[(start >> 2) & (HOT_BLOCK_COUNTER_COUNT - 1)] = HOT_BLOCK_THRESHOLD;
+	recClear(start, 1);
+}
+
+// Tables are indexed by a hash of the block's address, so unrelated blocks can share a counter.
+// Their runs add up, so whichever one takes it to zero gets promoted, and the counter is rearmed.
+static void recEmitHotBlockCounter(u32 startpc)
+{
+	u16* const counter = &s_hotBlockCounters[(HWADDR(startpc) >> 2) & (HOT_BLOCK_COUNTER_COUNT - 1)];
+	*counter = HOT_BLOCK_THRESHOLD;
+
+	xMOV(arg1regd, HWADDR(startpc));
+	xSUB(ptr16[counter], 1);
+	xJE(DispatchHotBlock);
+}
+
+// Blocks starting at these addresses run a hook first, so nothing can be compiled through them.
+static bool recBlockHasEntryHook(u32 pc)
+{
+	if ((g_eeloadMain && HWADDR(pc) == HWADDR(g_eeloadMain)) || (g_eeloadExec && HWADDR(pc) == HWADDR(g_eeloadExec)))
+		return true;
+
+	return EmuConfig.Gamefixes.GoemonTlbHack && (pc == 0x33ad48 || pc == 0x35060c || pc == 0x3563b8);
+}
+
 // Skip MPEG Game-Fix
 static bool skipMPEG_By_Pattern(u32 sPC)
 {
@@ -2285,6 +2418,11 @@ static void recRecompile(const u32 startpc)
 	s32 timeout_reg = -1;
 	bool is_timeout_loop = true;
 
+	// Blocks which have been promoted don't stop at the start of another block, so registers and
+	// constants carry on through. Blocks which did stop there count their runs so they can be promoted.
+	s_nBlockHot = (s_hotBlocks.find(HWADDR(startpc)) != s_hotBlocks.end());
+	bool split_at_block = false;
+
 	// compile breakpoints as individual blocks
 	const int n1 = isBreakpointNeeded(i);
 	const int n2 = isMemcheckNeeded(i);
@@ -2317,10 +2455,11 @@ static void recRecompile(const u32 startpc)
 				break;
 			}
 
-			if (pblock->GetFnptr() != (uptr)JITCompile)
+			if (pblock->GetFnptr() != (uptr)JITCompile && (!s_nBlockHot || recBlockHasEntryHook(i)))
 			{
 				willbranch3 = 1;
 				s_nEndBlock = i;
+				split_at_block = true;
 				break;
 			}
 		}
@@ -2526,6 +2665,7 @@ StartRecomp:
 
 	// rec info //
 	bool has_cop2_instructions = false;
+	bool has_cop1_instructions = false;
 	{
 		if (s_nInstCacheSize < (s_nEndBlock - startpc) / 4 + 1)
 		{
@@ -2547,6 +2687,7 @@ StartRecomp:
 			pcur--;
 
 			has_cop2_instructions |= (_Opcode_ == 022 || _Opcode_ == 066 || _Opcode_ == 076);
+			has_cop1_instructions |= (_Opcode_ == 021);
 		}
 	}
 
@@ -2559,6 +2700,9 @@ StartRecomp:
 			COP2FlagHackPass().Run(startpc, s_nEndBlock, s_pInstCache + 1);
 	}
 
+	if (has_cop1_instructions && CHECK_FPU_FULL)
+		COP1FlagPass().Run(startpc, s_nEndBlock, s_pInstCache + 1);
+
 #ifdef DUMP_BLOCKS
 	ZydisDecoder disas_decoder;
 	ZydisDecoderInit(&disas_decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64);
@@ -2581,6 +2725,10 @@ StartRecomp:
 	// Detect and handle self-modified code
 	memory_protect_recompiled_code(startpc, (s_nEndBlock - startpc) >> 2);
 
+	// Only RAM blocks can be cleared and recompiled.
+	if (split_at_block && !s_nBlockHot && HWADDR(startpc) < Ps2MemSize::ExposedRam)
+		recEmitHotBlockCounter(startpc);
+
 	// Skip Recompilation if sceMpegIsEnd Pattern detected
 	const bool doRecompilation = !skipMPEG_By_Pattern(startpc) && !recSkipTimeoutLoop(timeout_reg, is_timeout_loop);
 
@@ -2641,27 +2789,17 @@ StartRecomp:
 
 	if (HWADDR(pc) <= Ps2MemSize::ExposedRam)
 	{
-		BASEBLOCKEX* oldBlock;
-		int i;
+		bool modified = false;
+		recBlocks.ForEachOverlapping(HWADDR(startpc), (pc - startpc) / 4, [&modified](int, BASEBLOCKEX* oldBlock) {
+			if (!modified && oldBlock != s_pCurBlockEx)
+				modified = (memcmp(&recRAMCopy[oldBlock->startpc / 4], PSM(oldBlock->startpc), oldBlock->size * 4) != 0);
+		});
 
-		i = recBlocks.LastIndex(HWADDR(pc) - 4);
-		while ((oldBlock = recBlocks[i--]))
+		if (modified)
 		{
-			if (oldBlock == s_pCurBlockEx)
-				continue;
-			if (oldBlock->startpc >= HWADDR(pc))
-				continue;
-			if ((oldBlock->startpc + oldBlock->size * 4) <= HWADDR(startpc))
-				break;
-
-			if (memcmp(&recRAMCopy[oldBlock->startpc / 4], PSM(oldBlock->startpc),
-					oldBlock->size * 4))
-			{
-				recClear(startpc, (pc - startpc) / 4);
-				s_pCurBlockEx = recBlocks.Get(HWADDR(startpc));
-				pxAssert(s_pCurBlockEx->startpc == HWADDR(startpc));
-				break;
-			}
+			recClear(startpc, (pc - startpc) / 4);
+			s_pCurBlockEx = recBlocks.Get(HWADDR(startpc));
+			pxAssert(s_pCurBlockEx->startpc == HWADDR(startpc));
 		}
 
 		memcpy(&recRAMCopy[HWADDR(startpc) / 4], PSM(startpc), pc - startpc);
@@ -2722,6 +2860,7 @@ StartRecomp:
 	}
 #endif
 	Perf::ee.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+	GuestProfiler::RegisterBlock(GuestProfiler::Source::EE, (void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
 
 	recPtr = xGetPtr();
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Common.h"
+#include "Cache.h"
 #include "vtlb.h"
 #include "x86/iCore.h"
 #include "x86/iR5900.h"
@@ -119,13 +120,10 @@ static void __vectorcall LogWriteQuad(u32 addr, __m128i val)
 namespace vtlb_private
 {
 	// ------------------------------------------------------------------------
-	// Prepares eax, ecx, and, ebx for Direct or Indirect operations.
-	// Returns the writeback pointer for ebx (return address from indirect handling)
+	// Moves the address and store value into the argument registers.
 	//
-	static void DynGen_PrepRegs(int addr_reg, int value_reg, u32 sz, bool xmm)
+	static void DynGen_PrepArgs(int addr_reg, int value_reg, u32 sz, bool xmm)
 	{
-		EE::Profiler.EmitMem();
-
 		_freeX86reg(arg1regd);
 		xMOV(arg1regd, xRegister32(addr_reg));
 
@@ -150,13 +148,31 @@ namespace vtlb_private
 				xMOV(arg2reg, xRegister64(value_reg));
 			}
 		}
+	}
 
+	// ------------------------------------------------------------------------
+	// Turns the guest address in ecx into a vtlb entry (host pointer, or handler).
+	//
+	static void DynGen_TranslateAddress()
+	{
 		xMOV(eax, arg1regd);
 		xSHR(eax, VTLB_PAGE_BITS);
 		xMOV(rax, ptrNative[xComplexAddress(arg3reg, vtlbdata.vmap, rax * wordsize)]);
 		xADD(arg1reg, rax);
 	}
 
+	// ------------------------------------------------------------------------
+	// Prepares eax, ecx, and, ebx for Direct or Indirect operations.
+	// Returns the writeback pointer for ebx (return address from indirect handling)
+	//
+	static void DynGen_PrepRegs(int addr_reg, int value_reg, u32 sz, bool xmm)
+	{
+		EE::Profiler.EmitMem();
+
+		DynGen_PrepArgs(addr_reg, value_reg, sz, xmm);
+		DynGen_TranslateAddress();
+	}
+
 	// ------------------------------------------------------------------------
 	static void DynGen_DirectRead(u32 bits, bool sign)
 	{
@@ -267,6 +283,104 @@ static void DynGen_HandlerTest(const GenDirectFn& gen_direct, int mode, int bits
 	done.SetTarget();
 }
 
+// ------------------------------------------------------------------------
+// Generates a load or store with EE data cache emulation. Pages which no cached TLB entry covers take the
+// normal direct/handler route. Otherwise both ways of the set are checked against the fast tags, and a hit
+// is served straight out of the cache line. Misses go through vtlb_memRead/vtlb_memWrite, which do the full
+// lookup, fill the line, and set its fast tag for next time.
+// In: arg1reg: guest address, arg2reg/xmm arg: store value
+// Out: rax/xmm0: result (for reads)
+static void DynGen_CachedAccess(int mode, u32 bits, bool sign)
+{
+	EE::Profiler.EmitMem();
+
+	const xRegister32 arg3regd(arg3reg.GetId());
+
+	// Skip the lookup for pages which can't be cached.
+	xMOV(eax, arg1regd);
+	xSHR(eax, VTLB_PAGE_BITS + 3);
+	xMOVZX(eax, ptr8[xComplexAddress(arg3reg, vtlbdata.cached_pages, rax)]);
+	xMOV(arg3regd, arg1regd);
+	xSHR(arg3regd, VTLB_PAGE_BITS);
+	xAND(arg3regd, 7);
+	xBT(eax, arg3regd);
+	xForwardJNC32 uncached;
+
+	// eax = set * 2 + way, arg3 = line address | valid, arg4 = fast tags
+	u8* const fast_tags = reinterpret_cast<u8*>(getCacheFastTags());
+	const s32 tags_offset = static_cast<s32>(reinterpret_cast<u8*>(getCacheTags()) - fast_tags);
+	const s32 data_offset = static_cast<s32>(getCacheData() - fast_tags);
+	xLoadFarAddr(arg4reg, fast_tags);
+	xMOV(eax, arg1regd);
+	xSHR(eax, 6 - 1);
+	xAND(eax, 0x3F << 1);
+	xMOV(arg3regd, arg1regd);
+	xAND(arg3regd, ~0x3F);
+	xOR(arg3regd, CACHE_FAST_TAG_VALID);
+	xCMP(arg3regd, ptr32[rax * 4 + arg4reg]);
+	xForwardJE8 hit;
+	xINC(eax);
+	xCMP(arg3regd, ptr32[rax * 4 + arg4reg]);
+	xForwardJNE32 miss;
+	hit.SetTarget();
+
+	// Same alignment as the interpreter's cache accesses.
+	if (mode)
+		xOR(ptr8[rax * wordsize + arg4reg + tags_offset], CACHE_TAG_DIRTY_FLAG);
+	xSHL(eax, 6);
+	xAND(arg1regd, 0x3F & ~((bits / 8) - 1));
+	xADD(eax, arg1regd);
+	xLEA(arg1reg, ptr[arg4reg + rax + data_offset]);
+	if (mode)
+		DynGen_DirectWrite(bits);
+	else
+		DynGen_DirectRead(bits, sign);
+	xForwardJump32 hit_done;
+
+	miss.SetTarget();
+	switch (bits)
+	{
+		case 8:
+			xFastCall(mode ? (void*)vtlb_memWrite<mem8_t> : (void*)vtlb_memRead<mem8_t>);
+			if (!mode)
+				sign ? xMOVSX(rax, al) : xMOVZX(rax, al);
+			break;
+
+		case 16:
+			xFastCall(mode ? (void*)vtlb_memWrite<mem16_t> : (void*)vtlb_memRead<mem16_t>);
+			if (!mode)
+				sign ? xMOVSX(rax, ax) : xMOVZX(rax, ax);
+			break;
+
+		case 32:
+			xFastCall(mode ? (void*)vtlb_memWrite<mem32_t> : (void*)vtlb_memRead<mem32_t>);
+			if (!mode && sign)
+				xCDQE();
+			break;
+
+		case 64:
+			xFastCall(mode ? (void*)vtlb_memWrite<mem64_t> : (void*)vtlb_memRead<mem64_t>);
+			break;
+
+		case 128:
+			xFastCall(mode ? (void*)vtlb_memWrite128 : (void*)vtlb_memRead128);
+			break;
+
+			jNO_DEFAULT
+	}
+	xForwardJump32 miss_done;
+
+	uncached.SetTarget();
+	DynGen_TranslateAddress();
+	if (mode)
+		DynGen_HandlerTest([bits]() { DynGen_DirectWrite(bits); }, 1, bits);
+	else
+		DynGen_HandlerTest([bits, sign]() { DynGen_DirectRead(bits, sign); }, 0, bits, sign);
+
+	hit_done.SetTarget();
+	miss_done.SetTarget();
+}
+
 // ------------------------------------------------------------------------
 // Generates the various instances of the indirect dispatchers
 // In: arg1reg: vtlb entry, arg2reg: data ptr (if mode >= 64), rbx: function return ptr
@@ -369,12 +483,20 @@ int vtlb_DynGenReadNonQuad(u32 bits, bool sign, bool xmm, int addr_reg, vtlb_Rea
 	pxAssume(bits <= 64);
 
 	int x86_dest_reg;
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (!CHECK_FASTMEM || CHECK_CACHE || vtlb_IsFaultingPC(pc))
 	{
 		iFlushCall(FLUSH_FULLVTLB);
 
-		DynGen_PrepRegs(addr_reg, -1, bits, xmm);
-		DynGen_HandlerTest([bits, sign]() { DynGen_DirectRead(bits, sign); }, 0, bits, sign && bits < 64);
+		if (CHECK_CACHE)
+		{
+			DynGen_PrepArgs(addr_reg, -1, bits, xmm);
+			DynGen_CachedAccess(0, bits, sign && bits < 64);
+		}
+		else
+		{
+			DynGen_PrepRegs(addr_reg, -1, bits, xmm);
+			DynGen_HandlerTest([bits, sign]() { DynGen_DirectRead(bits, sign); }, 0, bits, sign && bits < 64);
+		}
 
 		if (!xmm)
 		{
@@ -449,10 +571,18 @@ int vtlb_DynGenReadNonQuad(u32 bits, bool sign, bool xmm, int addr_reg, vtlb_Rea
 //
 int vtlb_DynGenReadNonQuad_Const(u32 bits, bool sign, bool xmm, u32 addr_const, vtlb_ReadRegAllocCallback dest_reg_alloc)
 {
+	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
+	if (CHECK_CACHE && !vmv.isHandler(addr_const))
+	{
+		// Whether this hits in the cache can only be known at runtime.
+		_freeX86reg(arg1regd);
+		xMOV(arg1regd, addr_const);
+		return vtlb_DynGenReadNonQuad(bits, sign, xmm, arg1regd.GetId(), dest_reg_alloc);
+	}
+
 	EE::Profiler.EmitConstMem(addr_const);
 
 	int x86_dest_reg;
-	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
 	if (!vmv.isHandler(addr_const))
 	{
 		auto ppf = vmv.assumePtr(addr_const);
@@ -557,12 +687,20 @@ int vtlb_DynGenReadQuad(u32 bits, int addr_reg, vtlb_ReadRegAllocCallback dest_r
 {
 	pxAssume(bits == 128);
 
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (!CHECK_FASTMEM || CHECK_CACHE || vtlb_IsFaultingPC(pc))
 	{
 		iFlushCall(FLUSH_FULLVTLB);
 
-		DynGen_PrepRegs(arg1regd.GetId(), -1, bits, true);
-		DynGen_HandlerTest([bits]() {DynGen_DirectRead(bits, false); },  0, bits);
+		if (CHECK_CACHE)
+		{
+			DynGen_PrepArgs(arg1regd.GetId(), -1, bits, true);
+			DynGen_CachedAccess(0, bits, false);
+		}
+		else
+		{
+			DynGen_PrepRegs(arg1regd.GetId(), -1, bits, true);
+			DynGen_HandlerTest([bits]() {DynGen_DirectRead(bits, false); },  0, bits);
+		}
 
 		const int reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0); // Handler returns in xmm0
 		if (reg >= 0)
@@ -596,10 +734,18 @@ int vtlb_DynGenReadQuad_Const(u32 bits, u32 addr_const, vtlb_ReadRegAllocCallbac
 {
 	pxAssert(bits == 128);
 
+	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
+	if (CHECK_CACHE && !vmv.isHandler(addr_const))
+	{
+		// Whether this hits in the cache can only be known at runtime.
+		_freeX86reg(arg1regd);
+		xMOV(arg1regd, addr_const);
+		return vtlb_DynGenReadQuad(bits, arg1regd.GetId(), dest_reg_alloc);
+	}
+
 	EE::Profiler.EmitConstMem(addr_const);
 
 	int reg;
-	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
 	if (!vmv.isHandler(addr_const))
 	{
 		void* ppf = reinterpret_cast<void*>(vmv.assumePtr(addr_const));
@@ -682,12 +828,20 @@ void vtlb_DynGenWrite(u32 sz, bool xmm, int addr_reg, int value_reg)
 	}
 #endif
 
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (!CHECK_FASTMEM || CHECK_CACHE || vtlb_IsFaultingPC(pc))
 	{
 		iFlushCall(FLUSH_FULLVTLB);
 
-		DynGen_PrepRegs(addr_reg, value_reg, sz, xmm);
-		DynGen_HandlerTest([sz]() { DynGen_DirectWrite(sz); }, 1, sz);
+		if (CHECK_CACHE)
+		{
+			DynGen_PrepArgs(addr_reg, value_reg, sz, xmm);
+			DynGen_CachedAccess(1, sz, false);
+		}
+		else
+		{
+			DynGen_PrepRegs(addr_reg, value_reg, sz, xmm);
+			DynGen_HandlerTest([sz]() { DynGen_DirectWrite(sz); }, 1, sz);
+		}
 		return;
 	}
 
@@ -804,7 +958,17 @@ void vtlb_DynGenWrite_Const(u32 bits, bool xmm, u32 addr_const, int value_reg)
 #endif
 
 	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
-	if (!vmv.isHandler(addr_const))
+	if (CHECK_CACHE && !vmv.isHandler(addr_const))
+	{
+		// Whether this hits in the cache can only be known at runtime.
+		iFlushCall(FLUSH_FULLVTLB);
+
+		_freeX86reg(arg1regd);
+		xMOV(arg1regd, addr_const);
+		DynGen_PrepArgs(arg1regd.GetId(), value_reg, bits, xmm);
+		DynGen_CachedAccess(1, bits, false);
+	}
+	else if (!vmv.isHandler(addr_const))
 	{
 		auto ppf = vmv.assumePtr(addr_const);
 		if (!xmm)
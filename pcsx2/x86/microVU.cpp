@@ -405,6 +405,25 @@ void recMicroVU1::Clear(u32 addr, u32 size)
 	mVUclear(microVU1, addr, size);
 }
 
+void recMicroVU1::PreTranslate(u32 startPC)
+{
+	microVU& mVU = microVU1;
+
+	// Same lookup as mVUexecute(), so the next execution from here hits the quick cache.
+	const u32 start_pc = mVU.regs().start_pc;
+	mVU.regs().start_pc = startPC & 0x3ff8;
+	xSetPtr(mVU.prog.x86ptr);
+	mVUsearchProg<1>(startPC & 0x3ff8, (uptr)&mVU.prog.lpState);
+	mVU.prog.x86ptr = x86Ptr;
+	mVU.regs().start_pc = start_pc;
+
+	if ((xGetPtr() < mVU.prog.x86start) || (xGetPtr() >= mVU.prog.x86end))
+	{
+		Console.WriteLn(Color_Orange, "microVU1: Program cache limit reached.");
+		mVUreset(mVU, false);
+	}
+}
+
 void recMicroVU1::ResumeXGkick()
 {
 	if (!(VU0.VI[REG_VPU_STAT].UL & 0x100))
@@ -21,6 +21,7 @@
 #include "microVU_IR.h"
 #include "microVU_Profiler.h"
 #include "common/Perf.h"
+#include "DebugTools/GuestProfiler.h"
 
 class microBlockManager;
 
@@ -1010,6 +1010,10 @@ perf_and_return:
 			Perf::vu0.RegisterPC(thisPtr, static_cast<u32>(x86Ptr - thisPtr), startPC);
 	}
 
+	// Unlike perf, the profiler wants every block, not just program entry points.
+	GuestProfiler::RegisterBlock(mVU.index ? GuestProfiler::Source::VU1 : GuestProfiler::Source::VU0, thisPtr,
+		static_cast<size_t>(x86Ptr - thisPtr), startPC);
+
 	return thisPtr;
 }
 
@@ -134,6 +134,9 @@ TEST(CodegenTests, BitwiseTest)
 	CODEGEN_TEST(xNOT(r8), "49 f7 d0");
 	CODEGEN_TEST(xNOT(ptr64[rax]), "48 f7 10");
 	CODEGEN_TEST(xNOT(ptr32[rbx]), "f7 13");
+	CODEGEN_TEST(xBT(eax, edx), "0f a3 d0");
+	CODEGEN_TEST(xBTS(r8, r9), "4d 0f ab c8");
+	CODEGEN_TEST(xBT(ptr32[rax], ecx), "0f a3 08");
 }
 
 TEST(CodegenTests, JmpTest)
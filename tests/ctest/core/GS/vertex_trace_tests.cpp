@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/GS/Renderers/Common/GSVertexTraceFMM.h"
+#include "pcsx2/GS/MultiISA.h"
+
+#include "common/Timer.h"
+
+#include "fmt/format.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "cpuinfo.h"
+
+#ifdef MULTI_ISA_UNSHARED_COMPILATION
+
+#define MULTI_ISA_CONCAT_(a, b) a##b
+#define MULTI_ISA_CONCAT(a, b) MULTI_ISA_CONCAT_(a, b)
+
+#define MULTI_ISA_TEST(group, name) TEST(MULTI_ISA_CONCAT(MULTI_ISA_CONCAT(MULTI_ISA_UNSHARED_COMPILATION, _), group), name)
+
+#else
+
+#define MULTI_ISA_TEST(group, name) TEST(group, name)
+
+#endif
+
+#ifdef GS_AVX512_FUNCTION
+
+#define SKIP_IF_NO_AVX512() \
+	if (cpuinfo_initialize(), !cpuinfo_has_x86_avx512f() || !cpuinfo_has_x86_avx512bw()) { \
+		GTEST_SKIP() << "Host CPU does not support AVX-512"; \
+	}
+
+MULTI_ISA_UNSHARED_START
+
+struct TestDraw
+{
+	std::vector<GSVertex> vertices;
+	std::vector<u16> indices;
+};
+
+static TestDraw GenerateDraw(u32 num_vertices, u32 num_indices)
+{
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<u32> dist;
+	std::uniform_real_distribution<float> st_dist(-4.0f, 4.0f);
+	std::uniform_real_distribution<float> q_dist(0.01f, 8.0f);
+
+	TestDraw draw;
+	draw.vertices.resize(num_vertices);
+	for (GSVertex& v : draw.vertices)
+	{
+		v.ST.S = st_dist(rng);
+		v.ST.T = st_dist(rng);
+		v.RGBAQ.U32[0] = dist(rng);
+		v.RGBAQ.Q = q_dist(rng);
+		v.XYZ.X = static_cast<u16>(dist(rng));
+		v.XYZ.Y = static_cast<u16>(dist(rng));
+		v.XYZ.Z = dist(rng);
+		v.UV = dist(rng) & 0x3fff3fff;
+		v.FOG = dist(rng);
+	}
+
+	draw.indices.resize(num_indices);
+	for (u16& i : draw.indices)
+		i = static_cast<u16>(dist(rng) % num_vertices);
+
+	return draw;
+}
+
+template <u32 tme, u32 fst, u32 color>
+static GSVertexTraceMinMax ScalarMinMax(const TestDraw& draw)
+{
+	GSVertexTraceMinMax mm;
+	float tmin[4] = {FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX}, tmax[4] = {-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+	u8 cmin[4] = {0xff, 0xff, 0xff, 0xff}, cmax[4] = {};
+	u32 pmin[4] = {UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX}, pmax[4] = {};
+
+	for (const u16 i : draw.indices)
+	{
+		const GSVertex& v = draw.vertices[i];
+
+		const u32 p[4] = {v.XYZ.X, v.XYZ.Y, v.XYZ.Z, v.FOG};
+		const float t[4] = {
+			fst ? static_cast<float>(v.U) : (v.ST.S / v.RGBAQ.Q),
+			fst ? static_cast<float>(v.V) : (v.ST.T / v.RGBAQ.Q),
+			fst ? static_cast<float>(v.U) : v.RGBAQ.Q,
+			fst ? static_cast<float>(v.V) : v.RGBAQ.Q,
+		};
+
+		for (int j = 0; j < 4; j++)
+		{
+			const u8 c = static_cast<u8>(v.RGBAQ.U32[0] >> (j * 8));
+			cmin[j] = std::min(cmin[j], c);
+			cmax[j] = std::max(cmax[j], c);
+			tmin[j] = std::min(tmin[j], t[j]);
+			tmax[j] = std::max(tmax[j], t[j]);
+			pmin[j] = std::min(pmin[j], p[j]);
+			pmax[j] = std::max(pmax[j], p[j]);
+		}
+	}
+
+	mm.tmin = GSVector4(tmin[0], tmin[1], tmin[2], tmin[3]);
+	mm.tmax = GSVector4(tmax[0], tmax[1], tmax[2], tmax[3]);
+	mm.cmin = GSVector4i::load(static_cast<int>(cmin[0] | (cmin[1] << 8) | (cmin[2] << 16) | (static_cast<u32>(cmin[3]) << 24)));
+	mm.cmax = GSVector4i::load(static_cast<int>(cmax[0] | (cmax[1] << 8) | (cmax[2] << 16) | (static_cast<u32>(cmax[3]) << 24)));
+	mm.pmin = GSVector4i(pmin[0], pmin[1], pmin[2], pmin[3]);
+	mm.pmax = GSVector4i(pmax[0], pmax[1], pmax[2], pmax[3]);
+	return mm;
+}
+
+template <u32 tme, u32 fst, u32 color>
+static void CompareMinMax(const TestDraw& draw, int count)
+{
+	TestDraw partial = draw;
+	partial.indices.resize(count);
+
+	GSVertexTraceMinMax mm;
+	GSVertexTraceFindMinMaxAVX512<tme, fst, color>(partial.vertices.data(), partial.indices.data(), count, mm);
+	const GSVertexTraceMinMax expected = ScalarMinMax<tme, fst, color>(partial);
+
+	const std::string desc = fmt::format("tme={} fst={} color={} count={}", tme, fst, color, count);
+	EXPECT_TRUE(mm.pmin.eq(expected.pmin)) << desc;
+	EXPECT_TRUE(mm.pmax.eq(expected.pmax)) << desc;
+	if (tme)
+	{
+		EXPECT_EQ((mm.tmin == expected.tmin).mask(), 0xf) << desc;
+		EXPECT_EQ((mm.tmax == expected.tmax).mask(), 0xf) << desc;
+	}
+	if (color)
+	{
+		EXPECT_EQ(mm.cmin.extract32<0>(), expected.cmin.extract32<0>()) << desc;
+		EXPECT_EQ(mm.cmax.extract32<0>(), expected.cmax.extract32<0>()) << desc;
+	}
+}
+
+MULTI_ISA_TEST(VertexTraceTest, AVX512MatchesScalar)
+{
+	SKIP_IF_NO_AVX512();
+
+	const TestDraw draw = GenerateDraw(4096, 3 * 2048);
+
+	// Include counts which aren't a multiple of the vector width, to cover the tail.
+	for (const int count : {1, 2, 3, 4, 5, 7, 33, 3 * 2048})
+	{
+		CompareMinMax<0, 0, 1>(draw, count);
+		CompareMinMax<1, 0, 0>(draw, count);
+		CompareMinMax<1, 0, 1>(draw, count);
+		CompareMinMax<1, 1, 0>(draw, count);
+		CompareMinMax<1, 1, 1>(draw, count);
+	}
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests.
+MULTI_ISA_TEST(VertexTraceTest, DISABLED_AVX512Benchmark)
+{
+	SKIP_IF_NO_AVX512();
+
+	static constexpr int ITERATIONS = 200;
+	const TestDraw draw = GenerateDraw(32768, 3 * 21845);
+	const int count = static_cast<int>(draw.indices.size());
+
+	GSVertexTraceMinMax mm;
+	Common::Timer timer;
+	for (int i = 0; i < ITERATIONS; i++)
+		GSVertexTraceFindMinMaxAVX512<1, 0, 1>(draw.vertices.data(), draw.indices.data(), count, mm);
+	const double avx512_ms = timer.GetTimeMilliseconds() / ITERATIONS;
+
+	GSVertexTraceMinMax expected;
+	timer.Reset();
+	for (int i = 0; i < ITERATIONS; i++)
+		expected = ScalarMinMax<1, 0, 1>(draw);
+	const double scalar_ms = timer.GetTimeMilliseconds() / ITERATIONS;
+
+	std::printf("FindMinMax %d indices: AVX-512 %.3f ms, scalar %.3f ms\n", count, avx512_ms, scalar_ms);
+
+	EXPECT_TRUE(mm.pmin.eq(expected.pmin));
+	EXPECT_TRUE(mm.pmax.eq(expected.pmax));
+}
+
+MULTI_ISA_UNSHARED_END
+
+#endif
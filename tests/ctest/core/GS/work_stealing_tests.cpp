@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/GS/GSWorkStealingPool.h"
+
+#include "common/Timer.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+TEST(GSWorkStealingPool, ParallelForRunsEveryIndexOnce)
+{
+	GSWorkStealingPool pool(4);
+
+	static constexpr u32 COUNT = 10000;
+	std::vector<std::atomic<u32>> hits(COUNT);
+	pool.ParallelFor(COUNT, [&hits](u32 index) { hits[index].fetch_add(1, std::memory_order_relaxed); });
+
+	for (u32 i = 0; i < COUNT; i++)
+		ASSERT_EQ(hits[i].load(), 1u) << "index " << i;
+}
+
+TEST(GSWorkStealingPool, NestedJobsAreStolen)
+{
+	GSWorkStealingPool pool(4);
+
+	// Each outer job queues more work on its own deque, which the other workers have to steal.
+	std::atomic<u32> total{0};
+	pool.ParallelFor(16, [&pool, &total](u32) {
+		pool.ParallelFor(256, [&total](u32) { total.fetch_add(1, std::memory_order_relaxed); });
+	});
+
+	EXPECT_EQ(total.load(), 16u * 256u);
+}
+
+TEST(GSWorkStealingPool, OverflowRunsInline)
+{
+	GSWorkStealingPool pool(1);
+
+	// More jobs than a deque can hold.
+	static constexpr u32 COUNT = 20000;
+	std::atomic<u32> total{0};
+	pool.ParallelFor(COUNT, [&total](u32) { total.fetch_add(1, std::memory_order_relaxed); });
+
+	EXPECT_EQ(total.load(), COUNT);
+}
+
+TEST(GSWorkStealingPool, CounterWaitsAfterWorkersSleep)
+{
+	GSWorkStealingPool pool(2);
+
+	// Give the workers long enough to park, then make sure they wake up for the next batch.
+	for (u32 batch = 0; batch < 4; batch++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+		std::atomic<u32> total{0};
+		pool.ParallelFor(64, [&total](u32) { total.fetch_add(1, std::memory_order_relaxed); });
+		EXPECT_EQ(total.load(), 64u);
+	}
+}
+
+TEST(GSWorkStealingPool, ManyWorkersSumIsExact)
+{
+	static constexpr u32 JOBS = 4096;
+
+	for (const u32 threads : {2u, 8u})
+	{
+		GSWorkStealingPool pool(threads - 1);
+
+		std::atomic<u64> sum{0};
+		pool.ParallelFor(JOBS, [&sum](u32 index) { sum.fetch_add(index, std::memory_order_relaxed); });
+		EXPECT_EQ(sum.load(), static_cast<u64>(JOBS) * (JOBS - 1) / 2) << threads << " threads";
+	}
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests.
+TEST(GSWorkStealingPool, DISABLED_ContentionBenchmark)
+{
+	// Lots of tiny jobs, so the cost is dominated by queueing, stealing and waking.
+	static constexpr u32 JOBS = 1 << 16;
+	static constexpr u32 ROUNDS = 8;
+
+	for (const u32 threads : {2u, 4u, 8u, 16u, 32u, 64u})
+	{
+		GSWorkStealingPool pool(threads - 1);
+
+		std::atomic<u64> sum{0};
+		Common::Timer timer;
+		for (u32 round = 0; round < ROUNDS; round++)
+			pool.ParallelFor(JOBS, [&sum](u32 index) { sum.fetch_add(index, std::memory_order_relaxed); });
+		const double ms = timer.GetTimeMilliseconds();
+
+		std::printf("%2u threads: %8.3f ms, %6.1f ns/job\n", threads, ms / ROUNDS, (ms * 1000000.0) / (static_cast<double>(JOBS) * ROUNDS));
+		EXPECT_EQ(sum.load(), (static_cast<u64>(JOBS) * (JOBS - 1) / 2) * ROUNDS);
+	}
+}
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/Host/AudioStream.h"
+#include "pcsx2/Host/AudioTimeStretcher.h"
+
+#include "common/Timer.h"
+
+#include "SoundTouch.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static constexpr u32 SAMPLE_RATE = 48000;
+static constexpr u32 CHANNELS = 2;
+static constexpr u32 CHUNK_SIZE = AudioStream::CHUNK_SIZE;
+
+static std::vector<float> GenerateTestSignal(u32 seconds)
+{
+	// Two detuned tones, so there's something for the correlation search to lock onto.
+	std::vector<float> samples(SAMPLE_RATE * seconds * CHANNELS);
+	for (u32 i = 0; i < SAMPLE_RATE * seconds; i++)
+	{
+		const float t = static_cast<float>(i) / SAMPLE_RATE;
+		samples[i * 2 + 0] = 0.4f * std::sin(2.0f * 3.14159265f * 440.0f * t) + 0.2f * std::sin(2.0f * 3.14159265f * 663.0f * t);
+		samples[i * 2 + 1] = 0.4f * std::sin(2.0f * 3.14159265f * 330.0f * t) + 0.2f * std::sin(2.0f * 3.14159265f * 517.0f * t);
+	}
+	return samples;
+}
+
+struct StretchResult
+{
+	u32 output_frames;
+	u32 latency_frames;
+	double cpu_seconds;
+};
+
+template <typename PutFunc, typename ReceiveFunc>
+static StretchResult RunStretcher(const std::vector<float>& input, PutFunc put, ReceiveFunc receive)
+{
+	StretchResult res = {};
+	res.latency_frames = UINT32_MAX;
+
+	float out[CHUNK_SIZE * CHANNELS];
+	const u32 input_frames = static_cast<u32>(input.size() / CHANNELS);
+	const Common::Timer timer;
+	for (u32 pos = 0; pos < input_frames; pos += CHUNK_SIZE)
+	{
+		put(&input[pos * CHANNELS], CHUNK_SIZE);
+
+		u32 received;
+		while ((received = receive(out, CHUNK_SIZE)) != 0)
+		{
+			if (res.latency_frames == UINT32_MAX)
+				res.latency_frames = pos + CHUNK_SIZE;
+			res.output_frames += received;
+		}
+	}
+	res.cpu_seconds = timer.GetTimeSeconds();
+	return res;
+}
+
+TEST(AudioTimeStretcher, OutputLengthFollowsTempo)
+{
+	const std::vector<float> input = GenerateTestSignal(4);
+	const u32 input_frames = static_cast<u32>(input.size() / CHANNELS);
+
+	for (const float tempo : {0.5f, 0.9f, 1.0f, 1.25f, 2.0f, 3.0f})
+	{
+		AudioTimeStretcher stretcher(SAMPLE_RATE, CHANNELS, 30, 20, 10, false);
+		stretcher.SetTempo(tempo);
+
+		const StretchResult res = RunStretcher(
+			input, [&](const float* f, u32 n) { stretcher.PutFrames(f, n); },
+			[&](float* f, u32 n) { return stretcher.ReceiveFrames(f, n); });
+
+		// Allow for whatever's still sitting in the input buffer at the end.
+		const float expected = static_cast<float>(input_frames) / tempo;
+		const float tolerance = static_cast<float>(stretcher.GetLatencyFrames() * 2) / tempo;
+		EXPECT_NEAR(static_cast<float>(res.output_frames), expected, tolerance) << "tempo " << tempo;
+		EXPECT_LE(res.latency_frames, stretcher.GetLatencyFrames() + CHUNK_SIZE) << "tempo " << tempo;
+	}
+}
+
+TEST(AudioTimeStretcher, ClearDropsBufferedAudio)
+{
+	const std::vector<float> input = GenerateTestSignal(1);
+
+	AudioTimeStretcher stretcher(SAMPLE_RATE, CHANNELS, 30, 20, 10, true);
+	stretcher.PutFrames(input.data(), SAMPLE_RATE / 2);
+	EXPECT_GT(stretcher.GetAvailableFrames(), 0u);
+
+	stretcher.Clear();
+	EXPECT_EQ(stretcher.GetAvailableFrames(), 0u);
+}
+
+static void RunWithSoundTouch(const std::vector<float>& input, float tempo, bool minimal_latency,
+	StretchResult* native_res, StretchResult* st_res)
+{
+	const u32 sequence_ms = minimal_latency ? AudioStreamParameters::MINIMAL_LATENCY_STRETCH_SEQUENCE_LENGTH :
+											  AudioStreamParameters::DEFAULT_STRETCH_SEQUENCE_LENGTH;
+	const u32 seekwindow_ms = minimal_latency ? AudioStreamParameters::MINIMAL_LATENCY_STRETCH_SEEKWINDOW :
+												AudioStreamParameters::DEFAULT_STRETCH_SEEKWINDOW;
+	const u32 overlap_ms = minimal_latency ? AudioStreamParameters::MINIMAL_LATENCY_STRETCH_OVERLAP :
+											 AudioStreamParameters::DEFAULT_STRETCH_OVERLAP;
+
+	AudioTimeStretcher native(SAMPLE_RATE, CHANNELS, sequence_ms, seekwindow_ms, overlap_ms, false);
+	native.SetTempo(tempo);
+	*native_res = RunStretcher(
+		input, [&](const float* f, u32 n) { native.PutFrames(f, n); },
+		[&](float* f, u32 n) { return native.ReceiveFrames(f, n); });
+
+	soundtouch::SoundTouch st;
+	st.setSampleRate(SAMPLE_RATE);
+	st.setChannels(CHANNELS);
+	st.setSetting(SETTING_USE_QUICKSEEK, 0);
+	st.setSetting(SETTING_USE_AA_FILTER, 0);
+	st.setSetting(SETTING_SEQUENCE_MS, sequence_ms);
+	st.setSetting(SETTING_SEEKWINDOW_MS, seekwindow_ms);
+	st.setSetting(SETTING_OVERLAP_MS, overlap_ms);
+	st.setTempo(tempo);
+	*st_res = RunStretcher(
+		input, [&](const float* f, u32 n) { st.putSamples(f, n); },
+		[&](float* f, u32 n) { return st.receiveSamples(f, n); });
+}
+
+TEST(AudioTimeStretcher, MatchesSoundTouch)
+{
+	static constexpr u32 SECONDS = 2;
+	static constexpr float TEMPO = 1.1f;
+
+	const std::vector<float> input = GenerateTestSignal(SECONDS);
+
+	for (const bool minimal_latency : {false, true})
+	{
+		StretchResult native_res, st_res;
+		RunWithSoundTouch(input, TEMPO, minimal_latency, &native_res, &st_res);
+
+		// Both should produce roughly the same amount of audio, and the native one shouldn't add latency.
+		EXPECT_NEAR(static_cast<float>(native_res.output_frames), static_cast<float>(st_res.output_frames),
+			SAMPLE_RATE * 0.1f) << (minimal_latency ? "minimal latency" : "default latency");
+		EXPECT_LE(native_res.latency_frames, st_res.latency_frames) << (minimal_latency ? "minimal latency" : "default latency");
+	}
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests.
+TEST(AudioTimeStretcher, DISABLED_SoundTouchBenchmark)
+{
+	static constexpr u32 SECONDS = 10;
+	static constexpr float TEMPO = 1.1f;
+
+	const std::vector<float> input = GenerateTestSignal(SECONDS);
+
+	for (const bool minimal_latency : {false, true})
+	{
+		StretchResult native_res, st_res;
+		RunWithSoundTouch(input, TEMPO, minimal_latency, &native_res, &st_res);
+
+		std::printf("%s latency: native %.2f ms CPU/s, %.1f ms latency | SoundTouch %.2f ms CPU/s, %.1f ms latency\n",
+			minimal_latency ? "Minimal" : "Default",
+			native_res.cpu_seconds * 1000.0 / SECONDS, native_res.latency_frames * 1000.0 / SAMPLE_RATE,
+			st_res.cpu_seconds * 1000.0 / SECONDS, st_res.latency_frames * 1000.0 / SAMPLE_RATE);
+	}
+}
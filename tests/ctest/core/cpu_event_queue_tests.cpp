@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/CpuEventQueue.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace
+{
+	struct FakeRegs
+	{
+		u32 interrupt = 0;
+		u32 sCycle[32] = {};
+		s32 eCycle[32] = {};
+	};
+
+	static void Schedule(FakeRegs& regs, CpuEventQueue& queue, u32 id, u32 cycle, s32 delta)
+	{
+		regs.interrupt |= 1u << id;
+		regs.sCycle[id] = cycle;
+		regs.eCycle[id] = delta;
+		queue.Schedule(id, cycle + delta);
+	}
+
+	static u32 ReferenceDue(const FakeRegs& regs, u32 cycle)
+	{
+		u32 due = 0;
+		for (u32 id = 0; id < 32; id++)
+		{
+			if ((regs.interrupt & (1u << id)) && static_cast<s32>(cycle - regs.sCycle[id]) >= regs.eCycle[id])
+				due |= 1u << id;
+		}
+		return due;
+	}
+} // namespace
+
+TEST(CpuEventQueue, PopsInDeadlineOrder)
+{
+	FakeRegs regs;
+	CpuEventQueue queue;
+	Schedule(regs, queue, 3, 0, 300);
+	Schedule(regs, queue, 1, 0, 100);
+	Schedule(regs, queue, 2, 0, 200);
+
+	EXPECT_EQ(queue.GetNextDeadline(), 100u);
+	EXPECT_EQ(queue.PopDue(99, regs.interrupt, regs.sCycle, regs.eCycle), 0u);
+	EXPECT_EQ(queue.PopDue(200, regs.interrupt, regs.sCycle, regs.eCycle), (1u << 1) | (1u << 2));
+	EXPECT_EQ(queue.GetNextDeadline(), 300u);
+}
+
+TEST(CpuEventQueue, RescheduleMovesExistingEntry)
+{
+	FakeRegs regs;
+	CpuEventQueue queue;
+	Schedule(regs, queue, 5, 0, 1000);
+	Schedule(regs, queue, 6, 0, 500);
+	Schedule(regs, queue, 5, 0, 10);
+
+	EXPECT_EQ(queue.GetNextDeadline(), 10u);
+	EXPECT_EQ(queue.PopDue(10, regs.interrupt, regs.sCycle, regs.eCycle), 1u << 5);
+	EXPECT_EQ(queue.GetNextDeadline(), 500u);
+}
+
+TEST(CpuEventQueue, PicksUpDirectRegisterChanges)
+{
+	FakeRegs regs;
+	CpuEventQueue queue;
+	Schedule(regs, queue, 0, 0, 10);
+	Schedule(regs, queue, 4, 0, 20);
+	Schedule(regs, queue, 7, 0, 30);
+
+	// Cleared without telling the queue.
+	regs.interrupt &= ~1u;
+
+	// Pushed back without telling the queue.
+	regs.eCycle[4] = 0x9999;
+
+	queue.Validate(regs.interrupt, regs.sCycle, regs.eCycle);
+	EXPECT_EQ(queue.GetNextDeadline(), 30u);
+	EXPECT_EQ(queue.PopDue(100, regs.interrupt, regs.sCycle, regs.eCycle), 1u << 7);
+	EXPECT_EQ(queue.GetNextDeadline(), 0x9999u);
+}
+
+TEST(CpuEventQueue, HandlesCycleWraparound)
+{
+	FakeRegs regs;
+	CpuEventQueue queue;
+	Schedule(regs, queue, 1, 0xFFFFFF00u, 0x200);
+	Schedule(regs, queue, 2, 0xFFFFFF00u, 0x10);
+
+	EXPECT_EQ(queue.GetNextDeadline(), 0xFFFFFF10u);
+	EXPECT_EQ(queue.PopDue(0xFFFFFFF0u, regs.interrupt, regs.sCycle, regs.eCycle), 1u << 2);
+	EXPECT_EQ(queue.PopDue(0x80u, regs.interrupt, regs.sCycle, regs.eCycle), 0u);
+	EXPECT_EQ(queue.PopDue(0x100u, regs.interrupt, regs.sCycle, regs.eCycle), 1u << 1);
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(CpuEventQueue, MatchesLinearScan)
+{
+	std::mt19937 rng(1234);
+	FakeRegs regs;
+	CpuEventQueue queue;
+	u32 cycle = 0xFFFF0000u;
+
+	for (u32 step = 0; step < 100000; step++)
+	{
+		const u32 id = rng() % 20;
+		switch (rng() % 4)
+		{
+			case 0:
+			case 1:
+				Schedule(regs, queue, id, cycle, static_cast<s32>(rng() % 2000));
+				break;
+
+			case 2:
+				regs.interrupt &= ~(1u << id);
+				if (rng() & 1)
+					queue.Remove(id);
+				break;
+
+			case 3:
+			{
+				cycle += rng() % 500;
+				const u32 expected = ReferenceDue(regs, cycle);
+				const u32 due = queue.PopDue(cycle, regs.interrupt, regs.sCycle, regs.eCycle);
+				ASSERT_EQ(due, expected) << "step " << step;
+
+				// The handlers would clear these.
+				regs.interrupt &= ~due;
+
+				queue.Validate(regs.interrupt, regs.sCycle, regs.eCycle);
+				ASSERT_EQ(queue.IsEmpty(), regs.interrupt == 0);
+			}
+			break;
+		}
+	}
+}
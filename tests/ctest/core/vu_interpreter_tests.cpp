@@ -0,0 +1,313 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/Config.h"
+#include "pcsx2/VUops.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <random>
+
+// Runs the interpreter's FMAC ops against a straightforward per-field implementation built on the
+// scalar flag helpers, which is what the interpreter itself used before it was vectorized.
+
+namespace
+{
+	enum class Op : u8
+	{
+		ADD,
+		SUB,
+		MUL,
+		MADD,
+		MSUB,
+		MAX,
+		MINI,
+		OPMULA,
+		OPMSUB,
+	};
+
+	enum class Src : u8
+	{
+		Ft,
+		X,
+		Y,
+		Z,
+		W,
+		I,
+		Q,
+	};
+
+	struct UpperOp
+	{
+		const char* name;
+		u32 code;
+		Op op;
+		Src src;
+		bool acc;
+	};
+
+	/// Ops writing ACC live in the FD_xx subtables, selected by the low two bits and the fd field.
+	constexpr u32 AccOp(u32 table, u32 index)
+	{
+		return 0x3c | table | (index << 6);
+	}
+
+	// clang-format off
+	static constexpr UpperOp s_ops[] = {
+		{"ADD", 0x28, Op::ADD, Src::Ft, false}, {"ADDi", 0x22, Op::ADD, Src::I, false}, {"ADDq", 0x20, Op::ADD, Src::Q, false},
+		{"ADDx", 0x00, Op::ADD, Src::X, false}, {"ADDy", 0x01, Op::ADD, Src::Y, false}, {"ADDz", 0x02, Op::ADD, Src::Z, false}, {"ADDw", 0x03, Op::ADD, Src::W, false},
+		{"SUB", 0x2c, Op::SUB, Src::Ft, false}, {"SUBi", 0x26, Op::SUB, Src::I, false}, {"SUBq", 0x24, Op::SUB, Src::Q, false},
+		{"SUBx", 0x04, Op::SUB, Src::X, false}, {"SUBy", 0x05, Op::SUB, Src::Y, false}, {"SUBz", 0x06, Op::SUB, Src::Z, false}, {"SUBw", 0x07, Op::SUB, Src::W, false},
+		{"MUL", 0x2a, Op::MUL, Src::Ft, false}, {"MULi", 0x1e, Op::MUL, Src::I, false}, {"MULq", 0x1c, Op::MUL, Src::Q, false},
+		{"MULx", 0x18, Op::MUL, Src::X, false}, {"MULy", 0x19, Op::MUL, Src::Y, false}, {"MULz", 0x1a, Op::MUL, Src::Z, false}, {"MULw", 0x1b, Op::MUL, Src::W, false},
+		{"MADD", 0x29, Op::MADD, Src::Ft, false}, {"MADDi", 0x23, Op::MADD, Src::I, false}, {"MADDq", 0x21, Op::MADD, Src::Q, false},
+		{"MADDx", 0x08, Op::MADD, Src::X, false}, {"MADDy", 0x09, Op::MADD, Src::Y, false}, {"MADDz", 0x0a, Op::MADD, Src::Z, false}, {"MADDw", 0x0b, Op::MADD, Src::W, false},
+		{"MSUB", 0x2d, Op::MSUB, Src::Ft, false}, {"MSUBi", 0x27, Op::MSUB, Src::I, false}, {"MSUBq", 0x25, Op::MSUB, Src::Q, false},
+		{"MSUBx", 0x0c, Op::MSUB, Src::X, false}, {"MSUBy", 0x0d, Op::MSUB, Src::Y, false}, {"MSUBz", 0x0e, Op::MSUB, Src::Z, false}, {"MSUBw", 0x0f, Op::MSUB, Src::W, false},
+		{"MAX", 0x2b, Op::MAX, Src::Ft, false}, {"MAXi", 0x1d, Op::MAX, Src::I, false},
+		{"MAXx", 0x10, Op::MAX, Src::X, false}, {"MAXy", 0x11, Op::MAX, Src::Y, false}, {"MAXz", 0x12, Op::MAX, Src::Z, false}, {"MAXw", 0x13, Op::MAX, Src::W, false},
+		{"MINI", 0x2f, Op::MINI, Src::Ft, false}, {"MINIi", 0x1f, Op::MINI, Src::I, false},
+		{"MINIx", 0x14, Op::MINI, Src::X, false}, {"MINIy", 0x15, Op::MINI, Src::Y, false}, {"MINIz", 0x16, Op::MINI, Src::Z, false}, {"MINIw", 0x17, Op::MINI, Src::W, false},
+		{"OPMSUB", 0x2e, Op::OPMSUB, Src::Ft, false},
+
+		{"ADDA", AccOp(0, 10), Op::ADD, Src::Ft, true}, {"ADDAi", AccOp(2, 8), Op::ADD, Src::I, true}, {"ADDAq", AccOp(0, 8), Op::ADD, Src::Q, true},
+		{"ADDAx", AccOp(0, 0), Op::ADD, Src::X, true}, {"ADDAy", AccOp(1, 0), Op::ADD, Src::Y, true}, {"ADDAz", AccOp(2, 0), Op::ADD, Src::Z, true}, {"ADDAw", AccOp(3, 0), Op::ADD, Src::W, true},
+		{"SUBA", AccOp(0, 11), Op::SUB, Src::Ft, true}, {"SUBAi", AccOp(2, 9), Op::SUB, Src::I, true}, {"SUBAq", AccOp(0, 9), Op::SUB, Src::Q, true},
+		{"SUBAx", AccOp(0, 1), Op::SUB, Src::X, true}, {"SUBAy", AccOp(1, 1), Op::SUB, Src::Y, true}, {"SUBAz", AccOp(2, 1), Op::SUB, Src::Z, true}, {"SUBAw", AccOp(3, 1), Op::SUB, Src::W, true},
+		{"MULA", AccOp(2, 10), Op::MUL, Src::Ft, true}, {"MULAi", AccOp(2, 7), Op::MUL, Src::I, true}, {"MULAq", AccOp(0, 7), Op::MUL, Src::Q, true},
+		{"MULAx", AccOp(0, 6), Op::MUL, Src::X, true}, {"MULAy", AccOp(1, 6), Op::MUL, Src::Y, true}, {"MULAz", AccOp(2, 6), Op::MUL, Src::Z, true}, {"MULAw", AccOp(3, 6), Op::MUL, Src::W, true},
+		{"MADDA", AccOp(1, 10), Op::MADD, Src::Ft, true}, {"MADDAi", AccOp(3, 8), Op::MADD, Src::I, true}, {"MADDAq", AccOp(1, 8), Op::MADD, Src::Q, true},
+		{"MADDAx", AccOp(0, 2), Op::MADD, Src::X, true}, {"MADDAy", AccOp(1, 2), Op::MADD, Src::Y, true}, {"MADDAz", AccOp(2, 2), Op::MADD, Src::Z, true}, {"MADDAw", AccOp(3, 2), Op::MADD, Src::W, true},
+		{"MSUBA", AccOp(1, 11), Op::MSUB, Src::Ft, true}, {"MSUBAi", AccOp(3, 9), Op::MSUB, Src::I, true}, {"MSUBAq", AccOp(1, 9), Op::MSUB, Src::Q, true},
+		{"MSUBAx", AccOp(0, 3), Op::MSUB, Src::X, true}, {"MSUBAy", AccOp(1, 3), Op::MSUB, Src::Y, true}, {"MSUBAz", AccOp(2, 3), Op::MSUB, Src::Z, true}, {"MSUBAw", AccOp(3, 3), Op::MSUB, Src::W, true},
+		{"OPMULA", AccOp(2, 11), Op::OPMULA, Src::Ft, true},
+	};
+	// clang-format on
+
+	static float RefDouble(u32 f)
+	{
+		switch (f & 0x7f800000)
+		{
+			case 0x0:
+				f &= 0x80000000;
+				break;
+			case 0x7f800000:
+				if (CHECK_VU_OVERFLOW(0))
+					f = (f & 0x80000000) | 0x7f7fffff;
+				break;
+		}
+		return std::bit_cast<float>(f);
+	}
+
+	static float RefAddTriAce(u32 a, u32 b)
+	{
+		const s32 aExp = (a >> 23) & 0xff;
+		const s32 bExp = (b >> 23) & 0xff;
+		if (aExp - bExp >= 25)
+			b &= 0x80000000;
+		if (aExp - bExp <= -25)
+			a &= 0x80000000;
+		return RefDouble(a) + RefDouble(b);
+	}
+
+	static u32 RefMax(u32 a, u32 b)
+	{
+		return (static_cast<s32>(a) < 0 && static_cast<s32>(b) < 0) ? std::min<s32>(a, b) : std::max<s32>(a, b);
+	}
+
+	static u32 RefMin(u32 a, u32 b)
+	{
+		return (static_cast<s32>(a) < 0 && static_cast<s32>(b) < 0) ? std::max<s32>(a, b) : std::min<s32>(a, b);
+	}
+
+	static u32 (*const s_mac_update[4])(VURegs*, float) = {VU_MACx_UPDATE, VU_MACy_UPDATE, VU_MACz_UPDATE, VU_MACw_UPDATE};
+	static void (*const s_mac_clear[4])(VURegs*) = {VU_MACx_CLEAR, VU_MACy_CLEAR, VU_MACz_CLEAR, VU_MACw_CLEAR};
+
+	static void RunReference(VURegs* VU, const UpperOp& op)
+	{
+		const u32 fd = (VU->code >> 6) & 0x1f;
+		const u32 fs = (VU->code >> 11) & 0x1f;
+		const u32 ft = (VU->code >> 16) & 0x1f;
+		const u32 xyzw = (VU->code >> 21) & 0xf;
+
+		const VECTOR s = VU->VF[fs];
+		const VECTOR t = VU->VF[ft];
+		const VECTOR acc = VU->ACC;
+		VECTOR scratch = {};
+		VECTOR* dst = op.acc ? &VU->ACC : (fd == 0) ? &scratch : &VU->VF[fd];
+
+		const auto source = [&](u32 lane) -> u32 {
+			switch (op.src)
+			{
+				case Src::X: return t.UL[0];
+				case Src::Y: return t.UL[1];
+				case Src::Z: return t.UL[2];
+				case Src::W: return t.UL[3];
+				case Src::I: return VU->VI[REG_I].UL;
+				case Src::Q: return VU->VI[REG_Q].UL;
+				default: return t.UL[lane];
+			}
+		};
+
+		if (op.op == Op::MAX || op.op == Op::MINI)
+		{
+			if (fd == 0)
+				return;
+
+			for (u32 lane = 0; lane < 4; lane++)
+			{
+				if (xyzw & (8 >> lane))
+					dst->UL[lane] = (op.op == Op::MAX) ? RefMax(s.UL[lane], source(lane)) : RefMin(s.UL[lane], source(lane));
+			}
+			return;
+		}
+
+		if (op.op == Op::OPMULA || op.op == Op::OPMSUB)
+		{
+			static constexpr u32 s_cross[3][2] = {{1, 2}, {2, 0}, {0, 1}};
+			for (u32 lane = 0; lane < 3; lane++)
+			{
+				// Kept out of the expression below, so the compiler can't fuse it into an FMA.
+				volatile float product = RefDouble(s.UL[s_cross[lane][0]]) * RefDouble(t.UL[s_cross[lane][1]]);
+				const float result = (op.op == Op::OPMULA) ? product : RefDouble(acc.UL[lane]) - product;
+				dst->UL[lane] = s_mac_update[lane](VU, result);
+			}
+			VU_STAT_UPDATE(VU);
+			return;
+		}
+
+		for (u32 lane = 0; lane < 4; lane++)
+		{
+			if (!(xyzw & (8 >> lane)))
+			{
+				s_mac_clear[lane](VU);
+				continue;
+			}
+
+			const u32 a = s.UL[lane];
+			const u32 b = source(lane);
+			float result;
+			switch (op.op)
+			{
+				case Op::ADD:
+					result = (op.src == Src::I && !op.acc && CHECK_VUADDSUBHACK) ? RefAddTriAce(a, b) : RefDouble(a) + RefDouble(b);
+					break;
+				case Op::SUB:
+					result = RefDouble(a) - RefDouble(b);
+					break;
+				case Op::MUL:
+					result = RefDouble(a) * RefDouble(b);
+					break;
+				default:
+				{
+					volatile float product = RefDouble(a) * RefDouble(b);
+					result = (op.op == Op::MADD) ? RefDouble(acc.UL[lane]) + product : RefDouble(acc.UL[lane]) - product;
+				}
+				break;
+			}
+			dst->UL[lane] = s_mac_update[lane](VU, result);
+		}
+		VU_STAT_UPDATE(VU);
+	}
+
+	/// Mostly ordinary floats, with plenty of zeroes, denormals and infinities, and exponents which are
+	/// close together, since that's where the special cases are.
+	static u32 RandomValue(std::mt19937& rng)
+	{
+		u32 value = rng();
+		switch (rng() % 8)
+		{
+			case 0: value &= 0x80000000; break;
+			case 1: value &= 0x807fffff; break;
+			case 2: value |= 0x7f800000; break;
+			case 3: value = (value & 0x80ffffff) | 0x7e000000; break;
+			case 4: value = (value & 0x807fffff) | ((100 + rng() % 60) << 23); break;
+			case 5: value = (value & 0x807fffff) | (0x3f800000 + ((rng() % 3) << 23)); break;
+			default: break;
+		}
+
+		// Without overflow clamping, which input NaN's payload and sign comes out of an op is up to the
+		// compiler (it's free to swap the operands of an add), so only feed it infinities.
+		if (!CHECK_VU_OVERFLOW(0) && (value & 0x7f800000) == 0x7f800000)
+			value &= 0xff800000;
+
+		return value;
+	}
+
+	class VUInterpreterTest : public ::testing::TestWithParam<std::tuple<bool, bool>>
+	{
+	protected:
+		void SetUp() override
+		{
+			m_saved_overflow = EmuConfig.Cpu.Recompiler.vu0Overflow;
+			m_saved_addsub = EmuConfig.Gamefixes.VuAddSubHack;
+			EmuConfig.Cpu.Recompiler.vu0Overflow = std::get<0>(GetParam());
+			EmuConfig.Gamefixes.VuAddSubHack = std::get<1>(GetParam());
+		}
+
+		void TearDown() override
+		{
+			EmuConfig.Cpu.Recompiler.vu0Overflow = m_saved_overflow;
+			EmuConfig.Gamefixes.VuAddSubHack = m_saved_addsub;
+		}
+
+	private:
+		bool m_saved_overflow = false;
+		bool m_saved_addsub = false;
+	};
+} // namespace
+
+TEST_P(VUInterpreterTest, UpperOpsMatchScalarReference)
+{
+	std::mt19937 rng(4321);
+	std::unique_ptr<VURegs> expected = std::make_unique<VURegs>();
+
+	for (const UpperOp& op : s_ops)
+	{
+		for (u32 iter = 0; iter < 2000; iter++)
+		{
+			// Use a handful of registers, so the operands and destination often overlap.
+			const u32 fd = rng() % 4;
+			const u32 fs = rng() % 4;
+			const u32 ft = rng() % 4;
+			const u32 xyzw = rng() % 16;
+			const u32 code = (xyzw << 21) | (ft << 16) | (fs << 11) | (op.acc ? 0 : (fd << 6)) | op.code;
+
+			for (u32 reg = 0; reg < 4; reg++)
+			{
+				for (u32 lane = 0; lane < 4; lane++)
+					VU0.VF[reg].UL[lane] = RandomValue(rng);
+			}
+			for (u32 lane = 0; lane < 4; lane++)
+				VU0.ACC.UL[lane] = RandomValue(rng);
+			VU0.VI[REG_I].UL = RandomValue(rng);
+			VU0.VI[REG_Q].UL = RandomValue(rng);
+			VU0.macflag = rng() & 0xffff;
+			VU0.statusflag = rng() & 0xf;
+			VU0.code = code;
+
+			std::memcpy(expected.get(), &VU0, sizeof(VURegs));
+			RunReference(expected.get(), op);
+			VU0_UPPER_OPCODE[code & 0x3f]();
+
+			for (u32 reg = 0; reg < 4; reg++)
+			{
+				for (u32 lane = 0; lane < 4; lane++)
+				{
+					ASSERT_EQ(VU0.VF[reg].UL[lane], expected->VF[reg].UL[lane])
+						<< op.name << " VF" << reg << " lane " << lane << " code " << std::hex << code;
+				}
+			}
+			for (u32 lane = 0; lane < 4; lane++)
+				ASSERT_EQ(VU0.ACC.UL[lane], expected->ACC.UL[lane]) << op.name << " ACC lane " << lane << " code " << std::hex << code;
+			ASSERT_EQ(VU0.macflag, expected->macflag) << op.name << " code " << std::hex << code;
+			ASSERT_EQ(VU0.statusflag, expected->statusflag) << op.name << " code " << std::hex << code;
+		}
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(VUInterpreter, VUInterpreterTest, ::testing::Combine(::testing::Bool(), ::testing::Bool()));
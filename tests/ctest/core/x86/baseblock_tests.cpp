@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/x86/BaseblockEx.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+	class BaseBlocksTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_blocks.SetJITCompile(m_code);
+		}
+
+		void AddBlock(u32 start, u32 end)
+		{
+			BASEBLOCKEX* block = m_blocks.New(start, reinterpret_cast<uptr>(&m_code[start / 4 % sizeof(m_code)]));
+			block->size = (end - start) / 4;
+		}
+
+		// Same removal as recClear(): the blocks reaching into the range go, everything else stays.
+		std::vector<u32> Clear(u32 addr, u32 size)
+		{
+			std::vector<u32> cleared;
+			m_blocks.ForEachOverlapping(addr, size, [this, &cleared](int idx, BASEBLOCKEX* block) {
+				cleared.push_back(block->startpc);
+				m_blocks.Remove(idx, idx);
+			});
+			return cleared;
+		}
+
+		std::vector<u32> Remaining()
+		{
+			std::vector<u32> starts;
+			for (int i = 0; BASEBLOCKEX* block = m_blocks[i]; i++)
+				starts.push_back(block->startpc);
+			return starts;
+		}
+
+		u8 m_code[256] = {};
+		BaseBlocks m_blocks;
+	};
+} // namespace
+
+TEST_F(BaseBlocksTest, ClearStopsAtBlocksEndingBeforeRange)
+{
+	AddBlock(0x100, 0x180);
+	AddBlock(0x180, 0x200);
+	AddBlock(0x200, 0x300);
+
+	EXPECT_EQ(Clear(0x200, 0x40), (std::vector<u32>{0x200}));
+	EXPECT_EQ(Remaining(), (std::vector<u32>{0x100, 0x180}));
+}
+
+TEST_F(BaseBlocksTest, ClearReachesPromotedBlock)
+{
+	// A promoted block compiled through two other block starts, ending after the first of them.
+	AddBlock(0x100, 0x300);
+	AddBlock(0x180, 0x200);
+	AddBlock(0x200, 0x300);
+
+	EXPECT_EQ(Clear(0x200, 0x40), (std::vector<u32>{0x200, 0x100}));
+	EXPECT_EQ(Remaining(), (std::vector<u32>{0x180}));
+}
+
+TEST_F(BaseBlocksTest, PartialClearInPromotedBlockTail)
+{
+	AddBlock(0x100, 0x300);
+	AddBlock(0x180, 0x200);
+	AddBlock(0x200, 0x300);
+
+	EXPECT_EQ(Clear(0x2f0, 1), (std::vector<u32>{0x200, 0x100}));
+	EXPECT_EQ(Remaining(), (std::vector<u32>{0x180}));
+}
+
+TEST_F(BaseBlocksTest, ClearDoesNotLookPastPage)
+{
+	AddBlock(0x0ff0, 0x1000);
+	AddBlock(0x1000, 0x1100);
+	AddBlock(0x1100, 0x1200);
+
+	EXPECT_EQ(Clear(0x1100, 1), (std::vector<u32>{0x1100}));
+	EXPECT_EQ(Remaining(), (std::vector<u32>{0x0ff0, 0x1000}));
+}